@@ -0,0 +1,20 @@
+#ifndef ALLOC_TRACE_H
+#define ALLOC_TRACE_H
+
+#include "object.h"
+
+extern bool traceAllocEnabled;
+
+void initAllocTrace();
+
+void traceAllocation(Obj *object, size_t size);
+
+void traceFree(Obj *object);
+
+void traceReallocate(size_t oldSize, size_t newSize);
+
+void printAllocReport();
+
+Value heapSnapshot();
+
+#endif
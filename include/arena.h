@@ -0,0 +1,26 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdlib.h>
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t size;
+    size_t capacity;
+    char data[];
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock *blocks;
+    size_t bytesAllocated;
+} Arena;
+
+void initArena(Arena *arena);
+
+void freeArena(Arena *arena);
+
+void* arenaAllocate(Arena *arena, size_t size);
+
+#endif
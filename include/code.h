@@ -13,9 +13,11 @@ typedef enum {
     OP_TRUE,
     OP_FALSE,
     OP_GET_GLOBAL,
+    OP_GET_GLOBAL_UNSHARED,
     OP_SET_GLOBAL,
     OP_DEL_GLOBAL,
     OP_GET_LOCAL,
+    OP_GET_LOCAL_UNSHARED,
     OP_SET_LOCAL,
     OP_DEL_LOCAL,
     OP_GET_UPVALUE,
@@ -41,17 +43,32 @@ typedef enum {
     OP_BITWISE_OR,
     OP_LEFT_SHIFT,
     OP_RIGHT_SHIFT,
+    OP_INPLACE_ADD,
+    OP_INPLACE_SUBTRUCT,
+    OP_INPLACE_MULTIPLY,
+    OP_INPLACE_POWER,
+    OP_INPLACE_TRUE_DIVIDE,
+    OP_INPLACE_FLOOR_DIVIDE,
+    OP_INPLACE_MOD,
+    OP_INPLACE_BITWISE_AND,
+    OP_INPLACE_BITWISE_XOR,
+    OP_INPLACE_BITWISE_OR,
+    OP_INPLACE_LEFT_SHIFT,
+    OP_INPLACE_RIGHT_SHIFT,
+    OP_INPLACE_CONCAT,
     OP_INVERT,
     OP_NOT,
     OP_CONTAINS,
     OP_BUILD_ITERATOR,
     OP_BUILD_SLICE,
+    OP_GET_SLICE,
     OP_IS_INSTANCE,
     OP_IS,
     OP_BUILD_FSTRING,
     OP_BUILD_LIST,
     OP_BUILD_TUPLE,
     OP_BUILD_DICT,
+    OP_BUILD_SET,
     OP_GET_ITEM,
     OP_GET_ITEM_NO_POP,
     OP_SET_ITEM,
@@ -0,0 +1,14 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// Picks the per-process seed. NOVA_HASHSEED, when set to an integer, fixes it
+// so runs can be reproduced.
+void initHashSeed();
+
+// wyhash over exactly `length` bytes; embedded NULs take part in the hash.
+uint64_t hashBytes(const char *bytes, size_t length);
+
+#endif
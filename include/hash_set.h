@@ -0,0 +1,47 @@
+#ifndef HASH_SET_H
+#define HASH_SET_H
+
+#include <stdlib.h>
+
+#include "value.h"
+
+typedef struct {
+    uint64_t hash;
+    Value key;
+} SetEntry;
+
+// Keys-only open-addressing table behind set and frozenset. Every entry keeps
+// the key's full hash, so growing and set algebra never rehash a key.
+// `finger` is where the last pop stopped; the next one resumes there rather
+// than rescanning the tombstones it left behind.
+typedef struct {
+    size_t size;
+    size_t fill;
+    size_t capacity;
+    size_t finger;
+    SetEntry *entries;
+} HashSet;
+
+void initHashSet(HashSet *set);
+
+void freeHashSet(HashSet *set);
+
+bool hashSetContains(HashSet *set, Value key);
+
+bool hashSetAdd(HashSet *set, Value key);
+
+bool hashSetRemove(HashSet *set, Value key);
+
+bool hashSetContainsEntry(HashSet *set, SetEntry *entry);
+
+bool hashSetAddEntry(HashSet *set, SetEntry *entry);
+
+bool hashSetRemoveEntry(HashSet *set, SetEntry *entry);
+
+bool hashSetPop(HashSet *set, Value *key);
+
+SetEntry *hashSetNext(HashSet *set, size_t *index);
+
+void markHashSet(HashSet *set);
+
+#endif
@@ -19,6 +19,29 @@
 
 #define FREE(type, pointer) reallocate(pointer, sizeof(type), 0)
 
+#define GC_DEFAULT_THRESHOLD (1024 * 1024)
+#define GC_DEFAULT_GROW_FACTOR 2.0
+#define HEAP_LIMIT_RESERVE_RATIO 8
+
+#define GC_DEBUG_STATS 1
+
+typedef struct {
+    bool enabled;
+    int debug;
+    size_t heapLimit;
+    size_t heapCeiling;
+    bool heapLimitExceeded;
+    size_t threshold;
+    double growFactor;
+    size_t collections;
+    size_t objectsFreed;
+    size_t bytesFreed;
+    double totalPause;
+    double maxPause;
+} GarbageCollector;
+
+void initGarbageCollector(GarbageCollector *gc);
+
 void* reallocate(void *pointer, size_t oldSize, size_t newSize);
 
 void freeObjects();
@@ -27,6 +50,10 @@ void markObject(Obj *object);
 
 void markValue(Value value);
 
-void collectGarbage();
+size_t collectGarbage();
+
+void setHeapLimit(size_t limit);
+bool exceedsHeapLimit(size_t size);
+void enterHeapReserve();
 
 #endif
\ No newline at end of file
@@ -37,12 +37,12 @@
 #line 7 "gperf/methods_string.txt"
 struct StaticAttribute;
 
-#define TOTAL_KEYWORDS 61
+#define TOTAL_KEYWORDS 62
 #define MIN_WORD_LENGTH 4
 #define MAX_WORD_LENGTH 16
-#define MIN_HASH_VALUE 10
-#define MAX_HASH_VALUE 131
-/* maximum key range = 122, duplicates = 0 */
+#define MIN_HASH_VALUE 38
+#define MAX_HASH_VALUE 167
+/* maximum key range = 130, duplicates = 0 */
 
 #ifdef __GNUC__
 __inline
@@ -56,32 +56,32 @@ hash (register const char *str, register size_t len)
 {
   static const unsigned char asso_values[] =
     {
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132,   5, 132,  15, 132,  30,
-       40,  20,  35,  41,   0,   0,   0,   0,  10,   5,
-       15,  35,   0,   5,   5,   0,  10,  55, 132,  50,
-       30, 132,  10, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132, 132, 132, 132, 132,
-      132, 132, 132, 132, 132, 132
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168,  31, 168,  41, 168,   3,
+       17,  13,  14,  24,  13,   1,  13,   4,  31,  19,
+       20,   0,  11,  40,  38,  15,  40,  39, 168,  24,
+       28, 168,  28, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168, 168, 168, 168, 168,
+      168, 168, 168, 168, 168, 168
     };
   register unsigned int hval = len;
 
@@ -110,159 +110,161 @@ in_string_set (register const char *str, register size_t len)
   static const struct StaticAttribute wordlist[] =
     {
       {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""},
-      {""},
-#line 68 "gperf/methods_string.txt"
-      {"strip", PyString_Strip, true},
-      {""}, {""}, {""}, {""}, {""},
-#line 48 "gperf/methods_string.txt"
-      {"isprintable", PyString_IsPrintable, true},
+      {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""},
+      {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""},
+      {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""},
       {""}, {""},
-#line 52 "gperf/methods_string.txt"
+#line 53 "gperf/methods_string.txt"
       {"join", PyString_Join, true},
+#line 34 "gperf/methods_string.txt"
+      {"encode", PyString_Encode, true},
+      {""}, {""}, {""},
+#line 44 "gperf/methods_string.txt"
+      {"isdecimal", PyString_IsDecimal, true},
+#line 46 "gperf/methods_string.txt"
+      {"isidentifier", PyString_IsIdentifier, true},
+      {""}, {""}, {""}, {""}, {""},
+#line 45 "gperf/methods_string.txt"
+      {"isdigit", PyString_IsDigit, true},
+      {""}, {""},
+#line 31 "gperf/methods_string.txt"
+      {"casefold", PyString_CaseFold, true},
       {""},
-#line 63 "gperf/methods_string.txt"
-      {"rsplit", PyString_Rsplit, true},
+#line 37 "gperf/methods_string.txt"
+      {"find", PyString_Find, true},
+      {""}, {""}, {""}, {""}, {""}, {""},
 #line 49 "gperf/methods_string.txt"
+      {"isprintable", PyString_IsPrintable, true},
+#line 47 "gperf/methods_string.txt"
+      {"islower", PyString_IsLower, true},
+#line 40 "gperf/methods_string.txt"
+      {"index", PyString_Index, true},
+#line 30 "gperf/methods_string.txt"
+      {"capitalize", PyString_Capitalize, true},
+#line 24 "gperf/methods_string.txt"
+      {"__contains__", PyString_Contains, false},
+#line 43 "gperf/methods_string.txt"
+      {"isascii", PyString_IsAscii, true},
+      {""},
+#line 52 "gperf/methods_string.txt"
+      {"isupper", PyString_IsUpper, true},
+#line 69 "gperf/methods_string.txt"
+      {"strip", PyString_Strip, true},
+      {""}, {""}, {""},
+#line 23 "gperf/methods_string.txt"
+      {"__mod__", PyString_Modulo, true},
+#line 50 "gperf/methods_string.txt"
       {"isspace", PyString_IsSpace, true},
       {""},
+#line 35 "gperf/methods_string.txt"
+      {"endswith", PyString_Endswith, true},
+#line 70 "gperf/methods_string.txt"
+      {"swapcase", PyString_Swapcase, true},
+      {""}, {""},
+#line 60 "gperf/methods_string.txt"
+      {"rfind", PyString_Rfind, true},
+#line 32 "gperf/methods_string.txt"
+      {"center", PyString_Center, true},
+      {""}, {""},
 #line 57 "gperf/methods_string.txt"
-      {"partition", PyString_Partition, true},
-#line 65 "gperf/methods_string.txt"
-      {"split", PyString_Split, true},
+      {"maketrans", PyString_Maketrans, true},
+      {""},
 #line 64 "gperf/methods_string.txt"
-      {"rstrip", PyString_Rstrip, true},
-#line 50 "gperf/methods_string.txt"
+      {"rsplit", PyString_Rsplit, true},
+#line 48 "gperf/methods_string.txt"
+      {"isnumeric", PyString_IsNumeric, true},
+#line 51 "gperf/methods_string.txt"
       {"istitle", PyString_IsTitle, true},
-#line 27 "gperf/methods_string.txt"
-      {"__hash__", PyString_Hash, true},
       {""},
-#line 66 "gperf/methods_string.txt"
-      {"splitlines", PyString_Splitlines, true},
-#line 55 "gperf/methods_string.txt"
-      {"lstrip", PyString_Lstrip, true},
-#line 41 "gperf/methods_string.txt"
+#line 42 "gperf/methods_string.txt"
       {"isalpha", PyString_IsAlpha, true},
-      {""}, {""},
-#line 73 "gperf/methods_string.txt"
+#line 66 "gperf/methods_string.txt"
+      {"split", PyString_Split, true},
+#line 25 "gperf/methods_string.txt"
+      {"__iter__", PyString_Iter, true},
+#line 61 "gperf/methods_string.txt"
+      {"rindex", PyString_Rindex, true},
+#line 36 "gperf/methods_string.txt"
+      {"expandtabs", PyString_Expandtabs, true},
+#line 74 "gperf/methods_string.txt"
       {"zfill", PyString_Zfill, true},
-#line 18 "gperf/methods_string.txt"
-      {"__lt__", PyString_Less, true},
-#line 58 "gperf/methods_string.txt"
-      {"replace", PyString_Replace, true},
-      {""}, {""},
 #line 67 "gperf/methods_string.txt"
-      {"startswith", PyString_Startswith, true},
-#line 14 "gperf/methods_string.txt"
-      {"__eq__", PyString_Equal, true},
+      {"splitlines", PyString_Splitlines, true},
       {""},
-#line 24 "gperf/methods_string.txt"
-      {"__iter__", PyString_Iter, true},
-#line 56 "gperf/methods_string.txt"
-      {"maketrans", PyString_Maketrans, true},
-#line 62 "gperf/methods_string.txt"
-      {"rpartition", PyString_Rpartition, true},
-#line 19 "gperf/methods_string.txt"
-      {"__le__", PyString_LessEqual, true},
-#line 40 "gperf/methods_string.txt"
+#line 58 "gperf/methods_string.txt"
+      {"partition", PyString_Partition, true},
+#line 41 "gperf/methods_string.txt"
       {"isalnum", PyString_IsAlnum, true},
-      {""},
-#line 71 "gperf/methods_string.txt"
-      {"translate", PyString_Translate, true},
-#line 29 "gperf/methods_string.txt"
-      {"capitalize", PyString_Capitalize, true},
 #line 15 "gperf/methods_string.txt"
       {"__ne__", PyString_NotEqual, true},
-#line 42 "gperf/methods_string.txt"
-      {"isascii", PyString_IsAscii, true},
-#line 69 "gperf/methods_string.txt"
-      {"swapcase", PyString_Swapcase, true},
-      {""},
-#line 70 "gperf/methods_string.txt"
-      {"title", PyString_Title, true},
-      {""},
-#line 28 "gperf/methods_string.txt"
+#line 29 "gperf/methods_string.txt"
       {"__len__", PyString_Len, true},
       {""}, {""},
-#line 35 "gperf/methods_string.txt"
-      {"expandtabs", PyString_Expandtabs, true},
-      {""},
-#line 51 "gperf/methods_string.txt"
-      {"isupper", PyString_IsUpper, true},
+#line 17 "gperf/methods_string.txt"
+      {"__ge__", PyString_GreaterEqual, true},
+#line 73 "gperf/methods_string.txt"
+      {"upper", PyString_Upper, true},
+#line 33 "gperf/methods_string.txt"
+      {"count", PyString_Count, true},
+#line 28 "gperf/methods_string.txt"
+      {"__hash__", PyString_Hash, true},
       {""}, {""},
-#line 59 "gperf/methods_string.txt"
-      {"rfind", PyString_Rfind, true},
-#line 37 "gperf/methods_string.txt"
-      {"format", PyString_Format, true},
-#line 16 "gperf/methods_string.txt"
-      {"__gt__", PyString_Greater, true},
+#line 55 "gperf/methods_string.txt"
+      {"lower", PyString_Lower, true},
+#line 19 "gperf/methods_string.txt"
+      {"__le__", PyString_LessEqual, true},
+#line 20 "gperf/methods_string.txt"
+      {"__add__", PyString_Add, true},
       {""},
-#line 74 "gperf/methods_string.txt"
+#line 75 "gperf/methods_string.txt"
       {"__class__", PyString_Class, false},
-#line 38 "gperf/methods_string.txt"
-      {"format_map", PyString_FormatMap, true},
+#line 56 "gperf/methods_string.txt"
+      {"lstrip", PyString_Lstrip, true},
       {""},
-#line 45 "gperf/methods_string.txt"
-      {"isidentifier", PyString_IsIdentifier, true},
-      {""}, {""},
-#line 61 "gperf/methods_string.txt"
-      {"rjust", PyString_Rjust, true},
+#line 38 "gperf/methods_string.txt"
+      {"format", PyString_Format, true},
+#line 27 "gperf/methods_string.txt"
+      {"__getitem__", PyString_GetItem, true},
       {""},
-#line 17 "gperf/methods_string.txt"
-      {"__ge__", PyString_GreaterEqual, true},
-#line 22 "gperf/methods_string.txt"
-      {"__rmul__", PyString_RightMultiply, true},
+#line 14 "gperf/methods_string.txt"
+      {"__eq__", PyString_Equal, true},
+#line 39 "gperf/methods_string.txt"
+      {"format_map", PyString_FormatMap, true},
+#line 65 "gperf/methods_string.txt"
+      {"rstrip", PyString_Rstrip, true},
+#line 26 "gperf/methods_string.txt"
+      {"__getattribute__", PyString_GetAttribute, true},
+#line 72 "gperf/methods_string.txt"
+      {"translate", PyString_Translate, true},
       {""},
-#line 53 "gperf/methods_string.txt"
-      {"ljust", PyString_Ljust, true},
-#line 31 "gperf/methods_string.txt"
-      {"center", PyString_Center, true},
 #line 21 "gperf/methods_string.txt"
       {"__mul__", PyString_Multiply, true},
-      {""},
-#line 47 "gperf/methods_string.txt"
-      {"isnumeric", PyString_IsNumeric, true},
-#line 72 "gperf/methods_string.txt"
-      {"upper", PyString_Upper, true},
-#line 60 "gperf/methods_string.txt"
-      {"rindex", PyString_Rindex, true},
-#line 26 "gperf/methods_string.txt"
-      {"__getitem__", PyString_GetItem, true},
-#line 44 "gperf/methods_string.txt"
-      {"isdigit", PyString_IsDigit, true},
-      {""},
+#line 59 "gperf/methods_string.txt"
+      {"replace", PyString_Replace, true},
+#line 71 "gperf/methods_string.txt"
+      {"title", PyString_Title, true},
 #line 54 "gperf/methods_string.txt"
-      {"lower", PyString_Lower, true},
+      {"ljust", PyString_Ljust, true},
       {""},
-#line 25 "gperf/methods_string.txt"
-      {"__getattribute__", PyString_GetAttribute, true },
-#line 30 "gperf/methods_string.txt"
-      {"casefold", PyString_CaseFold, true},
-#line 36 "gperf/methods_string.txt"
-      {"find", PyString_Find, true},
-#line 39 "gperf/methods_string.txt"
-      {"index", PyString_Index, true},
+#line 16 "gperf/methods_string.txt"
+      {"__gt__", PyString_Greater, true},
+      {""}, {""},
+#line 22 "gperf/methods_string.txt"
+      {"__rmul__", PyString_RightMultiply, true},
       {""},
-#line 23 "gperf/methods_string.txt"
-      {"__contains__", PyString_Contains, false},
+#line 62 "gperf/methods_string.txt"
+      {"rjust", PyString_Rjust, true},
       {""},
-#line 43 "gperf/methods_string.txt"
-      {"isdecimal", PyString_IsDecimal, true},
-      {""}, {""},
-#line 46 "gperf/methods_string.txt"
-      {"islower", PyString_IsLower, true},
+#line 18 "gperf/methods_string.txt"
+      {"__lt__", PyString_Less, true},
       {""}, {""}, {""}, {""},
-#line 20 "gperf/methods_string.txt"
-      {"__add__", PyString_Add, true},
-      {""}, {""}, {""}, {""}, {""}, {""}, {""},
-#line 32 "gperf/methods_string.txt"
-      {"count", PyString_Count, true},
-      {""}, {""},
-#line 34 "gperf/methods_string.txt"
-      {"endswith", PyString_Endswith, true},
+#line 68 "gperf/methods_string.txt"
+      {"startswith", PyString_Startswith, true},
       {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""},
-      {""}, {""}, {""},
-#line 33 "gperf/methods_string.txt"
-      {"encode", PyString_Encode, true}
+      {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""}, {""},
+      {""}, {""}, {""}, {""},
+#line 63 "gperf/methods_string.txt"
+      {"rpartition", PyString_Rpartition, true}
     };
 
   if (len <= MAX_WORD_LENGTH && len >= MIN_WORD_LENGTH)
@@ -279,5 +281,4 @@ in_string_set (register const char *str, register size_t len)
     }
   return 0;
 }
-#line 75 "gperf/methods_string.txt"
-
+#line 76 "gperf/methods_string.txt"
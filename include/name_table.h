@@ -1,16 +1,26 @@
 #ifndef NAME_TABLE_H
 #define NAME_TABLE_H
 
+#include <stdint.h>
+
 #include "value.h"
 
+#define NAME_TABLE_GROUP_WIDTH 16
+
 typedef struct {
     ObjString *key;
     Value value;
 } NameEntry;
 
+// Swiss table keyed by strings. Every slot has a one-byte control tag:
+// empty, deleted, or the top 7 bits of the key's mixed hash when full; the
+// group position comes from the low bits. Lookups compare a whole group of 16
+// tags at once and only touch the entries whose tag matched.
 typedef struct {
     int size;
+    int tombstones;
     int capacity;
+    int8_t *control;
     NameEntry *entries;
 } NameTable;
 
@@ -26,8 +36,10 @@ bool nameTableDelete(NameTable *table, ObjString *key);
 
 void nameTableAddAll(NameTable *source, NameTable *destination);
 
-void markNameTable(NameTable *table);
+ObjString* nameTableFindString(NameTable *table, const char *chars, int length, uint64_t hash);
 
-void printNameTable(NameTable *table);
+void nameTableRemoveWhite(NameTable *table);
+
+void markNameTable(NameTable *table);
 
-#endif
\ No newline at end of file
+#endif
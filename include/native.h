@@ -9,6 +9,12 @@ Value Py_Id(int argc, int kwargc);
 
 Value Py_Len(int argc, int kwargc);
 
+Value Py_Hash(int argc, int kwargc);
+
+Value Py_Sum(int argc, int kwargc);
+
+Value Py_Sorted(int argc, int kwargc);
+
 Value Py_Repr(int argc, int kwargc);
 
 Value Py_Input(int argc, int kwargc);
@@ -21,4 +27,6 @@ Value Py_Iter(int argc, int kwargc);
 
 Value Py_Next(int argc, int kwargc);
 
+Value Py_HeapSnapshot(int argc, int kwargc);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef NUMERIC_H
+#define NUMERIC_H
+
+#include <stdlib.h>
+
+// Conversions between numbers and their decimal text, shared by str() and
+// repr(), int() and float(), and the compiler's number literals.
+
+// Enough for "-9223372036854775808".
+#define INT_BUFFER_SIZE 24
+
+// Enough for "-2.2250738585072014e-308" and the longest fixed-point output,
+// "-0.00012345678901234567".
+#define FLOAT_BUFFER_SIZE 32
+
+// Writes the decimal digits of value to buffer, two at a time, and returns
+// their length. The buffer is not NUL-terminated.
+int formatInt(char *buffer, long long value);
+
+// Writes the shortest text that reads back as value, laid out like Python's
+// repr: "1.0", "0.1", "1e+16", "1.5e-07", "inf", "nan".
+int formatFloat(char *buffer, double value);
+
+typedef enum {
+    PARSE_OK,
+    PARSE_INVALID,
+    PARSE_OVERFLOW,
+} ParseResult;
+
+// Python's int() and float() syntax: optional surrounding whitespace, a sign
+// and decimal digits with single underscores between them. float() also
+// takes a fraction, an exponent, "inf", "infinity" and "nan". Anything else
+// is invalid rather than silently truncated.
+ParseResult parseInt(const char *chars, size_t length, long long *value);
+
+ParseResult parseFloat(const char *chars, size_t length, double *value);
+
+#endif
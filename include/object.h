@@ -10,6 +10,7 @@
 struct Obj {
     ValueType type;
     bool isMarked;
+    bool isImmortal;
     struct Obj *next;
 };
 
@@ -17,6 +18,8 @@ struct Obj {
 
 Obj* allocateObject(size_t size, ValueType);
 
+Obj* allocateImmortalObject(size_t size, ValueType type);
+
 bool isObject(Value value);
 
 #endif
\ No newline at end of file
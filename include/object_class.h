@@ -84,18 +84,18 @@ Value Class_Call(Value callee, int argc, int kwargc, Value *argv);
 
 Value Class_GetAttr(Value obj, ObjString *name);
 
-int Class_ToStr(Value value, char *buffer, size_t size);
+void Class_ToStr(Value value, Writer *writer);
 
 Value NativeClass_Call(Value value, int argc, int kwargc, Value *argv);
 
-int NativeClass_ToStr(Value value, char *buffer, size_t size);
+void NativeClass_ToStr(Value value, Writer *writer);
 
 Value Method_Call(Value callee, int argc, int kwargc, Value *argv);
 
-int Method_ToStr(Value value, char *buffer, size_t size);
+void Method_ToStr(Value value, Writer *writer);
 
 Value NativeMethod_Call(Value callee, int argc, int kwargc, Value *argv);
 
-int NativeMethod_ToStr(Value value, char *buffer, size_t size);
+void NativeMethod_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
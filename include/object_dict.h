@@ -12,6 +12,8 @@
 #define DICT_METHODS (ValueMethods) { \
     .eq = Dict_Equal,                 \
     .ne = Dict_NotEqual,              \
+    .or = Dict_Or,                    \
+    .ior = Dict_InplaceOr,            \
     .contains = Dict_Contains,        \
     .class = Dict_Class,              \
     .iter = Dict_Iter,                \
@@ -32,10 +34,16 @@ typedef struct {
 
 ObjDict *allocateDict();
 
+void dictUpdate(ObjDict *dest, ObjDict *source);
+
 Value Dict_Equal(Value a, Value b);
 
 Value Dict_NotEqual(Value a, Value b);
 
+Value Dict_Or(Value a, Value b);
+
+Value Dict_InplaceOr(Value a, Value b);
+
 Value Dict_Contains(Value a, Value b);
 
 Value Dict_Class(Value value);
@@ -54,6 +62,6 @@ long long Dict_Len(Value value);
 
 bool Dict_ToBool(Value value);
 
-int Dict_ToStr(Value value, char *buffer, size_t size);
+void Dict_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -15,8 +15,8 @@
 
 typedef struct {
     Obj obj;
-    Entry **current;
-    Entry **end;
+    Value iterable;
+    size_t index;
 } ObjDictIterator;
 
 ObjDictIterator *allocateDictIterator(Value value);
@@ -91,6 +91,13 @@
     .repr = Exception_ToRepr                           \
 }
 
+#define MEMORY_ERROR_METHODS (ValueMethods) { \
+    .init = MemoryError_Init,                 \
+    .class = MemoryError_Class,               \
+    .str = Exception_ToStr,                   \
+    .repr = Exception_ToRepr                  \
+}
+
 typedef struct {
     Obj obj;
     Value value;
@@ -104,9 +111,9 @@ Value Exception_Init(Value callee, int argc, Value *argv);
 
 Value Exception_Class(Value value);
 
-int Exception_ToStr(Value value, char *buffer, const size_t size);
+void Exception_ToStr(Value value, Writer *writer);
 
-int Exception_ToRepr(Value value, char *buffer, const size_t size);
+void Exception_ToRepr(Value value, Writer *writer);
 
 Value ZeroDivisionError_Init(Value callee, int argc, Value *argv);
 
@@ -152,4 +159,8 @@ Value NotImplementedError_Init(Value callee, int argc, Value *argv);
 
 Value NotImplementedError_Class(Value value);
 
+Value MemoryError_Init(Value callee, int argc, Value *argv);
+
+Value MemoryError_Class(Value value);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef OBJECT_FROZENSET_H
+#define OBJECT_FROZENSET_H
+
+#include "object_set.h"
+
+#define FROZENSET_METHODS (ValueMethods) { \
+    .eq = Set_Equal,                       \
+    .ne = Set_NotEqual,                    \
+    .gt = Set_Greater,                     \
+    .ge = Set_GreaterEqual,                \
+    .lt = Set_Less,                        \
+    .le = Set_LessEqual,                   \
+    .sub = Set_Subtract,                   \
+    .and = Set_And,                        \
+    .xor = Set_Xor,                        \
+    .or = Set_Or,                          \
+    .contains = Set_Contains,              \
+    .init = FrozenSet_Init,                \
+    .class = FrozenSet_Class,              \
+    .iter = Set_Iter,                      \
+    .getattr = FrozenSet_GetAttr,          \
+    .hash = FrozenSet_Hash,                \
+    .len = Set_Len,                        \
+    .toBool = Set_ToBool,                  \
+    .str = Set_ToStr,                      \
+    .repr = Set_ToStr,                     \
+}
+
+Value FrozenSet_Init(Value callee, int argc, Value *argv);
+
+Value FrozenSet_Class(Value value);
+
+Value FrozenSet_GetAttr(Value value, ObjString *name);
+
+uint64_t FrozenSet_Hash(Value value);
+
+#endif
@@ -75,14 +75,14 @@ ObjClosure* createClosure(ObjFunction *function);
 
 ObjNative* createNative(NativeFn function, const char *name);
 
-int Function_ToStr(Value value, char *buffer, size_t size);
+void Function_ToStr(Value value, Writer *writer);
 
 Value Closure_Call(Value callee, int argc, int kwargc, Value *argv);
 
-int Closure_ToStr(Value value, char *buffer, size_t size);
+void Closure_ToStr(Value value, Writer *writer);
 
 Value Native_Call(Value callee, int argc, int kwargc, Value *argv);
 
-int Native_ToStr(Value value, char *buffer, size_t size);
+void Native_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
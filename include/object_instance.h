@@ -121,8 +121,8 @@ long long Instance_ToInt(Value value);
 
 double Instance_ToFloat(Value value);
 
-int Instance_ToStr(Value, char *buffer, size_t size);
+void Instance_ToStr(Value value, Writer *writer);
 
-int Instance_ToRepr(Value, char *buffer, size_t size);
+void Instance_ToRepr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
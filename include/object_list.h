@@ -2,15 +2,31 @@
 #define OBJECT_ARRAY_H
 
 #include "object.h"
-#include "value_vector.h"
 
 #define IS_LIST(value)         (value.type == VAL_LIST)
 
 #define AS_LIST(value)         ((ObjList*)value.as.object)
 
+// Storage strategy of a list. Lists holding only ints or only floats keep
+// them unboxed; the first element of another type switches the list to
+// boxed Values for good. An empty list adopts the strategy of whatever is
+// stored in it first.
+typedef enum {
+    LIST_OBJECTS,
+    LIST_INTS,
+    LIST_FLOATS,
+} ListStrategy;
+
 typedef struct {
     Obj obj;
-    ValueVec vec;
+    ListStrategy strategy;
+    int size;
+    int capacity;
+    union {
+        Value *values;
+        long long *ints;
+        double *floats;
+    } items;
 } ObjList;
 
 #define LIST_METHODS (ValueMethods) { \
@@ -23,6 +39,8 @@ typedef struct {
     .add = List_Add,                  \
     .mul = List_Multiply,             \
     .rmul = List_RightMultiply,       \
+    .iadd = List_InplaceAdd,          \
+    .imul = List_InplaceMultiply,     \
     .contains = List_Contains,        \
     .init = List_Init,                \
     .iter = List_Iter,                \
@@ -30,6 +48,7 @@ typedef struct {
     .init = List_Init,                \
     .getattr = List_GetAttr,          \
     .getitem = List_GetItem,          \
+    .getslice = List_GetSlice,        \
     .setitem = List_SetItem,          \
     .delitem = List_DelItem,          \
     .len = List_Len,                  \
@@ -40,6 +59,26 @@ typedef struct {
 
 ObjList* allocateList(int size);
 
+ObjList* listFromValues(Value *values, int count);
+
+ObjList* copyList(ObjList *list);
+
+void freeListItems(ObjList *list);
+
+Value listGet(ObjList *list, int index);
+
+void listSet(ObjList *list, int index, Value value);
+
+void listAppend(ObjList *list, Value value);
+
+void listInsert(ObjList *list, int index, Value value);
+
+void listDelete(ObjList *list, int index);
+
+void listClear(ObjList *list);
+
+void listReverse(ObjList *list);
+
 Value List_Equal(Value a, Value b);
 
 Value List_NotEqual(Value a, Value b);
@@ -58,6 +97,10 @@ Value List_Multiply(Value a, Value b);
 
 Value List_RightMultiply(Value a, Value b);
 
+Value List_InplaceAdd(Value a, Value b);
+
+Value List_InplaceMultiply(Value a, Value b);
+
 Value List_Contains(Value a, Value b);
 
 Value List_Iter(Value value);
@@ -70,6 +113,8 @@ Value List_GetAttr(Value list, ObjString *name);
 
 Value List_GetItem(Value obj, Value key);
 
+Value List_GetSlice(Value obj, Value start, Value stop, Value step);
+
 Value List_SetItem(Value obj, Value key, Value value);
 
 Value List_DelItem(Value obj, Value key);
@@ -78,12 +123,16 @@ long long List_Len(Value value);
 
 bool List_ToBool(Value value);
 
+Value List_Extend(Value obj, Value iterable);
+
 Value List_Append(Value obj, Value value);
 
 Value List_Pop(Value obj);
 
-Value List_Sort(Value obj);
+Value List_Sort(Value obj, Value key, bool reverse);
+
+Value List_Sum(Value obj, Value start);
 
-int List_ToStr(Value value, char *buffer, size_t size);
+void List_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -14,8 +14,8 @@
 
 typedef struct {
     Obj obj;
-    Value *current;
-    Value *end;
+    Value iterable;
+    int index;
 } ObjListIterator;
 
 ObjListIterator *allocateListIterator(Value value);
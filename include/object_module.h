@@ -27,10 +27,12 @@ typedef struct ObjModule {
 
 ObjModule *allocateModule();
 
+ObjModule *findBuiltinModule(const char *name, int length);
+
 Value Module_GetAttribute(Value obj, ObjString *name);
 
 Value Module_Call(Value callee, int argc, int kwargc, Value *argv);
 
-int Module_ToStr(Value value, char *buffer, size_t size);
+void Module_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -48,6 +48,6 @@ Value Range_Iter(Value value);
 
 long long Range_Len(Value value);
 
-int Range_ToStr(Value value, char *buffer, size_t size);
+void Range_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef OBJECT_SET_H
+#define OBJECT_SET_H
+
+#include "object.h"
+#include "hash_set.h"
+#include "value_methods.h"
+
+#define IS_SET(value)           ((value).type == VAL_SET)
+#define IS_FROZENSET(value)     ((value).type == VAL_FROZENSET)
+#define IS_ANY_SET(value)       (IS_SET(value) || IS_FROZENSET(value))
+
+#define AS_SET(value)           ((ObjSet*)(value).as.object)
+
+#define SET_METHODS (ValueMethods) { \
+    .eq = Set_Equal,                 \
+    .ne = Set_NotEqual,              \
+    .gt = Set_Greater,               \
+    .ge = Set_GreaterEqual,          \
+    .lt = Set_Less,                  \
+    .le = Set_LessEqual,             \
+    .sub = Set_Subtract,             \
+    .and = Set_And,                  \
+    .xor = Set_Xor,                  \
+    .or = Set_Or,                    \
+    .isub = Set_InplaceSubtract,     \
+    .iand = Set_InplaceAnd,          \
+    .ixor = Set_InplaceXor,          \
+    .ior = Set_InplaceOr,            \
+    .contains = Set_Contains,        \
+    .init = Set_Init,                \
+    .class = Set_Class,              \
+    .iter = Set_Iter,                \
+    .getattr = Set_GetAttr,          \
+    .len = Set_Len,                  \
+    .toBool = Set_ToBool,            \
+    .str = Set_ToStr,                \
+    .repr = Set_ToStr,               \
+}
+
+// Shared by set and frozenset; only the object type differs. A frozenset
+// caches its hash the first time it is asked for.
+typedef struct {
+    Obj obj;
+    HashSet set;
+    bool isHashed;
+    uint64_t hash;
+} ObjSet;
+
+ObjSet *allocateSet(ValueType type);
+
+Value setFromIterable(ValueType type, Value iterable);
+
+Value expectHashable(Value value);
+
+Value Set_Equal(Value a, Value b);
+
+Value Set_NotEqual(Value a, Value b);
+
+Value Set_Greater(Value a, Value b);
+
+Value Set_GreaterEqual(Value a, Value b);
+
+Value Set_Less(Value a, Value b);
+
+Value Set_LessEqual(Value a, Value b);
+
+Value Set_Subtract(Value a, Value b);
+
+Value Set_And(Value a, Value b);
+
+Value Set_Xor(Value a, Value b);
+
+Value Set_Or(Value a, Value b);
+
+Value Set_InplaceSubtract(Value a, Value b);
+
+Value Set_InplaceAnd(Value a, Value b);
+
+Value Set_InplaceXor(Value a, Value b);
+
+Value Set_InplaceOr(Value a, Value b);
+
+Value Set_Contains(Value a, Value b);
+
+Value Set_Init(Value callee, int argc, Value *argv);
+
+Value Set_Class(Value value);
+
+Value Set_Iter(Value value);
+
+Value Set_GetAttr(Value value, ObjString *name);
+
+long long Set_Len(Value value);
+
+bool Set_ToBool(Value value);
+
+void Set_ToStr(Value value, Writer *writer);
+
+#endif
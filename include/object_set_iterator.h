@@ -0,0 +1,29 @@
+#ifndef OBJECT_SET_ITERATOR
+#define OBJECT_SET_ITERATOR
+
+#include "value.h"
+#include "object.h"
+
+#define AS_SET_ITERATOR(value)    ((ObjSetIterator*)value.as.object)
+
+#define SET_ITERATOR_METHODS (ValueMethods) { \
+    .iter = SetIterator_Iter,                 \
+    .next = SetIterator_Next,                 \
+    .class = SetIterator_Class,               \
+}
+
+typedef struct {
+    Obj obj;
+    Value iterable;
+    size_t index;
+} ObjSetIterator;
+
+ObjSetIterator *allocateSetIterator(Value value);
+
+Value SetIterator_Iter(Value value);
+
+Value SetIterator_Next(Value value);
+
+Value SetIterator_Class(Value value);
+
+#endif
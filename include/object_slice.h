@@ -33,6 +33,10 @@ typedef struct {
 
 ObjSlice *allocateSlice(Value start, Value stop, Value step);
 
+// Bounds are resolved as in slice.indices(); a zero step is left for the
+// caller to report. Items are start, start + step, ... for `length` steps.
+ParsedSlice resolveSlice(Value start, Value stop, Value step, long long length);
+
 ParsedSlice parseSlice(ObjSlice *slice, long long length);
 
 Value Slice_Equal(Value a, Value b);
@@ -45,6 +49,6 @@ Value Slice_Class(Value self);
 
 Value Slice_GetAttr(Value list, ObjString *name);
 
-int Slice_ToStr(Value value, char *buffer, size_t size);
+void Slice_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
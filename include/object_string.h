@@ -8,8 +8,14 @@
 #define IS_STRING(value)        ((value).type == VAL_STRING) 
 
 #define AS_STRING(value)        ((ObjString*)((value).as.object))
+
 #define AS_CHARS(value)         (((ObjString*)((value).as.object))->chars)
 
+// Shared immortal strings, see initCharacterStrings.
+#define EMPTY_STRING()          (vm.emptyString)
+
+#define CHARACTER_STRING(c)     (vm.characters[(unsigned char)(c)])
+
 #define STRING_METHODS (ValueMethods){ \
     .eq = String_Equal,                \
     .ne = String_NotEqual,             \
@@ -21,36 +27,84 @@
     .radd = String_Add,                \
     .mul = String_Multiply,            \
     .rmul = String_RightMultiply,      \
+    .mod = String_Modulo,              \
     .contains = String_Contains,       \
     .class = String_Class,             \
     .init = String_Init,               \
     .iter = String_Iter,               \
     .getattr = String_GetAttribute,    \
     .getitem = String_GetItem,         \
+    .getslice = String_GetSlice,       \
     .hash = String_Hash,               \
     .len = String_Len,                 \
     .toBool = String_ToBool,           \
-    .toInt = String_ToInt,             \
-    .toFloat = String_ToFloat,         \
     .str = String_ToStr,               \
     .repr = String_ToRepr,             \
 }
 
+#define STRING_INDEX_STRIDE 64
+
+// `capacity` bytes are allocated for chars (plus the terminator). A builder is
+// a string that `x += y` left in a variable with spare capacity: until the
+// variable is read any other way it is the sole reference, so the next `+=`
+// may append in place.
+//
+// chars hold UTF-8 and `length` counts bytes. Like the hash, the code point
+// count is computed on first use (-1 until then); a string is ASCII when the
+// two agree, and then indexes by byte. Other strings build `offsets` on first
+// indexed access: the byte offset of every STRING_INDEX_STRIDE-th code point.
+//
+// A string used as a format template keeps its parsed form in formatTemplate,
+// see string_format.h.
 struct ObjString {
     Obj obj;
     int length;
+    int capacity;
+    int codePoints;
+    int *offsets;
+    struct FormatTemplate *formatTemplate;
     uint64_t hash;
     bool isHashed;
     bool isInterned;
+    bool isBuilder;
     char chars[];
 };
 
 ObjString *allocateString(size_t length);
 
+ObjString *allocateImmortalString(size_t length);
+
+void initCharacterStrings();
+
 ObjString *copyString(const char *chars, size_t length);
 
+// Interned strings are unique by content. internString allocates a
+// collectable string, dropped from vm.strings once unreachable; compile-time
+// literals and builtin names use internImmortalString, which allocates in the
+// immortal arena. Either returns the existing string when there is one.
+ObjString *internString(const char *chars, size_t length);
+
+ObjString *internImmortalString(const char *chars, size_t length);
+
+// Used for compile-time literals: the result lives in the immortal arena
 ObjString *copyEscapedString(const char *chars, size_t length);
 
+int stringCodePoints(ObjString *string);
+
+bool stringIsAscii(ObjString *string);
+
+int stringByteOffset(ObjString *string, int index);
+
+// The bytes string->chars[from, to) as a string; empty and single-byte results
+// are the shared immortal strings.
+Value substring(ObjString *string, int from, int to);
+
+int stringCodePointIndex(ObjString *string, int offset);
+
+void freeStringIndex(ObjString *string);
+
+void freeStringFormat(ObjString *string);
+
 Value String_Equal(Value a, Value b);
 
 Value String_NotEqual(Value a, Value b);
@@ -65,10 +119,18 @@ Value String_LessEqual(Value a, Value b);
 
 Value String_Add(Value a, Value b);
 
+Value String_Concat(Value a, Value b);
+
+Value String_Share(Value value);
+
+Value String_Claim(Value value);
+
 Value String_Multiply(Value a, Value b);
 
 Value String_RightMultiply(Value a, Value b);
 
+Value String_Modulo(Value a, Value b);
+
 Value String_Contains(Value a, Value b);
 
 Value String_Class(Value value);
@@ -81,18 +143,16 @@ Value String_GetAttribute(Value value, ObjString *name);
 
 Value String_GetItem(Value value, Value key);
 
+Value String_GetSlice(Value value, Value start, Value stop, Value step);
+
 uint64_t String_Hash(Value value);
 
 long long String_Len(Value value);
 
 bool String_ToBool(Value value);
 
-long long String_ToInt(Value value);
-
-double String_ToFloat(Value value);
-
-int String_ToStr(Value value, char *buffer, size_t size);
+void String_ToStr(Value value, Writer *writer);
 
-int String_ToRepr(Value value, char *buffer, size_t size);
+void String_ToRepr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -14,7 +14,8 @@
 
 typedef struct {
     Obj obj;
-    char *current;
+    Value iterable;
+    int offset;
 } ObjStringIterator;
 
 ObjStringIterator *allocateStringIterator(Value value);
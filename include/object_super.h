@@ -27,6 +27,6 @@ Value Super_Init(Value callee, int argc, Value *argv);
 
 Value Super_GetAttr(Value value, ObjString *name);
 
-int Super_ToStr(Value value, char *buffer, const size_t size);
+void Super_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -20,18 +20,24 @@
     .rmul = Tuple_RightMultiply,       \
     .contains = Tuple_Contains,        \
     .getitem = Tuple_GetItem,          \
+    .getslice = Tuple_GetSlice,        \
     .getattr = Tuple_GetAttribute,     \
     .class = Tuple_Class,              \
     .init = Tuple_Init,                \
     .iter = Tuple_Iter,                \
+    .hash = Tuple_Hash,                \
     .len = Tuple_Len,                  \
     .toBool = Tuple_ToBool,            \
     .str = Tuple_ToStr,                \
     .repr = Tuple_ToStr,               \
 }
 
+// The hash is computed from the elements on first use and cached, since a
+// tuple's elements never change after it is built.
 typedef struct {
     Obj obj;
+    bool isHashed;
+    uint64_t hash;
     size_t size;
     Value values[];
 } ObjTuple;
@@ -60,6 +66,8 @@ Value Tuple_Contains(Value a, Value b);
 
 Value Tuple_GetItem(Value obj, Value key);
 
+Value Tuple_GetSlice(Value obj, Value start, Value stop, Value step);
+
 Value Tuple_Class(Value value);
 
 Value Tuple_GetAttribute(Value value, ObjString *name);
@@ -68,12 +76,14 @@ Value Tuple_Init(Value callee, int argc, Value *argv);
 
 Value Tuple_Iter(Value value);
 
+uint64_t Tuple_Hash(Value value);
+
 int Tuple_Index(Value obj, Value value, int start, int end);
 
 long long Tuple_Len(Value value);
 
 bool Tuple_ToBool(Value value);
 
-int Tuple_ToStr(Value value, char *buffer, size_t size);
+void Tuple_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 typedef struct {
     Obj obj;
+    Value iterable;
     Value *current;
     Value *end;
 } ObjTupleIterator;
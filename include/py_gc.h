@@ -0,0 +1,28 @@
+#ifndef PY_GC_H
+#define PY_GC_H
+
+#include "object_module.h"
+
+ObjModule *createGCModule();
+
+Value PyGC_Collect(int argc, int kwargc);
+
+Value PyGC_Enable(int argc, int kwargc);
+
+Value PyGC_Disable(int argc, int kwargc);
+
+Value PyGC_IsEnabled(int argc, int kwargc);
+
+Value PyGC_IsTracked(int argc, int kwargc);
+
+Value PyGC_GetStats(int argc, int kwargc);
+
+Value PyGC_GetThreshold(int argc, int kwargc);
+
+Value PyGC_SetThreshold(int argc, int kwargc);
+
+Value PyGC_GetDebug(int argc, int kwargc);
+
+Value PyGC_SetDebug(int argc, int kwargc);
+
+#endif
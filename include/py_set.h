@@ -0,0 +1,32 @@
+#ifndef PY_SET_H
+#define PY_SET_H
+
+#include "value.h"
+
+Value PySet_Add(int argc, int kwargc);
+
+Value PySet_Clear(int argc, int kwargc);
+
+Value PySet_Copy(int argc, int kwargc);
+
+Value PySet_Difference(int argc, int kwargc);
+
+Value PySet_Discard(int argc, int kwargc);
+
+Value PySet_Intersection(int argc, int kwargc);
+
+Value PySet_IsDisjoint(int argc, int kwargc);
+
+Value PySet_IsSubset(int argc, int kwargc);
+
+Value PySet_IsSuperset(int argc, int kwargc);
+
+Value PySet_Pop(int argc, int kwargc);
+
+Value PySet_Remove(int argc, int kwargc);
+
+Value PySet_Union(int argc, int kwargc);
+
+Value PySet_Update(int argc, int kwargc);
+
+#endif
\ No newline at end of file
@@ -21,6 +21,8 @@ Value PyString_Multiply(int argc, int kwargc);
 
 Value PyString_RightMultiply(int argc, int kwargc);
 
+Value PyString_Modulo(int argc, int kwargc);
+
 Value PyString_Contains(int argc, int kwargc);
 
 Value PyString_Iter(int argc, int kwargc);
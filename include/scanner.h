@@ -19,6 +19,7 @@ typedef struct Scanner {
     int indent;
     bool inFormattedString;
     char stop;
+    int formatDepth;
 } Scanner;
 
 char *readFile(const char *path);
@@ -0,0 +1,37 @@
+#ifndef STRING_FORMAT_H
+#define STRING_FORMAT_H
+
+#include "object_string.h"
+
+// str.format, str.format_map and f-strings use the `{}` syntax, `str % args`
+// the printf-style one. A template is parsed on first use and the parsed form
+// is kept on the template string, so formatting the same string again only
+// walks its pieces, writing each one straight into the output buffer.
+typedef enum {
+    TEMPLATE_BRACES,
+    TEMPLATE_PERCENT,
+} TemplateSyntax;
+
+typedef struct FormatTemplate FormatTemplate;
+
+// Where replacement fields take their values from. `keywords` holds
+// `keywordCount` (name, value) pairs, laid out like the keyword arguments of
+// a native call on the stack. A mapping other than UNDEFINED_VAL is indexed
+// by name instead: format_map and `%(name)s`.
+typedef struct {
+    Value *positional;
+    int positionalCount;
+    Value *keywords;
+    int keywordCount;
+    Value mapping;
+} FormatArgs;
+
+// Returns the formatted str, or the exception to raise.
+Value formatTemplate(ObjString *string, TemplateSyntax syntax, FormatArgs *args);
+
+void freeFormatTemplate(FormatTemplate *template);
+
+// Marks the names held by every cached template.
+void markFormatTemplates();
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef STRING_SCAN_H
+#define STRING_SCAN_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+// ASCII character classes. Bytes of non-ASCII code points belong to none of
+// them, so scans never stop inside a multi-byte code point.
+typedef enum {
+    CLASS_SPACE,
+    CLASS_DIGIT,
+    CLASS_LOWER,
+    CLASS_UPPER,
+    CLASS_ALPHA,
+    CLASS_ALNUM,
+} CharClass;
+
+typedef enum {
+    CASE_UPPER,
+    CASE_LOWER,
+    CASE_SWAP,
+} CaseMapping;
+
+bool inClass(char c, CharClass class);
+
+// Length of the longest prefix of chars[0, length) made of bytes in the class.
+size_t spanClass(const char *chars, size_t length, CharClass class);
+
+// Length of the longest suffix made of bytes in the class.
+size_t rspanClass(const char *chars, size_t length, CharClass class);
+
+// Offset of the first byte in the class, or length if there is none.
+size_t findClass(const char *chars, size_t length, CharClass class);
+
+// Offset of the last byte in the class, or -1 if there is none.
+long long rfindClass(const char *chars, size_t length, CharClass class);
+
+// Copies src[0, length) to dest with the ASCII letters case mapped. Other
+// bytes are copied unchanged.
+void mapAsciiCase(char *dest, const char *src, size_t length, CaseMapping mapping);
+
+#endif
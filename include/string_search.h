@@ -0,0 +1,32 @@
+#ifndef STRING_SEARCH_H
+#define STRING_SEARCH_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+// A needle prepared for repeated searches. Short needles are found with memchr
+// on their first byte and a memcmp to confirm; longer ones use Crochemore and
+// Perrin's Two-Way algorithm, which stays linear on any input. A reverse
+// searcher finds the last occurrence instead of the first.
+typedef struct {
+    const char *needle;
+    size_t length;
+    bool reverse;
+    bool twoWay;
+    bool periodic;
+    size_t suffix;
+    size_t period;
+} Searcher;
+
+void initSearcher(Searcher *searcher, const char *needle, size_t length, bool reverse);
+
+// Offset of the first (or last, for a reverse searcher) occurrence of the
+// needle in haystack[0, length), or -1. An empty needle matches at the start
+// (or the end).
+long long searchIn(Searcher *searcher, const char *haystack, size_t length);
+
+long long findSubstring(const char *haystack, size_t length, const char *needle, size_t needleLength);
+
+long long rfindSubstring(const char *haystack, size_t length, const char *needle, size_t needleLength);
+
+#endif
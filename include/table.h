@@ -5,16 +5,30 @@
 
 #include "value.h"
 
+// Key layout of a table. It is picked by the first key inserted and falls
+// back to TABLE_GENERIC for good on the first key of another type.
+typedef enum {
+    TABLE_EMPTY,
+    TABLE_STRING_KEYS,
+    TABLE_INT_KEYS,
+    TABLE_GENERIC,
+} TableKind;
+
+// Compact ordered table: `indices` is a sparse open-addressed array of
+// int8/16/32/64 slots (width picked from capacity) pointing into the dense,
+// insertion-ordered `entries` array. Deleted entries leave a hole (undefined
+// value) until the next rebuild compacts them away. Capacity is a power of two.
+// The entry layout depends on `kind`: string-keyed tables store the ObjString
+// pointer and reuse its cached hash, int-keyed tables store raw integers, and
+// generic tables store the boxed key together with its full hash.
 typedef struct {
-    Value key;
-    Value value;
-} Entry;
-
-typedef struct {
+    TableKind kind;
     size_t size;
+    size_t used;
+    size_t fill;
     size_t capacity;
-    Entry *entries;
-    Entry **order;
+    void *indices;
+    void *entries;
 } Table;
 
 void tableInit(Table *table);
@@ -27,8 +41,18 @@ bool tableSet(Table *table, Value key, Value value);
 
 Value tableDelete(Table *table, Value key);
 
+bool tablePopLast(Table *table, Value *key, Value *value);
+
+bool tableNext(Table *table, size_t *index, Value *key, Value *value);
+
+uint64_t tableKeyHash(Value key);
+
+bool tableKeysEqual(Value a, Value b);
+
 bool compareTables(Table *a, Table *b);
 
+void markTable(Table *table);
+
 void tableDebug(Table *table);
 
-#endif
\ No newline at end of file
+#endif
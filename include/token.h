@@ -39,7 +39,8 @@ typedef enum {
 
     // Literals
     TOKEN_NONE, TOKEN_FALSE, TOKEN_TRUE, TOKEN_NUMBER, TOKEN_IDENTIFIER,
-    TOKEN_STRING, TOKEN_RSTRING, TOKEN_FSTRING, TOKEN_USTRING,
+    TOKEN_STRING, TOKEN_RSTRING, TOKEN_FSTRING, TOKEN_FSTRING_END, TOKEN_USTRING,
+    TOKEN_CONVERSION, TOKEN_FORMAT_SPEC,
 
     // Keywords
     TOKEN_ASSERT, TOKEN_ASYNC, TOKEN_AWAIT, TOKEN_BREAK, TOKEN_CLASS,
@@ -0,0 +1,24 @@
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Strings hold UTF-8. A code point starts at every byte that is not a
+// continuation byte (10xxxxxx), so stray bytes of malformed input count as
+// one code point each instead of failing.
+#define IS_CONTINUATION_BYTE(c) (((unsigned char)(c) & 0xc0) == 0x80)
+
+// Number of code points in chars[0, length), scanning sixteen bytes at a time
+// with SSE2 where available and eight bytes at a time otherwise.
+size_t countCodePoints(const char *chars, size_t length);
+
+// Offset just past the code point starting at chars[offset].
+size_t nextCodePoint(const char *chars, size_t length, size_t offset);
+
+// Writes the UTF-8 bytes of a code point below 0x110000 and returns their
+// count, at most four.
+int encodeCodePoint(char *buffer, uint32_t codePoint);
+
+#endif
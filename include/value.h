@@ -9,6 +9,7 @@ typedef struct Obj Obj;
 typedef struct ObjString ObjString;
 typedef struct ObjFunction ObjFunction;
 typedef struct ObjModule ObjModule;
+typedef struct Writer Writer;
 
 typedef enum {
     // Values
@@ -29,6 +30,9 @@ typedef enum {
     VAL_TUPLE_ITERATOR,
     VAL_DICT,
     VAL_DICT_ITERATOR,
+    VAL_SET,
+    VAL_FROZENSET,
+    VAL_SET_ITERATOR,
     VAL_FUNCTION,
     VAL_CLOSURE,
     VAL_UPVALUE,
@@ -54,6 +58,7 @@ typedef enum {
     VAL_RUNTIME_ERROR,
     VAL_ASSERTION_ERROR,
     VAL_NOT_IMPLEMENTED_ERROR,
+    VAL_MEMORY_ERROR,
     VAL_MODULE,
 } ValueType;
 
@@ -120,6 +125,18 @@ typedef struct {
     BinaryMethod rlshift;
     BinaryMethod rshift;
     BinaryMethod rrshift;
+    BinaryMethod iadd;
+    BinaryMethod isub;
+    BinaryMethod imul;
+    BinaryMethod itruediv;
+    BinaryMethod ifloordiv;
+    BinaryMethod imod;
+    BinaryMethod ipow;
+    BinaryMethod iand;
+    BinaryMethod ixor;
+    BinaryMethod ior;
+    BinaryMethod ilshift;
+    BinaryMethod irshift;
     BinaryMethod contains;
     Value (*init)(Value, int, Value*);
     Value (*call)(Value, int, int, Value*);
@@ -130,6 +147,7 @@ typedef struct {
     Value (*setattr)(Value, ObjString *name, Value);
     Value (*delattr)(Value, ObjString *name);
     Value (*getitem)(Value, Value);
+    Value (*getslice)(Value, Value start, Value stop, Value step);
     Value (*setitem)(Value, Value, Value);
     Value (*delitem)(Value, Value);
     uint64_t (*hash)(Value);
@@ -137,8 +155,8 @@ typedef struct {
     bool (*toBool)(Value);
     long long (*toInt)(Value);
     double (*toFloat)(Value);
-    int (*str)(Value, char*, size_t);
-    int (*repr)(Value, char*, size_t);
+    void (*str)(Value, Writer*);
+    void (*repr)(Value, Writer*);
 } ValueMethods;
 
 #define NONE_VAL             ((Value){.type=VAL_NONE, .as.integer=0})
@@ -149,12 +167,8 @@ typedef struct {
 #define IS_UNDEFINED(value) ((value).type == VAL_UNDEFINED)
 #define IS_NOT_IMPLEMENTED(value)  ((value).type == VAL_NOT_IMPLEMENTED)
 
-int writeToBuffer(char *buffer, const size_t size, const char *format, ...);
-
 Value getStaticAttribute(Value value, ObjString *name, const struct StaticAttribute*(*in_word_set)(register const char*, register size_t));
 
 int calculateIndex(int index, int length);
 
-int movePointer(char **buffer, int bytesWritten);
-
 #endif
\ No newline at end of file
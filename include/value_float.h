@@ -98,6 +98,6 @@ long long Float_ToInt(Value value);
 
 double Float_ToFloat(Value value);
 
-int Float_ToStr(Value value, char *buffer, const size_t size);
+void Float_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -165,7 +165,7 @@ long long Int_ToInt(Value value);
 
 double Int_ToFloat(Value value);
 
-int Int_ToStr(Value value, char *buffer, const size_t size);
+void Int_ToStr(Value value, Writer *writer);
 
 Value Bool_Init(Value callee, int argc, Value *argv);
 
@@ -173,6 +173,6 @@ Value Bool_Class(Value value);
 
 Value Bool_GetAttribute(Value obj, ObjString *name);
 
-int Bool_ToStr(Value value, char *buffer, const size_t size);
+void Bool_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -2,16 +2,15 @@
 #define VALUE_UTILS_H
 
 #include "value.h"
+#include "writer.h"
 
-int writeToBuffer(char *buffer, const size_t size, const char *format, ...);
+void valueWrite(Value value, Writer *writer);
 
-int valueWrite(Value value, char *buffer, const size_t size);
+void valueReprWrite(Value value, Writer *writer);
 
-int valueReprWrite(Value value, char *buffer, size_t size);
+void valuePrint(Value value);
 
-int valuePrint(Value value);
-
-int valueRepr(Value value);
+void valueRepr(Value value);
 
 char *getValueType(Value value);
 
@@ -59,6 +58,30 @@ Value valueLeftShift(Value a, Value b);
 
 Value valueRightShift(Value a, Value b);
 
+Value valueInplaceAdd(Value a, Value b);
+
+Value valueInplaceSubtract(Value a, Value b);
+
+Value valueInplaceMultiply(Value a, Value b);
+
+Value valueInplaceTrueDivide(Value a, Value b);
+
+Value valueInplaceFloorDivide(Value a, Value b);
+
+Value valueInplaceModulo(Value a, Value b);
+
+Value valueInplacePower(Value a, Value b);
+
+Value valueInplaceAnd(Value a, Value b);
+
+Value valueInplaceXor(Value a, Value b);
+
+Value valueInplaceOr(Value a, Value b);
+
+Value valueInplaceLeftShift(Value a, Value b);
+
+Value valueInplaceRightShift(Value a, Value b);
+
 Value valueContains(Value a, Value b);
 
 Value valueGetAttribute(Value obj, ObjString *name);
@@ -69,6 +92,8 @@ Value valueDelAttribute(Value obj, ObjString *name);
 
 Value valueGetItem(Value obj, Value key);
 
+Value valueGetSlice(Value obj, Value start, Value stop, Value step);
+
 Value valueSetItem(Value obj, Value key, Value value);
 
 Value valueDelItem(Value obj, Value key);
@@ -85,6 +110,8 @@ Value valueNext(Value value);
 
 uint64_t valueHash(Value value);
 
+Value findUnhashable(Value value);
+
 uint64_t valueId(Value value);
 
 long long valueLen(Value value);
@@ -25,6 +25,6 @@ Value None_Class(Value value);
 
 bool None_ToBool(Value value);
 
-int None_ToStr(Value value, char *buffer, size_t size);
+void None_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -7,6 +7,6 @@ Value Object_Equal(Value a, Value b);
 
 Value Object_NotEqual(Value a, Value b);
 
-int Object_ToStr(Value value, char *buffer, const size_t size);
+void Object_ToStr(Value value, Writer *writer);
 
 #endif
\ No newline at end of file
@@ -1,15 +1,22 @@
 #ifndef VM_H
 #define VM_H
 
+#include <setjmp.h>
+
 #include "common.h"
 #include "code.h"
 #include "table.h"
+#include "name_table.h"
+#include "arena.h"
+#include "memory.h"
 #include "object.h"
 #include "object_function.h"
 #include "object_class.h"
 #include "object_module.h"
+#include "writer.h"
 
 #define FRAMES_SIZE 64
+#define OUTPUT_BUFFER_SIZE 8192
 #define STACK_SIZE (FRAMES_SIZE * UINT8_MAX)
 
 #define TYPE_CLASS(name)    (OBJ_VAL(vm.types.name))
@@ -22,6 +29,7 @@ typedef struct {
     uint8_t *ip;
     Value *slots;
     uint8_t *exceptAddr[256];
+    Value *exceptTop[256];
     int exceptPointer;
     bool isMethod;
 } CallFrame;
@@ -80,6 +88,9 @@ typedef struct {
     ObjNativeClass *tupleIterator;
     ObjNativeClass *dict;
     ObjNativeClass *dictIterator;
+    ObjNativeClass *set;
+    ObjNativeClass *frozenset;
+    ObjNativeClass *setIterator;
     ObjNativeClass *exception;
     ObjNativeClass *zeroDivisionError;
     ObjNativeClass *stopIteration;
@@ -92,6 +103,7 @@ typedef struct {
     ObjNativeClass *runtimeError;
     ObjNativeClass *assertionError;
     ObjNativeClass *notImplementedError;
+    ObjNativeClass *memoryError;
     ObjNativeClass *super;
     ObjNativeClass *range;
     ObjNativeClass *rangeIterator;
@@ -99,6 +111,16 @@ typedef struct {
     ObjNativeClass *slice;
 } BaseTypes;
 
+// A call from native code back into the interpreter. Frames above frameSize
+// belong to it; an exception they do not handle jumps back to the caller
+// instead of unwinding the frames below.
+typedef struct NativeCall {
+    struct NativeCall *previous;
+    int frameSize;
+    jmp_buf jump;
+    Value exception;
+} NativeCall;
+
 typedef struct {
     CallFrame frames[FRAMES_SIZE];
     int frameSize;
@@ -106,15 +128,28 @@ typedef struct {
     uint8_t *ip;
     Value stack[STACK_SIZE];
     Value *top;
+    NativeCall *nativeCall;
     Table builtin;
+    Table modules;
+    NameTable strings;
+    ObjString *emptyString;
+    ObjString *characters[256];
     MagicStrings magicStrings;
     BaseTypes types;
     ObjUpvalue *openUpvalues;
+    // The builder taken off a variable by the read of `x += y`, until its
+    // concat runs; see String_Claim.
+    ObjString *claimedBuilder;
     Obj *objects;
+    size_t objectCount;
+    Arena immortals;
     size_t bytesAllocated;
     size_t nextGC;
+    GarbageCollector gc;
     bool allowStackPrinting;
     const char *path;
+    Writer output;
+    bool outputIsTTY;
 } VM;
 
 typedef enum {
@@ -136,6 +171,8 @@ void parseArgs(int argc, int kwargc, int arity, char *keywords[], ...);
 
 void raise();
 
+void flushOutput();
+
 void raiseIfException();
 
 void reportRuntimeError(const char *format, ...);
@@ -0,0 +1,40 @@
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+
+#include "value.h"
+
+#define WRITER_INLINE_SIZE 256
+
+// Append-only text buffer used by every str and repr implementation. Output
+// starts in the inline array and spills to the heap once it outgrows it, so
+// nothing is truncated and short results never allocate.
+struct Writer {
+    char *chars;
+    size_t length;
+    size_t capacity;
+    char inlineChars[WRITER_INLINE_SIZE];
+};
+
+void initWriter(Writer *writer);
+
+void freeWriter(Writer *writer);
+
+void writeChars(Writer *writer, const char *chars, size_t length);
+
+void writeChar(Writer *writer, char c);
+
+void writeCString(Writer *writer, const char *chars);
+
+void writeFormat(Writer *writer, const char *format, ...);
+
+void writeVFormat(Writer *writer, const char *format, va_list args);
+
+ObjString *writerToString(Writer *writer);
+
+void writerFlush(Writer *writer, FILE *stream);
+
+#endif
@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "alloc_trace.h"
+#include "debug.h"
+#include "vm.h"
+#include "value_int.h"
+#include "object_string.h"
+#include "object_tuple.h"
+#include "object_dict.h"
+#include "value_methods.h"
+
+#define TYPE_COUNT (VAL_MODULE + 1)
+#define REPORT_SITES 20
+
+typedef struct {
+    size_t count;
+    size_t bytes;
+    size_t live;
+    size_t liveBytes;
+} TypeStats;
+
+typedef struct {
+    const char *function;
+    int line;
+    size_t count;
+    size_t bytes;
+} SiteStats;
+
+typedef struct {
+    Obj *object;
+    size_t size;
+} LiveEntry;
+
+typedef struct {
+    TypeStats types[TYPE_COUNT];
+
+    SiteStats *sites;
+    int lastSite;
+    int siteCount;
+    int siteCapacity;
+
+    LiveEntry *live;
+    size_t liveCount;
+    size_t liveCapacity;
+
+    size_t reallocCalls;
+    size_t bytesGrown;
+    size_t bytesReleased;
+    size_t peakBytes;
+
+    bool reported;
+} AllocTrace;
+
+#define TOMBSTONE_OBJECT ((Obj*)1)
+
+bool traceAllocEnabled = false;
+
+static AllocTrace trace;
+
+static void* checkedAlloc(size_t size) {
+    void *pointer = calloc(1, size);
+    if (pointer == NULL) {
+        fprintf(stderr, "Failed to allocate memory for allocation trace\n");
+        exit(1);
+    }
+    return pointer;
+}
+
+void initAllocTrace() {
+    memset(&trace, 0, sizeof(AllocTrace));
+    traceAllocEnabled = true;
+    atexit(printAllocReport);
+}
+
+static SiteStats* findSite(const char *function, int line) {
+    if (trace.siteCount != 0) {
+        SiteStats *site = &trace.sites[trace.lastSite];
+        if (site->line == line && site->function == function)
+            return site;
+    }
+
+    for (int i = 0; i < trace.siteCount; i++) {
+        SiteStats *site = &trace.sites[i];
+        if (site->line == line && site->function == function) {
+            trace.lastSite = i;
+            return site;
+        }
+    }
+
+    if (trace.siteCount == trace.siteCapacity) {
+        trace.siteCapacity = trace.siteCapacity < 16 ? 16 : trace.siteCapacity * 2;
+        trace.sites = realloc(trace.sites, sizeof(SiteStats) * trace.siteCapacity);
+        if (trace.sites == NULL) {
+            fprintf(stderr, "Failed to allocate memory for allocation trace\n");
+            exit(1);
+        }
+    }
+
+    trace.lastSite = trace.siteCount;
+    SiteStats *site = &trace.sites[trace.siteCount++];
+    site->function = function;
+    site->line = line;
+    site->count = 0;
+    site->bytes = 0;
+    return site;
+}
+
+static SiteStats* currentSite() {
+    if (vm.frameSize == 0)
+        return findSite("<compile>", 0);
+
+    CallFrame *current = &vm.frames[vm.frameSize - 1];
+    if (current->closure == NULL)
+        return findSite("<runtime>", 0);
+    ObjFunction *function = current->closure->function;
+    int index = current->ip - function->code.code - 1;
+    if (index < 0)
+        index = 0;
+    const char *name = function->name != NULL ? function->name->chars : "<top level>";
+    return findSite(name, function->code.lines[index]);
+}
+
+static size_t liveIndex(Obj *object, size_t capacity) {
+    return ((uintptr_t)object >> 3) & (capacity - 1);
+}
+
+static LiveEntry* findLive(LiveEntry *entries, size_t capacity, Obj *object) {
+    size_t index = liveIndex(object, capacity);
+    LiveEntry *tombstone = NULL;
+
+    while (true) {
+        LiveEntry *entry = &entries[index];
+        if (entry->object == NULL)
+            return tombstone != NULL ? tombstone : entry;
+        if (entry->object == TOMBSTONE_OBJECT) {
+            if (tombstone == NULL)
+                tombstone = entry;
+        } else if (entry->object == object) {
+            return entry;
+        }
+        index = (index + 1) & (capacity - 1);
+    }
+}
+
+static void growLive() {
+    size_t capacity = trace.liveCapacity < 1024 ? 1024 : trace.liveCapacity * 2;
+    LiveEntry *entries = checkedAlloc(sizeof(LiveEntry) * capacity);
+
+    for (size_t i = 0; i < trace.liveCapacity; i++) {
+        LiveEntry *entry = &trace.live[i];
+        if (entry->object == NULL || entry->object == TOMBSTONE_OBJECT)
+            continue;
+        *findLive(entries, capacity, entry->object) = *entry;
+    }
+
+    trace.liveCount = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        if (entries[i].object != NULL)
+            trace.liveCount++;
+    }
+
+    free(trace.live);
+    trace.live = entries;
+    trace.liveCapacity = capacity;
+}
+
+void traceAllocation(Obj *object, size_t size) {
+    TypeStats *type = &trace.types[object->type];
+    type->count++;
+    type->bytes += size;
+    type->live++;
+    type->liveBytes += size;
+
+    SiteStats *site = currentSite();
+    site->count++;
+    site->bytes += size;
+
+    // tombstones are counted as occupied so probing always terminates
+    if ((trace.liveCount + 1) * 2 > trace.liveCapacity)
+        growLive();
+
+    LiveEntry *entry = findLive(trace.live, trace.liveCapacity, object);
+    if (entry->object == NULL)
+        trace.liveCount++;
+    entry->object = object;
+    entry->size = size;
+}
+
+void traceFree(Obj *object) {
+    if (trace.liveCapacity == 0)
+        return;
+
+    LiveEntry *entry = findLive(trace.live, trace.liveCapacity, object);
+    if (entry->object != object)
+        return;
+
+    TypeStats *type = &trace.types[object->type];
+    type->live--;
+    type->liveBytes -= entry->size;
+    entry->object = TOMBSTONE_OBJECT;
+}
+
+void traceReallocate(size_t oldSize, size_t newSize) {
+    trace.reallocCalls++;
+    if (newSize > oldSize)
+        trace.bytesGrown += newSize - oldSize;
+    else
+        trace.bytesReleased += oldSize - newSize;
+    if (vm.bytesAllocated > trace.peakBytes)
+        trace.peakBytes = vm.bytesAllocated;
+}
+
+static int compareTypes(const void *a, const void *b) {
+    const TypeStats *x = &trace.types[*(const int*)a];
+    const TypeStats *y = &trace.types[*(const int*)b];
+    if (x->bytes != y->bytes)
+        return x->bytes < y->bytes ? 1 : -1;
+    return 0;
+}
+
+static int compareSites(const void *a, const void *b) {
+    const SiteStats *x = a;
+    const SiteStats *y = b;
+    if (x->bytes != y->bytes)
+        return x->bytes < y->bytes ? 1 : -1;
+    return 0;
+}
+
+static const char* typeName(ValueType type) {
+    return decodeValueType((Value){.type=type});
+}
+
+void printAllocReport() {
+    if (!traceAllocEnabled || trace.reported)
+        return;
+    trace.reported = true;
+    fflush(stdout);
+
+    fprintf(stderr, "--- allocation report ---\n");
+    fprintf(stderr, "heap: %zu bytes live, %zu bytes peak, %zu reallocate calls (%zu bytes grown, %zu released)\n",
+        vm.bytesAllocated, trace.peakBytes, trace.reallocCalls, trace.bytesGrown, trace.bytesReleased);
+    fprintf(stderr, "immortal arena: %zu bytes\n\n", vm.immortals.bytesAllocated);
+
+    int order[TYPE_COUNT];
+    for (int i = 0; i < TYPE_COUNT; i++)
+        order[i] = i;
+    qsort(order, TYPE_COUNT, sizeof(int), compareTypes);
+
+    fprintf(stderr, "%-30s %10s %12s %10s %12s\n", "type", "count", "bytes", "live", "live bytes");
+    for (int i = 0; i < TYPE_COUNT; i++) {
+        TypeStats *type = &trace.types[order[i]];
+        if (type->count == 0)
+            break;
+        fprintf(stderr, "%-30s %10zu %12zu %10zu %12zu\n",
+            typeName(order[i]), type->count, type->bytes, type->live, type->liveBytes);
+    }
+
+    qsort(trace.sites, trace.siteCount, sizeof(SiteStats), compareSites);
+
+    fprintf(stderr, "\n%-30s %10s %12s\n", "site", "count", "bytes");
+    for (int i = 0; i < trace.siteCount && i < REPORT_SITES; i++) {
+        SiteStats *site = &trace.sites[i];
+        char location[256];
+        snprintf(location, sizeof(location), "%s:%d", site->function, site->line);
+        fprintf(stderr, "%-30s %10zu %12zu\n", location, site->count, site->bytes);
+    }
+}
+
+// The name type(x) reports for objects of the type. The class hooks of these
+// types do not look at the object; the types without one take CPython's
+// names, and instances of every class are counted together.
+static const char* snapshotName(ValueType type) {
+    switch (type) {
+        case VAL_FUNCTION:
+        case VAL_CLOSURE:       return "function";
+        case VAL_NATIVE:
+        case VAL_NATIVE_METHOD: return "builtin_function_or_method";
+        case VAL_METHOD:        return "method";
+        case VAL_UPVALUE:       return "cell";
+        case VAL_SUPER:         return "super";
+        case VAL_MODULE:        return "module";
+        case VAL_INSTANCE:      return "object";
+        default:                return getValueType((Value){.type=type});
+    }
+}
+
+Value heapSnapshot() {
+    // Types sharing a name, such as functions and closures, share an entry.
+    const char *names[TYPE_COUNT];
+    TypeStats totals[TYPE_COUNT];
+    int count = 0;
+
+    for (int i = 0; i < TYPE_COUNT; i++) {
+        TypeStats *type = &trace.types[i];
+        if (type->live == 0)
+            continue;
+
+        const char *name = snapshotName(i);
+        int j = 0;
+        while (j < count && strcmp(names[j], name) != 0)
+            j++;
+        if (j == count) {
+            names[count] = name;
+            totals[count++] = (TypeStats){0};
+        }
+        totals[j].live += type->live;
+        totals[j].liveBytes += type->liveBytes;
+    }
+
+    ObjDict *dict = allocateDict();
+    push(OBJ_VAL(dict));
+
+    for (int i = 0; i < count; i++) {
+        ObjTuple *entry = allocateTuple(2);
+        entry->values[0] = INT_VAL(totals[i].live);
+        entry->values[1] = INT_VAL(totals[i].liveBytes);
+        push(OBJ_VAL(entry));
+        Dict_SetItem(OBJ_VAL(dict), OBJ_VAL(copyString(names[i], strlen(names[i]))), OBJ_VAL(entry));
+        pop();
+    }
+
+    return pop();
+}
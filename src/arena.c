@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include "arena.h"
+
+#define ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+void initArena(Arena *arena) {
+    arena->blocks = NULL;
+    arena->bytesAllocated = 0;
+}
+
+void freeArena(Arena *arena) {
+    ArenaBlock *block = arena->blocks;
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    initArena(arena);
+}
+
+static ArenaBlock* allocateBlock(size_t capacity) {
+    ArenaBlock *block = malloc(sizeof(ArenaBlock) + capacity);
+    if (block == NULL) {
+        printf("Failed to allocate arena block\n");
+        exit(1);
+    }
+    block->size = 0;
+    block->capacity = capacity;
+    return block;
+}
+
+void* arenaAllocate(Arena *arena, size_t size) {
+    size = ALIGN(size);
+    ArenaBlock *block = arena->blocks;
+
+    if (block == NULL || block->size + size > block->capacity) {
+        if (size > ARENA_BLOCK_SIZE / 4) {
+            // oversized objects get a block of their own so the current one keeps filling up
+            ArenaBlock *large = allocateBlock(size);
+            large->size = size;
+            if (block == NULL) {
+                large->next = NULL;
+                arena->blocks = large;
+            } else {
+                large->next = block->next;
+                block->next = large;
+            }
+            arena->bytesAllocated += size;
+            return large->data;
+        }
+        block = allocateBlock(ARENA_BLOCK_SIZE);
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void *pointer = block->data + block->size;
+    block->size += size;
+    arena->bytesAllocated += size;
+    return pointer;
+}
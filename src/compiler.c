@@ -14,9 +14,12 @@
 #include "object_list.h"
 #include "error.h"
 #include "object_module.h"
+#include "numeric.h"
+#include "writer.h"
 #include "unistd.h"
 
 #define NO_ARG -1
+#define MAX_INTERNED_CONSTANT 32
 
 typedef struct Parser {
     struct Parser *enclosing;
@@ -169,6 +172,7 @@ ParseRule rules[TOKEN_COUNT] = {
     [TOKEN_STRING]        = {string,   NULL,   PREC_NONE},
     [TOKEN_RSTRING]       = {rstring,  NULL,   PREC_NONE},
     [TOKEN_FSTRING]       = {fstring,  NULL,   PREC_NONE},
+    [TOKEN_FSTRING_END]   = {fstring,  NULL,   PREC_NONE},
     [TOKEN_NUMBER]        = {number,   NULL,   PREC_NONE},
     [TOKEN_AND]           = {NULL,     and,    PREC_BOOL_AND},
     [TOKEN_OR]            = {NULL,     or,     PREC_BOOL_OR},
@@ -386,7 +390,7 @@ static void initCompiler(Compiler *compiler, FunctionType type, Token name) {
     compiler->globalCount = 0;
     current = compiler;
     if (type != TYPE_TOP_LEVEL) {
-        current->function->name = copyString(name.start, name.length);
+        current->function->name = internImmortalString(name.start, name.length);
     }
 }
 
@@ -405,7 +409,7 @@ static ObjFunction* endCompiler() {
     ObjTuple *names = allocateTuple(current->localCount);
     for (int i = 0; i < current->localCount; i++) {
         Token name = current->locals[i].name;
-        names->values[i] = STRING_VAL(copyString(name.start, name.length));
+        names->values[i] = STRING_VAL(internImmortalString(name.start, name.length));
     }
     function->localNames = names;
 
@@ -460,19 +464,39 @@ static void number(bool assign, bool tuple, bool skip, bool del) {
     if (del)
         reportError("cannot delete literal", &parser->current);
 
-    double value = strtod(parser->current.start, NULL);
-    if ((long long)value == value)
-        emitConstant(INT_VAL(value));
-    else
+    const char *chars = parser->current.start;
+    int length = parser->current.length;
+    bool isFloat = false;
+    for (int i = 0; i < length; i++)
+        if (chars[i] == '.' || chars[i] == 'e' || chars[i] == 'E')
+            isFloat = true;
+
+    // The scanner only produces valid literals, so only overflow can fail.
+    if (isFloat) {
+        double value = 0;
+        parseFloat(chars, length, &value);
         emitConstant(FLOAT_VAL(value));
+    } else {
+        long long value = 0;
+        if (parseInt(chars, length, &value) != PARSE_OK)
+            reportError("integer literal is too large", &parser->current);
+        emitConstant(INT_VAL(value));
+    }
     advance(skip);
 }
 
+static void emitString(const char *chars, int length) {
+    if (length <= MAX_INTERNED_CONSTANT && memchr(chars, '\\', length) == NULL)
+        emitConstant(STRING_VAL(internImmortalString(chars, length)));
+    else
+        emitConstant(STRING_VAL(copyEscapedString(chars, length)));
+}
+
 static void string(bool assign, bool tuple, bool skip, bool del) {
     if (del)
         reportError("cannot delete literal", &parser->current);
 
-    emitConstant(STRING_VAL(copyEscapedString(parser->current.start, parser->current.length)));
+    emitString(parser->current.start, parser->current.length);
     advance(skip);
 }
 
@@ -480,7 +504,7 @@ static void rstring(bool assign, bool tuple, bool skip, bool del) {
     if (del)
         reportError("cannot delete literal", &parser->current);
 
-    emitConstant(STRING_VAL(copyString(parser->current.start, parser->current.length)));
+    emitConstant(STRING_VAL(internImmortalString(parser->current.start, parser->current.length)));
     advance(skip);
 }
 
@@ -526,47 +550,82 @@ static void dict(bool assign, bool tuple, bool skip, bool del) {
 
     advance(true);
 
+    // '{}' is an empty dict; otherwise the first item decides between a dict
+    // and a set display.
+    bool isSet = false;
     size_t size = 0;
     do  {
         if (check(TOKEN_RIGHT_BRACE))
             break;
         expression(false, true);
-        if (!consume(TOKEN_COLON, true))
-            reportError("':' expected after dictionary key", &parser->current);
-        expression(false, true);
+        if (size == 0 && !check(TOKEN_COLON))
+            isSet = true;
+        if (!isSet) {
+            if (!consume(TOKEN_COLON, true))
+                reportError("':' expected after dictionary key", &parser->current);
+            expression(false, true);
+        }
         size++;
     } while (consume(TOKEN_COMMA, true));
 
     if (!consume(TOKEN_RIGHT_BRACE, false))
         reportError("Expect '}'", &parser->current);
 
-    emitBytes(OP_BUILD_DICT, (uint8_t)size, (Token){0});
+    emitBytes(isSet ? OP_BUILD_SET : OP_BUILD_DICT, (uint8_t)size, (Token){0});
 }
 
+// The literal parts and the fields of an f-string become one str.format
+// template, a constant whose parsed form is cached after the first run:
+// f"{x!r:>8} and {y}" formats x and y with "{!r:>8} and {}".
 static void fstring(bool assign, bool tuple, bool skip, bool del) {
     if (del)
         reportError("cannot delete literal", &parser->current);
 
+    Writer template;
+    initWriter(&template);
     int count = 0;
 
-    while (!check(TOKEN_STRING)) {
-        if (parser->current.length > 0) {
-            string(true, true, skip, false);
-            count++;
-        } else {
-            advance(skip);
-        }
+    while (true) {
+        writeChars(&template, parser->current.start, parser->current.length);
+        if (!check(TOKEN_FSTRING))
+            break;
+        advance(skip);
         expression(true, skip);
         count++;
+
+        writeChar(&template, '{');
+        if (check(TOKEN_CONVERSION)) {
+            writeChars(&template, parser->current.start, parser->current.length);
+            advance(skip);
+        }
+        if (check(TOKEN_FORMAT_SPEC)) {
+            writeChar(&template, ':');
+            writeChars(&template, parser->current.start, parser->current.length);
+            advance(skip);
+        }
+        writeChar(&template, '}');
+
+        if (!check(TOKEN_FSTRING) && !check(TOKEN_FSTRING_END)) {
+            reportError("f-string: expecting '}'", &parser->current);
+            break;
+        }
     }
+    advance(skip);
 
-    if (parser->current.length > 0) {
-        string(true, true, skip, false);
-        count++;
+    if (count == 0) {
+        // Only text: undo the doubled braces and emit a plain constant.
+        size_t length = 0;
+        for (size_t i = 0; i < template.length; i++, length++) {
+            template.chars[length] = template.chars[i];
+            if ((template.chars[i] == '{' || template.chars[i] == '}') && i + 1 < template.length && template.chars[i + 1] == template.chars[i])
+                i++;
+        }
+        emitString(template.chars, length);
     } else {
-        advance(skip);
+        emitConstant(STRING_VAL(copyEscapedString(template.chars, template.length)));
+        emitBytes(OP_BUILD_FSTRING, (uint8_t)count, (Token){0});
     }
-    emitBytes(OP_BUILD_FSTRING, (uint8_t)count, (Token){0});
+    freeWriter(&template);
 }
 
 static void grouping(bool assign, bool tuple, bool skip, bool del) {
@@ -740,7 +799,7 @@ static bool identifierEqual(Token *a, Token *b) {
 }
 
 static uint8_t identifierConstant(Token *name) {
-    return createConstant(STRING_VAL(copyString(name->start, name->length)));
+    return createConstant(STRING_VAL(internImmortalString(name->start, name->length)));
 }
 
 static void expressionStatement() {
@@ -913,6 +972,12 @@ static bool isAssignment(Token operator) {
 }
 
 static void assignment(uint8_t getOp, uint8_t setOp, int arg, Token operator) {
+    // `x += y` on a local or global may grow a string in place: the variable
+    // is read without sharing its value, see ObjString.
+    bool concat = operator.type == TOKEN_PLUS_EQUAL && (getOp == OP_GET_LOCAL || getOp == OP_GET_GLOBAL);
+    if (concat)
+        getOp = getOp == OP_GET_LOCAL ? OP_GET_LOCAL_UNSHARED : OP_GET_GLOBAL_UNSHARED;
+
     if (operator.type != TOKEN_EQUAL && operator.type != TOKEN_COLON_EQUAL)
         emitAssignment(getOp, arg, operator);
     
@@ -920,40 +985,40 @@ static void assignment(uint8_t getOp, uint8_t setOp, int arg, Token operator) {
 
     switch (operator.type) {
         case TOKEN_PLUS_EQUAL:
-            emitByte(OP_ADD, operator);
+            emitByte(concat ? OP_INPLACE_CONCAT : OP_INPLACE_ADD, operator);
             break;
         case TOKEN_MINUS_EQUAL:
-            emitByte(OP_SUBTRUCT, operator);
+            emitByte(OP_INPLACE_SUBTRUCT, operator);
             break;
         case TOKEN_STAR_EQUAL:
-            emitByte(OP_MULTIPLY, operator);
+            emitByte(OP_INPLACE_MULTIPLY, operator);
             break;
         case TOKEN_DOUBLE_STAR_EQUAL:
-            emitByte(OP_POWER, operator);
+            emitByte(OP_INPLACE_POWER, operator);
             break;
         case TOKEN_SLASH_EQUAL:
-            emitByte(OP_TRUE_DIVIDE, operator);
+            emitByte(OP_INPLACE_TRUE_DIVIDE, operator);
             break;
         case TOKEN_DOUBLE_SLASH_EQUAL:
-            emitByte(OP_FLOOR_DIVIDE, operator);
+            emitByte(OP_INPLACE_FLOOR_DIVIDE, operator);
             break;
         case TOKEN_PERCENT_EQUAL:
-            emitByte(OP_MOD, operator);
+            emitByte(OP_INPLACE_MOD, operator);
             break;
         case TOKEN_AMPERSAND_EQUAL:
-            emitByte(OP_BITWISE_AND, operator);
+            emitByte(OP_INPLACE_BITWISE_AND, operator);
             break;
         case TOKEN_CARET_EQUAL:
-            emitByte(OP_BITWISE_XOR, operator);
+            emitByte(OP_INPLACE_BITWISE_XOR, operator);
             break;
         case TOKEN_PIPE_EQUAL:
-            emitByte(OP_BITWISE_OR, operator);
+            emitByte(OP_INPLACE_BITWISE_OR, operator);
             break;
         case TOKEN_LEFT_SHIFT_EQUAL:
-            emitByte(OP_LEFT_SHIFT, operator);
+            emitByte(OP_INPLACE_LEFT_SHIFT, operator);
             break;
         case TOKEN_RIGHT_SHIFT_EQUAL:
-            emitByte(OP_RIGHT_SHIFT, operator);
+            emitByte(OP_INPLACE_RIGHT_SHIFT, operator);
             break;
         default:
             // to remove warnings
@@ -1406,7 +1471,7 @@ static void lambda(bool assign, bool tuple, bool skip, bool del) {
 
     ObjFunction *function = endCompiler();
 
-    emitBytes(OP_CLOSURE, createConstant(STRING_VAL(function)), (Token){0});
+    emitBytes(OP_CLOSURE, createConstant(OBJ_VAL(function)), (Token){0});
 
     for (int i = 0; i < function->upvalueCount; i++) {
         emitByte(compiler.upvalues[i].isLocal ? 1 : 0, (Token){0});
@@ -1576,11 +1641,19 @@ static void item(bool assign, bool tuple, bool skip, bool del) {
     }
     advance(false);
 
+    Token operator = parser->current;
+    bool isStore = isAssignment(operator) || (del && !check(TOKEN_LEFT_BRACKET));
+
+    // Reads slice straight off the stack; stores and deletes still need an
+    // ObjSlice key.
+    if (isSlice && !isStore) {
+        emitByte(OP_GET_SLICE, index);
+        return;
+    }
+
     if (isSlice)
         emitByte(OP_BUILD_SLICE, (Token){0});
 
-    Token operator = parser->current;
-
     if (isAssignment(operator)) {
         advance(true);
         if (!assign)
@@ -1684,6 +1757,18 @@ static void importStatement() {
     strncpy(filename, name.start, name.length);
     filename[name.length] = '\0';
     advance(false);
+
+    ObjModule *builtin = findBuiltinModule(filename, name.length);
+    if (builtin != NULL) {
+        emitBytes(OP_CONSTANT, createConstant(OBJ_VAL(builtin)), parser->current);
+        uint8_t getOp, setOp, arg;
+        resolveVariableAssignment(&name, &getOp, &setOp, &arg);
+        emitBytes(setOp, arg, name);
+        emitByte(OP_POP, parser->current);
+        consumeEOS();
+        return;
+    }
+
     char fullname[256];
     snprintf(fullname, sizeof(fullname), "%s%s%s%s", basePath, "/", filename, ".py");
 
@@ -1762,6 +1847,7 @@ static void statement(int breakPointer, int continuePointer) {
 ObjModule* compile(const char *source, const char *path, const char *name) {
     ObjModule *module = allocateModule(function);
     module->path = path;
+    module->source = source;
     Scanner s;
     initScanner(&s, source);
     Parser p;
@@ -1781,7 +1867,7 @@ ObjModule* compile(const char *source, const char *path, const char *name) {
     endScanner();
     function->defaultStart = 0;
     function->defaults = allocateTuple(0);
-    function->name = copyString(name, 0);
+    function->name = internImmortalString(name, strlen(name));
     module->function = function;
     return errorCount != 0 ? NULL : module;
 }
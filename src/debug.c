@@ -25,6 +25,7 @@ static const char *TokenTypeToString[] = {
     [TOKEN_COLON_EQUAL] = "COLON EQAUL",
     [TOKEN_COMMA] = "COMMA",
     [TOKEN_CONTINUE] = "CONTINUE",
+    [TOKEN_CONVERSION] = "CONVERSION",
     [TOKEN_DEDENT] = "DEDENT",
     [TOKEN_DEF] = "DEF",
     [TOKEN_DEL] = "DEL",
@@ -43,8 +44,10 @@ static const char *TokenTypeToString[] = {
     [TOKEN_FALSE] = "FALSE",
     [TOKEN_FINALLY] = "FINALLY",
     [TOKEN_FOR] = "FOR",
+    [TOKEN_FORMAT_SPEC] = "FORMAT SPEC",
     [TOKEN_FROM] = "FROM",
     [TOKEN_FSTRING] = "FSTRING",
+    [TOKEN_FSTRING_END] = "FSTRING END",
     [TOKEN_GLOBAL] = "GLOBAL",
     [TOKEN_GREATER] = "GREATER",
     [TOKEN_GREATER_EQUAL] = "GREATER EQUAL",
@@ -98,15 +101,25 @@ static const char *TokenTypeToString[] = {
 };
 
 static const char *ValueTypeToString[] = {
+    [VAL_OBJECT] = "<type object>",
     [VAL_NONE] = "<type none>",
     [VAL_BOOL] = "<type bool>",
     [VAL_INT] = "<type int>",
     [VAL_FLOAT] = "<type float>",
     [VAL_UNDEFINED] = "<type undefined>",
     [VAL_NOT_IMPLEMENTED] = "<type not implemented>",
+    [VAL_TYPE] = "<type type>",
     [VAL_STRING] = "<type string>",
+    [VAL_STRING_ITERATOR] = "<type string iterator>",
     [VAL_LIST] = "<type list>",
+    [VAL_LIST_ITERATOR] = "<type list iterator>",
     [VAL_TUPLE] = "<type tuple>",
+    [VAL_TUPLE_ITERATOR] = "<type tuple iterator>",
+    [VAL_DICT] = "<type dict>",
+    [VAL_DICT_ITERATOR] = "<type dict iterator>",
+    [VAL_SET] = "<type set>",
+    [VAL_FROZENSET] = "<type frozenset>",
+    [VAL_SET_ITERATOR] = "<type set iterator>",
     [VAL_FUNCTION] = "<type function>",
     [VAL_CLOSURE] = "<type closure>",
     [VAL_UPVALUE] = "<type upvalue>",
@@ -116,6 +129,23 @@ static const char *ValueTypeToString[] = {
     [VAL_METHOD] = "<type method>",
     [VAL_NATIVE_METHOD] = "<type native method>",
     [VAL_INSTANCE] = "<type instance>",
+    [VAL_SUPER] = "<type super>",
+    [VAL_RANGE] = "<type range>",
+    [VAL_RANGE_ITERATOR] = "<type range iterator>",
+    [VAL_SLICE] = "<type slice>",
+    [VAL_EXCEPTION] = "<type exception>",
+    [VAL_ZERO_DIVISON_ERROR] = "<type zero division error>",
+    [VAL_STOP_ITERATION] = "<type stop iteration>",
+    [VAL_NAME_ERROR] = "<type name error>",
+    [VAL_TYPE_ERROR] = "<type type error>",
+    [VAL_VALUE_ERROR] = "<type value error>",
+    [VAL_INDEX_ERROR] = "<type index error>",
+    [VAL_KEY_ERROR] = "<type key error>",
+    [VAL_ATTRIBUTE_ERROR] = "<type attribute error>",
+    [VAL_RUNTIME_ERROR] = "<type runtime error>",
+    [VAL_ASSERTION_ERROR] = "<type assertion error>",
+    [VAL_NOT_IMPLEMENTED_ERROR] = "<type not implemented error>",
+    [VAL_MEMORY_ERROR] = "<type memory error>",
     [VAL_MODULE] = "<type module>",
 };
 
@@ -204,12 +234,16 @@ int printInstruction(CodeVec *vec, int offset) {
             return simpleInstruction("TRUE", offset);
         case OP_GET_GLOBAL:
             return varInstruction("GET GLOBAL", vec, offset);
+        case OP_GET_GLOBAL_UNSHARED:
+            return varInstruction("GET GLOBAL UNSHARED", vec, offset);
         case OP_SET_GLOBAL:
             return varInstruction("SET GLOBAL", vec, offset);
         case OP_DEL_GLOBAL:
             return varInstruction("DEL GLOBAL", vec, offset);
         case OP_GET_LOCAL:
             return byteInstruction("GET LOCAL", vec, offset);
+        case OP_GET_LOCAL_UNSHARED:
+            return byteInstruction("GET LOCAL UNSHARED", vec, offset);
         case OP_SET_LOCAL:
             return byteInstruction("SET LOCAL", vec, offset);
         case OP_DEL_LOCAL:
@@ -254,6 +288,32 @@ int printInstruction(CodeVec *vec, int offset) {
             return simpleInstruction("LEFT SHIFT", offset);
         case OP_RIGHT_SHIFT:
             return simpleInstruction("RIGHT SHIFT", offset);
+        case OP_INPLACE_ADD:
+            return simpleInstruction("INPLACE ADD", offset);
+        case OP_INPLACE_SUBTRUCT:
+            return simpleInstruction("INPLACE SUBTRUCT", offset);
+        case OP_INPLACE_MULTIPLY:
+            return simpleInstruction("INPLACE MULTIPLY", offset);
+        case OP_INPLACE_POWER:
+            return simpleInstruction("INPLACE POWER", offset);
+        case OP_INPLACE_TRUE_DIVIDE:
+            return simpleInstruction("INPLACE TRUE DIVIDE", offset);
+        case OP_INPLACE_FLOOR_DIVIDE:
+            return simpleInstruction("INPLACE FLOOR DIVIDE", offset);
+        case OP_INPLACE_MOD:
+            return simpleInstruction("INPLACE MOD", offset);
+        case OP_INPLACE_BITWISE_AND:
+            return simpleInstruction("INPLACE AND", offset);
+        case OP_INPLACE_BITWISE_XOR:
+            return simpleInstruction("INPLACE XOR", offset);
+        case OP_INPLACE_BITWISE_OR:
+            return simpleInstruction("INPLACE OR", offset);
+        case OP_INPLACE_LEFT_SHIFT:
+            return simpleInstruction("INPLACE LEFT SHIFT", offset);
+        case OP_INPLACE_RIGHT_SHIFT:
+            return simpleInstruction("INPLACE RIGHT SHIFT", offset);
+        case OP_INPLACE_CONCAT:
+            return simpleInstruction("INPLACE CONCAT", offset);
         case OP_INVERT:
             return simpleInstruction("INVERT", offset);
         case OP_NOT:
@@ -288,8 +348,12 @@ int printInstruction(CodeVec *vec, int offset) {
             return argInstruction("BUILD TUPLE", vec, offset);
         case OP_BUILD_DICT:
             return argInstruction("BUILD DICT", vec, offset);
+        case OP_BUILD_SET:
+            return argInstruction("BUILD SET", vec, offset);
         case OP_BUILD_SLICE:
             return simpleInstruction("BUILD SLICE", offset);
+        case OP_GET_SLICE:
+            return simpleInstruction("GET SLICE", offset);
         case OP_JUMP:
             return jumpInstruction("JUMP", 1, vec, offset);
         case OP_JUMP_TRUE:
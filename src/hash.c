@@ -0,0 +1,112 @@
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "hash.h"
+
+// wyhash final 4 (public domain, Wang Yi), reading eight bytes at a time.
+
+static const uint64_t secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+// Already mixed with secret[0..1], as wyhash does on entry.
+static uint64_t seed;
+
+static void multiply(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t product = (__uint128_t)*a * *b;
+    *a = (uint64_t)product;
+    *b = (uint64_t)(product >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    uint64_t t = ll + (hl << 32);
+    uint64_t lo = t + (lh << 32);
+    uint64_t carry = (t < ll) + (lo < t);
+    *a = lo;
+    *b = hh + (hl >> 32) + (lh >> 32) + carry;
+#endif
+}
+
+static uint64_t mix(uint64_t a, uint64_t b) {
+    multiply(&a, &b);
+    return a ^ b;
+}
+
+static uint64_t read8(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static uint64_t read4(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint64_t read3(const uint8_t *p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+void initHashSeed() {
+    uint64_t value;
+    const char *fixed = getenv("NOVA_HASHSEED");
+    if (fixed != NULL && *fixed != '\0') {
+        value = strtoull(fixed, NULL, 10);
+    } else {
+        // No portable entropy source in C99: the clock plus a stack and a
+        // code address, which ASLR moves between runs.
+        int local;
+        value = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32);
+        value = mix(value ^ secret[2], (uint64_t)(uintptr_t)&local ^ secret[3]);
+        value = mix(value ^ secret[1], (uint64_t)(uintptr_t)&initHashSeed ^ secret[0]);
+    }
+    seed = value ^ mix(value ^ secret[0], secret[1]);
+}
+
+uint64_t hashBytes(const char *bytes, size_t length) {
+    const uint8_t *p = (const uint8_t*)bytes;
+    uint64_t state = seed;
+    uint64_t a, b;
+
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t shift = (length >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + shift);
+            b = (read4(p + length - 4) << 32) | read4(p + length - 4 - shift);
+        } else if (length > 0) {
+            a = read3(p, length);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t state1 = state, state2 = state;
+            do {
+                state = mix(read8(p) ^ secret[1], read8(p + 8) ^ state);
+                state1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ state1);
+                state2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ state2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            state ^= state1 ^ state2;
+        }
+        while (i > 16) {
+            state = mix(read8(p) ^ secret[1], read8(p + 8) ^ state);
+            p += 16;
+            i -= 16;
+        }
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+    }
+
+    a ^= secret[1];
+    b ^= state;
+    multiply(&a, &b);
+    return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
@@ -0,0 +1,169 @@
+#include "hash_set.h"
+#include "memory.h"
+#include "table.h"
+
+#define MIN_CAPACITY 8
+
+#define PERTURB_SHIFT 5
+
+#define USABLE(capacity) ((capacity) * 3 / 5)
+
+#define TOMBSTONE ((Value){.type=VAL_UNDEFINED, .as.integer=1})
+#define IS_EMPTY(entry) ((entry)->key.type == VAL_UNDEFINED && (entry)->key.as.integer == 0)
+#define IS_TOMBSTONE(entry) ((entry)->key.type == VAL_UNDEFINED && (entry)->key.as.integer == 1)
+#define IS_LIVE(entry) ((entry)->key.type != VAL_UNDEFINED)
+
+void initHashSet(HashSet *set) {
+    set->size = 0;
+    set->fill = 0;
+    set->capacity = 0;
+    set->finger = 0;
+    set->entries = NULL;
+}
+
+void freeHashSet(HashSet *set) {
+    FREE_VEC(SetEntry, set->entries, set->capacity);
+    initHashSet(set);
+}
+
+#define NEXT_SLOT(slot, perturb, mask) \
+    (((slot) * 5 + ((perturb) >>= PERTURB_SHIFT) + 1) & (mask))
+
+// Returns the entry holding key or, when it is missing, the first tombstone
+// or empty entry on its probe sequence.
+static SetEntry *findEntry(SetEntry *entries, size_t capacity, Value key, uint64_t hash) {
+    size_t mask = capacity - 1;
+    uint64_t perturb = hash;
+    size_t slot = hash & mask;
+    SetEntry *tombstone = NULL;
+
+    for (;;) {
+        SetEntry *entry = &entries[slot];
+        if (IS_EMPTY(entry))
+            return tombstone != NULL ? tombstone : entry;
+        if (IS_TOMBSTONE(entry)) {
+            if (tombstone == NULL)
+                tombstone = entry;
+        } else if (entry->hash == hash && tableKeysEqual(key, entry->key)) {
+            return entry;
+        }
+        slot = NEXT_SLOT(slot, perturb, mask);
+    }
+}
+
+static void adjustCapacity(HashSet *set, size_t capacity) {
+    SetEntry *entries = ALLOCATE(SetEntry, capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        entries[i].hash = 0;
+        entries[i].key = UNDEFINED_VAL;
+    }
+
+    for (size_t i = 0; i < set->capacity; i++) {
+        SetEntry *entry = &set->entries[i];
+        if (!IS_LIVE(entry))
+            continue;
+
+        size_t mask = capacity - 1;
+        uint64_t perturb = entry->hash;
+        size_t slot = entry->hash & mask;
+        while (!IS_EMPTY(&entries[slot]))
+            slot = NEXT_SLOT(slot, perturb, mask);
+        entries[slot] = *entry;
+    }
+
+    FREE_VEC(SetEntry, set->entries, set->capacity);
+    set->entries = entries;
+    set->capacity = capacity;
+    set->fill = set->size;
+    set->finger = 0;
+}
+
+bool hashSetContainsEntry(HashSet *set, SetEntry *entry) {
+    if (set->size == 0)
+        return false;
+    return IS_LIVE(findEntry(set->entries, set->capacity, entry->key, entry->hash));
+}
+
+bool hashSetContains(HashSet *set, Value key) {
+    if (set->size == 0)
+        return false;
+    return hashSetContainsEntry(set, &(SetEntry){tableKeyHash(key), key});
+}
+
+bool hashSetAddEntry(HashSet *set, SetEntry *entry) {
+    if (set->fill + 1 > USABLE(set->capacity)) {
+        size_t capacity = MIN_CAPACITY;
+        while (USABLE(capacity) <= set->size * 2)
+            capacity *= 2;
+        adjustCapacity(set, capacity);
+    }
+
+    SetEntry *dest = findEntry(set->entries, set->capacity, entry->key, entry->hash);
+    if (IS_LIVE(dest))
+        return false;
+
+    if (IS_EMPTY(dest))
+        set->fill++;
+    *dest = *entry;
+    set->size++;
+    return true;
+}
+
+bool hashSetAdd(HashSet *set, Value key) {
+    return hashSetAddEntry(set, &(SetEntry){tableKeyHash(key), key});
+}
+
+bool hashSetRemoveEntry(HashSet *set, SetEntry *entry) {
+    if (set->size == 0)
+        return false;
+
+    SetEntry *dest = findEntry(set->entries, set->capacity, entry->key, entry->hash);
+    if (!IS_LIVE(dest))
+        return false;
+
+    dest->key = TOMBSTONE;
+    set->size--;
+    return true;
+}
+
+bool hashSetRemove(HashSet *set, Value key) {
+    if (set->size == 0)
+        return false;
+    return hashSetRemoveEntry(set, &(SetEntry){tableKeyHash(key), key});
+}
+
+// Removes some key, scanning on from the finger so that popping every key is
+// linear overall.
+bool hashSetPop(HashSet *set, Value *key) {
+    if (set->size == 0)
+        return false;
+
+    size_t mask = set->capacity - 1;
+    size_t slot = set->finger & mask;
+    while (!IS_LIVE(&set->entries[slot]))
+        slot = (slot + 1) & mask;
+
+    *key = set->entries[slot].key;
+    set->entries[slot].key = TOMBSTONE;
+    set->size--;
+    set->finger = slot + 1;
+    return true;
+}
+
+// Returns the first live entry at or after *index and advances *index past
+// it, or NULL once the entries are exhausted.
+SetEntry *hashSetNext(HashSet *set, size_t *index) {
+    while (*index < set->capacity) {
+        SetEntry *entry = &set->entries[(*index)++];
+        if (IS_LIVE(entry))
+            return entry;
+    }
+    return NULL;
+}
+
+void markHashSet(HashSet *set) {
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(set, &index)) != NULL)
+        markValue(entry->key);
+}
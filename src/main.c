@@ -1,10 +1,12 @@
 #include <stdlib.h>
+#include <string.h>
 
 #include "common.h"
 #include "code.h"
 #include "debug.h"
 #include "scanner.h"
 #include "vm.h"
+#include "alloc_trace.h"
 
 void repl() {
 	char line[1024];
@@ -33,17 +35,59 @@ void runFile(const char *path) {
 	}
 }
 
+static void usage() {
+	fprintf(stderr, "Usage: nova [--trace-alloc] [--max-heap SIZE] [path]\n");
+	exit(64);
+}
+
+// Parses a byte count with an optional K, M or G suffix; returns 0 when invalid.
+static size_t parseSize(const char *text) {
+	char *end;
+	unsigned long long size = strtoull(text, &end, 10);
+	if (end == text)
+		return 0;
+
+	switch (*end) {
+		case 'k': case 'K': size <<= 10; end++; break;
+		case 'm': case 'M': size <<= 20; end++; break;
+		case 'g': case 'G': size <<= 30; end++; break;
+	}
+	if (*end == 'b' || *end == 'B')
+		end++;
+	return *end == '\0' ? (size_t)size : 0;
+}
+
 int main(int argc, const char *argv[]) {
-	initVM(argv[1]);
+	const char *path = NULL;
+	const char *maxHeap = getenv("NOVA_MAX_HEAP");
 
-	if (argc == 1) {
-		repl();
-	} else if (argc == 2) {
-		runFile(argv[1]);
-	} else {
-		fprintf(stderr, "Usage: nova [path]\n");
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--trace-alloc") == 0)
+			initAllocTrace();
+		else if (strcmp(argv[i], "--max-heap") == 0 && i + 1 < argc)
+			maxHeap = argv[++i];
+		else if (strncmp(argv[i], "--max-heap=", 11) == 0)
+			maxHeap = argv[i] + 11;
+		else if (argv[i][0] == '-' || path != NULL)
+			usage();
+		else
+			path = argv[i];
+	}
+
+	size_t heapLimit = 0;
+	if (maxHeap != NULL && (heapLimit = parseSize(maxHeap)) == 0) {
+		fprintf(stderr, "Invalid heap size '%s'\n", maxHeap);
+		usage();
 	}
 
+	initVM(path);
+	setHeapLimit(heapLimit);
+
+	if (path == NULL)
+		repl();
+	else
+		runFile(path);
+
 	freeVM();
 	return 0;
 }
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <time.h>
 
 #include "memory.h"
 #include "common.h"
@@ -6,10 +7,25 @@
 #include "object_string.h"
 #include "object_class.h"
 #include "object_instance.h"
+#include "object_list.h"
+#include "object_list_iterator.h"
+#include "object_tuple.h"
+#include "object_tuple_iterator.h"
+#include "object_dict.h"
+#include "object_dict_iterator.h"
+#include "object_set.h"
+#include "object_set_iterator.h"
+#include "object_string_iterator.h"
+#include "object_range.h"
+#include "object_range_iterator.h"
+#include "object_slice.h"
+#include "object_super.h"
+#include "object_exception.h"
+#include "object_module.h"
 #include "name_table.h"
+#include "string_format.h"
 #include "vm.h"
-
-#define GC_HEAP_GROW_FACTOR 2
+#include "alloc_trace.h"
 
 int indent = 0;
 
@@ -22,18 +38,33 @@ static void printIndent() {
 
 #ifdef DEBUG_LOG_GC
     #include "debug.h"
+    #include "value_methods.h"
 #endif
 
+void initGarbageCollector(GarbageCollector *gc) {
+    gc->enabled = true;
+    gc->debug = 0;
+    gc->heapLimit = 0;
+    gc->heapCeiling = 0;
+    gc->heapLimitExceeded = false;
+    gc->threshold = GC_DEFAULT_THRESHOLD;
+    gc->growFactor = GC_DEFAULT_GROW_FACTOR;
+    gc->collections = 0;
+    gc->objectsFreed = 0;
+    gc->bytesFreed = 0;
+    gc->totalPause = 0;
+    gc->maxPause = 0;
+}
+
+// Collections are not triggered from here: C code holds unrooted temporaries
+// between allocations, so the VM only collects at instruction boundaries.
+// Going over the heap limit is likewise only recorded and handled there.
 void* reallocate(void *pointer, size_t oldSize, size_t newSize) {
     vm.bytesAllocated += newSize - oldSize;
-    if (newSize > oldSize) {
-        #ifdef DEBUG_STRESS_GC
-            collectGarbage();
-        #endif
-    }
-    if (vm.bytesAllocated > vm.nextGC) {
-        collectGarbage();
-    }
+    if (traceAllocEnabled)
+        traceReallocate(oldSize, newSize);
+    if (vm.gc.heapLimit != 0 && newSize > oldSize && vm.bytesAllocated > vm.gc.heapCeiling)
+        vm.gc.heapLimitExceeded = true;
 
     if (newSize == 0) {
         free(pointer);
@@ -42,19 +73,83 @@ void* reallocate(void *pointer, size_t oldSize, size_t newSize) {
 
     void *newPointer = realloc(pointer, newSize);
     if (newPointer == NULL) {
-        printf("Failed to reallocate %p\n", pointer);
+        fprintf(stderr, "MemoryError: failed to allocate %zu bytes\n", newSize);
         exit(1);
     }
     return newPointer;
 }
 
+void setHeapLimit(size_t limit) {
+    vm.gc.heapLimit = limit;
+    vm.gc.heapCeiling = limit;
+}
+
+bool exceedsHeapLimit(size_t size) {
+    return vm.gc.heapLimit != 0 && size > vm.gc.heapLimit;
+}
+
+// Lets the program allocate a little past the limit so that the handler of
+// the MemoryError being raised can run. A single large allocation may already
+// have overshot the limit, so the reserve is measured from the current heap
+// size. It closes once a collection brings the heap a reserve's worth under
+// the limit; closing it as soon as the heap dips under the limit would raise
+// again before the handler could release anything.
+void enterHeapReserve() {
+    vm.gc.heapCeiling = vm.bytesAllocated + vm.gc.heapLimit / HEAP_LIMIT_RESERVE_RATIO;
+}
+
 static void freeObject(Obj *object) {
     #ifdef DEBUG_LOG_GC
-        printf("free %p, type %s, data ", object, decodeObjType(OBJ_VAL(object)));
-        printObject(OBJ_VAL(object));
-        printf("\n");
+        printf("free %p, type %s\n", object, decodeValueType(OBJ_VAL(object)));
     #endif
+    if (traceAllocEnabled)
+        traceFree(object);
+    vm.objectCount--;
     switch (object->type) {
+        case VAL_STRING: {
+            ObjString *string = (ObjString*)object;
+            freeStringIndex(string);
+            freeStringFormat(string);
+            reallocate(object, sizeof(ObjString) + string->capacity + 1, 0);
+            break;
+        }
+        case VAL_STRING_ITERATOR:
+            FREE(ObjStringIterator, object);
+            break;
+        case VAL_LIST: {
+            ObjList *list = (ObjList*)object;
+            freeListItems(list);
+            FREE(ObjList, object);
+            break;
+        }
+        case VAL_LIST_ITERATOR:
+            FREE(ObjListIterator, object);
+            break;
+        case VAL_TUPLE: {
+            ObjTuple *tuple = (ObjTuple*)object;
+            reallocate(object, sizeof(ObjTuple) + tuple->size * sizeof(Value), 0);
+            break;
+        }
+        case VAL_TUPLE_ITERATOR:
+            FREE(ObjTupleIterator, object);
+            break;
+        case VAL_DICT: {
+            ObjDict *dict = (ObjDict*)object;
+            tableFree(&dict->table);
+            FREE(ObjDict, object);
+            break;
+        }
+        case VAL_DICT_ITERATOR:
+            FREE(ObjDictIterator, object);
+            break;
+        case VAL_SET:
+        case VAL_FROZENSET:
+            freeHashSet(&((ObjSet*)object)->set);
+            FREE(ObjSet, object);
+            break;
+        case VAL_SET_ITERATOR:
+            FREE(ObjSetIterator, object);
+            break;
         case VAL_CLOSURE: {
             ObjClosure *closure = (ObjClosure*)object;
             FREE_VEC(ObjUpvalue*, closure->upvalues, closure->upvalueCount);
@@ -70,29 +165,65 @@ static void freeObject(Obj *object) {
         case VAL_NATIVE:
             FREE(ObjNative, object);
             break;
-        case VAL_STRING: {
-            ObjString *string = (ObjString*)object;
-            FREE(ObjString, object);
-            break;
-        }
-        case VAL_UPVALUE: {
+        case VAL_UPVALUE:
             FREE(ObjUpvalue, object);
             break;
-        }
         case VAL_CLASS: {
+            ObjClass *class = (ObjClass*)object;
+            freeNameTable(&class->methods);
             FREE(ObjClass, object);
             break;
         }
+        case VAL_NATIVE_CLASS:
+            FREE(ObjNativeClass, object);
+            break;
+        case VAL_METHOD:
+            FREE(ObjMethod, object);
+            break;
+        case VAL_NATIVE_METHOD:
+            FREE(ObjNativeMethod, object);
+            break;
         case VAL_INSTANCE: {
             ObjInstance *instance = (ObjInstance*)object;
             freeNameTable(&instance->attributes);
             FREE(ObjInstance, object);
             break;
         }
-        case VAL_METHOD: {
-            FREE(ObjMethod, object);
+        case VAL_SUPER:
+            FREE(ObjSuper, object);
+            break;
+        case VAL_RANGE:
+            FREE(ObjRange, object);
+            break;
+        case VAL_RANGE_ITERATOR:
+            FREE(ObjRangeIterator, object);
+            break;
+        case VAL_SLICE:
+            FREE(ObjSlice, object);
+            break;
+        case VAL_EXCEPTION:
+        case VAL_ZERO_DIVISON_ERROR:
+        case VAL_STOP_ITERATION:
+        case VAL_NAME_ERROR:
+        case VAL_TYPE_ERROR:
+        case VAL_VALUE_ERROR:
+        case VAL_INDEX_ERROR:
+        case VAL_KEY_ERROR:
+        case VAL_ATTRIBUTE_ERROR:
+        case VAL_RUNTIME_ERROR:
+        case VAL_ASSERTION_ERROR:
+        case VAL_NOT_IMPLEMENTED_ERROR:
+        case VAL_MEMORY_ERROR:
+            FREE(ObjException, object);
+            break;
+        case VAL_MODULE: {
+            ObjModule *module = (ObjModule*)object;
+            tableFree(&module->globals);
+            FREE(ObjModule, object);
             break;
         }
+        default:
+            break;
     } 
 }
 
@@ -103,6 +234,7 @@ void freeObjects() {
         freeObject(object);
         object = next;
     }
+    vm.objects = NULL;
 }
 
 static void markVec(ValueVec *vec) {
@@ -113,6 +245,43 @@ static void markVec(ValueVec *vec) {
 
 static void markReferences(Obj *obj) {
     switch (obj->type) {
+        case VAL_STRING_ITERATOR:
+            markValue(((ObjStringIterator*)obj)->iterable);
+            break;
+        case VAL_LIST: {
+            // Unboxed int and float items hold no references.
+            ObjList *list = (ObjList*)obj;
+            if (list->strategy == LIST_OBJECTS) {
+                for (int i = 0; i < list->size; i++)
+                    markValue(list->items.values[i]);
+            }
+            break;
+        }
+        case VAL_LIST_ITERATOR:
+            markValue(((ObjListIterator*)obj)->iterable);
+            break;
+        case VAL_TUPLE: {
+            ObjTuple *tuple = (ObjTuple*)obj;
+            for (size_t i = 0; i < tuple->size; i++)
+                markValue(tuple->values[i]);
+            break;
+        }
+        case VAL_TUPLE_ITERATOR:
+            markValue(((ObjTupleIterator*)obj)->iterable);
+            break;
+        case VAL_DICT:
+            markTable(&((ObjDict*)obj)->table);
+            break;
+        case VAL_DICT_ITERATOR:
+            markValue(((ObjDictIterator*)obj)->iterable);
+            break;
+        case VAL_SET:
+        case VAL_FROZENSET:
+            markHashSet(&((ObjSet*)obj)->set);
+            break;
+        case VAL_SET_ITERATOR:
+            markValue(((ObjSetIterator*)obj)->iterable);
+            break;
         case VAL_UPVALUE:
             markValue(((ObjUpvalue*)obj)->closed);
             break;
@@ -134,6 +303,9 @@ static void markReferences(Obj *obj) {
             #ifdef DEBUG_LOG_GC
                 indent--;
             #endif
+            markObject((Obj*)function->defaults);
+            markObject((Obj*)function->localNames);
+            markObject((Obj*)function->module);
             break;
         }
         case VAL_CLOSURE: {
@@ -161,12 +333,14 @@ static void markReferences(Obj *obj) {
         case VAL_CLASS: {
             ObjClass *class = (ObjClass*)obj;
             markObject((Obj*)class->name);
+            markNameTable(&class->methods);
+            markValue(class->super);
             break;
         }
         case VAL_INSTANCE: {
             ObjInstance *instance = (ObjInstance*)obj;
             markObject((Obj*)instance->class);
-            // markTable(&instance->attributes);
+            markNameTable(&instance->attributes);
             break;
         }
         case VAL_METHOD: {
@@ -175,19 +349,58 @@ static void markReferences(Obj *obj) {
             markObject((Obj*)method->method);
             break;
         }
+        case VAL_NATIVE_METHOD:
+            markValue(((ObjNativeMethod*)obj)->reciever);
+            break;
+        case VAL_SUPER: {
+            ObjSuper *super = (ObjSuper*)obj;
+            markValue(super->self);
+            markValue(super->class);
+            break;
+        }
+        case VAL_SLICE: {
+            ObjSlice *slice = (ObjSlice*)obj;
+            markValue(slice->start);
+            markValue(slice->stop);
+            markValue(slice->step);
+            break;
+        }
+        case VAL_EXCEPTION:
+        case VAL_ZERO_DIVISON_ERROR:
+        case VAL_STOP_ITERATION:
+        case VAL_NAME_ERROR:
+        case VAL_TYPE_ERROR:
+        case VAL_VALUE_ERROR:
+        case VAL_INDEX_ERROR:
+        case VAL_KEY_ERROR:
+        case VAL_ATTRIBUTE_ERROR:
+        case VAL_RUNTIME_ERROR:
+        case VAL_ASSERTION_ERROR:
+        case VAL_NOT_IMPLEMENTED_ERROR:
+        case VAL_MEMORY_ERROR:
+            markValue(((ObjException*)obj)->value);
+            break;
+        case VAL_MODULE: {
+            ObjModule *module = (ObjModule*)obj;
+            markTable(&module->globals);
+            markObject((Obj*)module->function);
+            break;
+        }
+        default:
+            break;
     }
 }
 
 void markObject(Obj *obj) {
-    if (obj == NULL)
+    if (obj == NULL || obj->isImmortal)
         return;
     if (obj->isMarked)
         return;
 
     #ifdef DEBUG_LOG_GC
         printIndent();
-        printf("mark %p, %s, data ", obj, decodeObjType(OBJ_VAL(obj)));
-        printValue(OBJ_VAL(obj));
+        printf("mark %p, %s, data ", obj, decodeValueType(OBJ_VAL(obj)));
+        valuePrint(OBJ_VAL(obj));
         printf("\n");
     #endif
 
@@ -239,7 +452,8 @@ static void mark() {
         printf("\033[34mmark globals\n");
         indent--;
     #endif
-    // markTable(&vm.globals);
+    markTable(&vm.builtin);
+    markTable(&vm.modules);
 
     #ifdef DEBUG_LOG_GC
         indent--;
@@ -247,13 +461,12 @@ static void mark() {
         indent++;
     #endif
     markCompilerRoots();
+    markFormatTemplates();
 
     #ifdef DEBUG_LOG_GC
         indent--;
         printf("\033[0m");
     #endif
-
-    markObject((Obj*)vm.magicStrings.init);
 }
 
 static void sweep() {
@@ -277,21 +490,48 @@ static void sweep() {
     }
 }
 
-void collectGarbage() {
-    return;
+size_t collectGarbage() {
+    size_t before = vm.bytesAllocated;
+    size_t objectsBefore = vm.objectCount;
+    clock_t start = clock();
+
     #ifdef DEBUG_LOG_GC
         printf("gc begin\n");
-        size_t before = vm.bytesAllocated;
     #endif
 
     mark();
 
+    nameTableRemoveWhite(&vm.strings);
+
     sweep();
 
-    vm.nextGC = vm.bytesAllocated * GC_HEAP_GROW_FACTOR;
+    size_t nextGC = vm.bytesAllocated * vm.gc.growFactor;
+    vm.nextGC = nextGC > vm.gc.threshold ? nextGC : vm.gc.threshold;
+    if (vm.gc.heapLimit != 0) {
+        if (vm.bytesAllocated <= vm.gc.heapLimit - vm.gc.heapLimit / HEAP_LIMIT_RESERVE_RATIO)
+            vm.gc.heapCeiling = vm.gc.heapLimit;
+        if (vm.nextGC > vm.gc.heapCeiling)
+            vm.nextGC = vm.gc.heapCeiling;
+    }
+
+    double pause = (double)(clock() - start) / CLOCKS_PER_SEC;
+    size_t objectsFreed = objectsBefore - vm.objectCount;
+    vm.gc.collections++;
+    vm.gc.objectsFreed += objectsFreed;
+    vm.gc.bytesFreed += before - vm.bytesAllocated;
+    vm.gc.totalPause += pause;
+    if (pause > vm.gc.maxPause)
+        vm.gc.maxPause = pause;
 
     #ifdef DEBUG_LOG_GC
         printf("gc end\n");
-        printf("collected %zu bytes (from %zu to %zu) next at %zu", before - vm.bytesAllocated, before, vm.bytesAllocated, vm.nextGC);
+        printf("collected %zu bytes (from %zu to %zu) next at %zu\n", before - vm.bytesAllocated, before, vm.bytesAllocated, vm.nextGC);
     #endif
-}
\ No newline at end of file
+
+    if (vm.gc.debug & GC_DEBUG_STATS) {
+        fprintf(stderr, "gc: collection %zu freed %zu objects, %zu bytes in %.3f ms, heap %zu -> %zu bytes, next at %zu\n",
+            vm.gc.collections, objectsFreed, before - vm.bytesAllocated, pause * 1000, before, vm.bytesAllocated, vm.nextGC);
+    }
+
+    return objectsFreed;
+}
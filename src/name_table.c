@@ -2,144 +2,285 @@
 #include <string.h>
 #include <stdint.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "name_table.h"
 #include "memory.h"
 #include "value_methods.h"
 #include "value_int.h"
 #include "object_string.h"
 
-#define TABLE_MAX_LOAD 0.75
+#define GROUP_WIDTH NAME_TABLE_GROUP_WIDTH
+
+#define CTRL_EMPTY   ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+
+// Load factor of 7/8: Swiss tables stay fast when nearly full.
+#define MAX_LOAD(capacity) ((capacity) - (capacity) / 8)
 
 void initNameTable(NameTable *table) {
     table->size = 0;
+    table->tombstones = 0;
     table->capacity = 0;
+    table->control = NULL;
     table->entries = NULL;
 }
 
 void freeNameTable(NameTable *table) {
+    FREE_VEC(int8_t, table->control, table->capacity);
     FREE_VEC(NameEntry, table->entries, table->capacity);
     initNameTable(table);
 }
 
-static NameEntry* findEntry(NameEntry *entries, int capacity, ObjString *key) {
-    uint32_t index = String_Hash(STRING_VAL(key)) % capacity; 
-    NameEntry *tombstone = NULL;
+// String hashes are weak in the low bits, so spread them before splitting
+// into H1 (group position) and H2 (the 7-bit control tag).
+static uint64_t mixHash(uint64_t hash) {
+    return hash * 0x9E3779B97F4A7C15ull;
+}
+
+#define H1(hash) ((hash) >> 7)
+#define H2(hash) ((int8_t)((hash) >> 57))
+
+typedef uint32_t BitMask;
+
+#ifdef __SSE2__
+
+static BitMask matchTag(const int8_t *group, int8_t tag) {
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag)));
+}
+
+static BitMask matchEmpty(const int8_t *group) {
+    return matchTag(group, CTRL_EMPTY);
+}
+
+// Empty and deleted tags are the only ones with the sign bit set.
+static BitMask matchFree(const int8_t *group) {
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+}
+
+#else
+
+static BitMask matchTag(const int8_t *group, int8_t tag) {
+    BitMask mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++)
+        if (group[i] == tag)
+            mask |= 1u << i;
+    return mask;
+}
+
+static BitMask matchEmpty(const int8_t *group) {
+    return matchTag(group, CTRL_EMPTY);
+}
+
+static BitMask matchFree(const int8_t *group) {
+    BitMask mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++)
+        if (group[i] < 0)
+            mask |= 1u << i;
+    return mask;
+}
+
+#endif
+
+#define LOWEST_BIT(mask) __builtin_ctz(mask)
+
+// Groups are probed triangularly, which visits every group when the number
+// of groups is a power of two.
+typedef struct {
+    size_t group;
+    size_t stride;
+    size_t mask;
+} ProbeSequence;
+
+static ProbeSequence startProbe(NameTable *table, uint64_t hash) {
+    size_t mask = table->capacity / GROUP_WIDTH - 1;
+    return (ProbeSequence){.group = H1(hash) & mask, .stride = 0, .mask = mask};
+}
+
+static void nextProbe(ProbeSequence *seq) {
+    seq->stride++;
+    seq->group = (seq->group + seq->stride) & seq->mask;
+}
+
+static bool keysEqual(ObjString *a, ObjString *b) {
+    if (a == b)
+        return true;
+    if (a->isInterned && b->isInterned)
+        return false;
+    return a->hash == b->hash && a->length == b->length && memcmp(a->chars, b->chars, a->length) == 0;
+}
+
+static NameEntry *findEntry(NameTable *table, ObjString *key, uint64_t hash) {
+    if (table->size == 0)
+        return NULL;
+
+    ProbeSequence seq = startProbe(table, hash);
+    int8_t tag = H2(hash);
 
     while (true) {
-        NameEntry *entry = &entries[index];
-        if (entry->key == NULL) {
-            if (IS_NONE(entry->value)) {
-                return tombstone != NULL ? tombstone : entry;
-            } else {
-                if (tombstone == NULL)
-                    tombstone = entry;
-            }
-        } else if (valueToBool(String_Equal(STRING_VAL(key), STRING_VAL(entry->key)))) {
-            return entry;
+        size_t base = seq.group * GROUP_WIDTH;
+        const int8_t *group = &table->control[base];
+
+        for (BitMask match = matchTag(group, tag); match != 0; match &= match - 1) {
+            NameEntry *entry = &table->entries[base + LOWEST_BIT(match)];
+            if (keysEqual(key, entry->key))
+                return entry;
         }
-        
-        index = (index + 1) % capacity;
+        if (matchEmpty(group) != 0)
+            return NULL;
+        nextProbe(&seq);
     }
 }
 
-static void adjustCapacity(NameTable *table, int capacity) {
-    NameEntry *entries = ALLOCATE(NameEntry, capacity);
-    for (int i = 0; i < capacity; i++) {
-        entries[i].key = NULL;
-        entries[i].value = NONE_VAL;
+// First empty or deleted slot on the probe sequence of hash.
+static size_t findFreeSlot(NameTable *table, uint64_t hash) {
+    ProbeSequence seq = startProbe(table, hash);
+
+    while (true) {
+        size_t base = seq.group * GROUP_WIDTH;
+        BitMask free = matchFree(&table->control[base]);
+        if (free != 0)
+            return base + LOWEST_BIT(free);
+        nextProbe(&seq);
     }
+}
+
+static void insertNew(NameTable *table, ObjString *key, uint64_t hash, Value value) {
+    size_t slot = findFreeSlot(table, hash);
+    if (table->control[slot] == CTRL_DELETED)
+        table->tombstones--;
+
+    table->control[slot] = H2(hash);
+    table->entries[slot].key = key;
+    table->entries[slot].value = value;
+    table->size++;
+}
+
+// Rehashes into a table of the given capacity, dropping all tombstones.
+static void adjustCapacity(NameTable *table, int capacity) {
+    NameTable resized;
+    initNameTable(&resized);
+    resized.capacity = capacity;
+    resized.control = ALLOCATE(int8_t, capacity);
+    resized.entries = ALLOCATE(NameEntry, capacity);
+    memset(resized.control, CTRL_EMPTY, capacity);
 
-    table->size = 0; 
     for (int i = 0; i < table->capacity; i++) {
-        NameEntry *entry = &table->entries[i];
-        if (entry->key == NULL)
+        if (table->control[i] < 0)
             continue;
-
-        NameEntry *dest = findEntry(entries, capacity, entry->key);
-        dest->key = entry->key;
-        dest->value = entry->value;
-        table->size++;
+        NameEntry *entry = &table->entries[i];
+        insertNew(&resized, entry->key, mixHash(entry->key->hash), entry->value);
     }
 
-    FREE_VEC(NameEntry, table->entries, table->capacity);
-    table->entries = entries;
-    table->capacity = capacity;
+    freeNameTable(table);
+    *table = resized;
+}
+
+// Makes room for one more key. When tombstones are what fills the table,
+// rehashing at the same capacity is enough to reclaim them.
+static void reserveSlot(NameTable *table) {
+    if (table->size + table->tombstones + 1 <= MAX_LOAD(table->capacity))
+        return;
+
+    if (table->capacity != 0 && table->size + 1 <= MAX_LOAD(table->capacity) / 2)
+        adjustCapacity(table, table->capacity);
+    else
+        adjustCapacity(table, table->capacity == 0 ? GROUP_WIDTH : table->capacity * 2);
 }
 
 bool nameTableSet(NameTable *table, ObjString *key, Value value) {
-    if (table->size + 1 > table->capacity * TABLE_MAX_LOAD) {
-        int capacity = GROW_CAPACITY(table->capacity);
-        adjustCapacity(table, capacity);
-    }
+    uint64_t hash = mixHash(String_Hash(STRING_VAL(key)));
 
-    NameEntry *entry = findEntry(table->entries, table->capacity, key);
-    bool isNewKey = entry->key == NULL;
-    if (isNewKey && IS_NONE(entry->value))
-        table->size++;
+    NameEntry *entry = findEntry(table, key, hash);
+    if (entry != NULL) {
+        entry->value = value;
+        return false;
+    }
 
-    entry->key = key;
-    entry->value = value;
-    return isNewKey;
+    reserveSlot(table);
+    insertNew(table, key, hash, value);
+    return true;
 }
 
 bool nameTableGet(NameTable *table, ObjString *key, Value *value) {
-    if (table->size == 0)
-        return false;
-    
-    NameEntry *entry = findEntry(table->entries, table->capacity, key);
-    if (entry->key == NULL)
+    NameEntry *entry = findEntry(table, key, mixHash(String_Hash(STRING_VAL(key))));
+    if (entry == NULL)
         return false;
-    
+
     *value = entry->value;
     return true;
 }
 
 bool nameTableDelete(NameTable *table, ObjString *key) {
-    if (table->size == 0)
+    NameEntry *entry = findEntry(table, key, mixHash(String_Hash(STRING_VAL(key))));
+    if (entry == NULL)
         return false;
 
-    NameEntry *entry = findEntry(table->entries, table->capacity, key);
-    if (entry->key == NULL) 
-        return false;
-    
+    // A probe only moves past a group that has no empty slot, so a slot in a
+    // group that still has one can go straight back to empty.
+    size_t slot = entry - table->entries;
+    const int8_t *group = &table->control[slot - slot % GROUP_WIDTH];
+    if (matchEmpty(group) != 0) {
+        table->control[slot] = CTRL_EMPTY;
+    } else {
+        table->control[slot] = CTRL_DELETED;
+        table->tombstones++;
+    }
+
     entry->key = NULL;
-    entry->value = BOOL_VAL(true);
+    entry->value = NONE_VAL;
+    table->size--;
     return true;
 }
 
 void nameTableAddAll(NameTable *source, NameTable *destination) {
     for (int i = 0; i < source->capacity; i++) {
-        NameEntry *entry = &source->entries[i];
-        if (entry->key != NULL)
-            nameTableSet(destination, entry->key, entry->value);
+        if (source->control[i] >= 0)
+            nameTableSet(destination, source->entries[i].key, source->entries[i].value);
     }
 }
 
-// ObjString* tableFindString(NameTable *table, const char *chars, int length, uint32_t hash) {
-//     if (table->size == 0)
-//         return NULL;
+ObjString* nameTableFindString(NameTable *table, const char *chars, int length, uint64_t hash) {
+    if (table->size == 0)
+        return NULL;
+
+    uint64_t mixed = mixHash(hash);
+    ProbeSequence seq = startProbe(table, mixed);
+    int8_t tag = H2(mixed);
 
-//     uint32_t index = hash % table->capacity;
+    while (true) {
+        size_t base = seq.group * GROUP_WIDTH;
+        const int8_t *group = &table->control[base];
 
-//     while (true) {
-//         NameEntry *entry = &table->entries[index];
-//         if (entry->key == NULL) {
-//             if (IS_NIL(entry->value))
-//                 return NULL;
-//         } else if (entry->key->length == length &&
-//                    entry->key->hash == hash &&
-//                    memcmp(entry->key->chars, chars, length) == 0) {
-//             return entry->key;
-//         }
+        for (BitMask match = matchTag(group, tag); match != 0; match &= match - 1) {
+            ObjString *key = table->entries[base + LOWEST_BIT(match)].key;
+            if (key->hash == hash && key->length == length && memcmp(key->chars, chars, length) == 0)
+                return key;
+        }
+        if (matchEmpty(group) != 0)
+            return NULL;
+        nextProbe(&seq);
+    }
+}
 
-//         index = (index + 1) % table->capacity;
-//     }
-// }
+void nameTableRemoveWhite(NameTable *table) {
+    for (int i = 0; i < table->capacity; i++) {
+        if (table->control[i] < 0)
+            continue;
+        ObjString *key = table->entries[i].key;
+        if (!key->obj.isMarked && !key->obj.isImmortal)
+            nameTableDelete(table, key);
+    }
+}
 
 void markNameTable(NameTable *table) {
     for (int i = 0; i < table->capacity; i++) {
-        NameEntry *entry = &table->entries[i];
-        markObject((Obj*)entry->key);
-        markValue(entry->value);
+        if (table->control[i] < 0)
+            continue;
+        markObject((Obj*)table->entries[i].key);
+        markValue(table->entries[i].value);
     }
-}
\ No newline at end of file
+}
@@ -10,34 +10,93 @@
 #include "value_methods.h"
 #include "object.h"
 #include "object_string.h"
+#include "object_list.h"
+#include "object_tuple.h"
+#include "object_exception.h"
+#include "alloc_trace.h"
 #include "vm.h"
 
-Value Py_Print(int argc, int kwargc) {
-    static char *keywords[] = {"*objects", "sep", "end"};
-    Value objects, sep, end;
-    PARSE_ARGS(&objects, &sep, &end);
-
-    char *s;
-    if (IS_UNDEFINED(sep))
-        s = " ";
-    else
-        s = AS_STRING(sep)->chars;
-    
-    char *e;
-    if (IS_UNDEFINED(end))
-        e = "\n";
-    else
-        e = AS_STRING(end)->chars;
+static Value printSeparator(Value value, const char *name, ObjString **result) {
+    if (IS_UNDEFINED(value) || IS_NONE(value)) {
+        *result = NULL;
+        return NONE_VAL;
+    }
+    if (!IS_STRING(value))
+        return createException(VAL_TYPE_ERROR, "%s must be None or a string, not %s", name, getValueType(value));
+    *result = AS_STRING(value);
+    return NONE_VAL;
+}
 
-    int size = AS_TUPLE(objects)->size;
+static Value callFileMethod(Value file, const char *name, int argc, Value arg) {
+    Value method = valueGetAttribute(file, internImmortalString(name, strlen(name)));
+    if (isInstance(method, TYPE_CLASS(exception)))
+        return method;
+    push(method);
+    if (argc == 1)
+        push(arg);
+    return callNovaValue(method, argc);
+}
 
-    for (int i = 0; i < size; i++) {
-        valuePrint(AS_TUPLE(objects)->values[i]);
-        if (i + 1 != size)
-            printf("%s", s);
+// Output to stdout is appended to vm.output and only flushed when it fills,
+// when asked to, or at a newline when stdout is a terminal. Any other file
+// receives the whole line through a single write() call.
+Value Py_Print(int argc, int kwargc) {
+    static char *keywords[] = {"*objects", "sep", "end", "file", "flush"};
+    Value objects, sep, end, file, flush;
+    PARSE_ARGS(&objects, &sep, &end, &file, &flush);
+
+    ObjString *sepString, *endString;
+    Value error = printSeparator(sep, "sep", &sepString);
+    if (!IS_NONE(error))
+        return error;
+    error = printSeparator(end, "end", &endString);
+    if (!IS_NONE(error))
+        return error;
+
+    bool toStdout = IS_UNDEFINED(file) || IS_NONE(file);
+    Writer local;
+    Writer *writer = &vm.output;
+    if (!toStdout) {
+        writer = &local;
+        initWriter(writer);
+    }
+    size_t start = writer->length;
+
+    size_t count = IS_TUPLE(objects) ? AS_TUPLE(objects)->size : 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i != 0) {
+            if (sepString == NULL)
+                writeChar(writer, ' ');
+            else
+                writeChars(writer, sepString->chars, sepString->length);
+        }
+        valueWrite(AS_TUPLE(objects)->values[i], writer);
+    }
+    if (endString == NULL)
+        writeChar(writer, '\n');
+    else
+        writeChars(writer, endString->chars, endString->length);
+
+    bool shouldFlush = !IS_UNDEFINED(flush) && valueToBool(flush);
+
+    if (!toStdout) {
+        Value line = STRING_VAL(writerToString(writer));
+        push(line);
+        Value result = callFileMethod(file, "write", 1, line);
+        pop();
+        if (isInstance(result, TYPE_CLASS(exception)))
+            return result;
+        if (shouldFlush) {
+            result = callFileMethod(file, "flush", 0, NONE_VAL);
+            if (isInstance(result, TYPE_CLASS(exception)))
+                return result;
+        }
+        return NONE_VAL;
     }
 
-    printf("%s", e);
+    if (shouldFlush || vm.output.length >= OUTPUT_BUFFER_SIZE ||
+        (vm.outputIsTTY && memchr(vm.output.chars + start, '\n', vm.output.length - start) != NULL))
+        flushOutput();
     return NONE_VAL;
 }
 
@@ -57,12 +116,67 @@ Value Py_Len(int argc, int kwargc) {
     return INT_VAL(valueLen(obj));
 }
 
+Value Py_Sum(int argc, int kwargc) {
+    static char *keywords[] = {"iterable", "start"};
+    Value iterable, start;
+    PARSE_ARGS(&iterable, &start);
+
+    if (IS_UNDEFINED(start))
+        start = INT_VAL(0);
+
+    if (IS_LIST(iterable))
+        return List_Sum(iterable, start);
+
+    Value iterator = valueIter(iterable);
+    if (isInstance(iterator, TYPE_CLASS(exception)))
+        return iterator;
+
+    Value total = start;
+    while (true) {
+        Value item = valueNext(iterator);
+        if (item.type == VAL_STOP_ITERATION)
+            break;
+        if (isInstance(item, TYPE_CLASS(exception)))
+            return item;
+        total = valueAdd(total, item);
+        if (isInstance(total, TYPE_CLASS(exception)))
+            return total;
+    }
+    return total;
+}
+
+Value Py_Sorted(int argc, int kwargc) {
+    static char *keywords[] = {"iterable", "key", "reverse"};
+    Value iterable, key, reverse;
+    PARSE_ARGS(&iterable, &key, &reverse);
+
+    Value list = List_Init(UNDEFINED_VAL, 1, &iterable);
+    if (isInstance(list, TYPE_CLASS(exception)))
+        return list;
+
+    push(list);
+    Value result = List_Sort(list, key, !IS_UNDEFINED(reverse) && valueToBool(reverse));
+    pop();
+
+    if (isInstance(result, TYPE_CLASS(exception)))
+        return result;
+    return list;
+}
+
+Value Py_Hash(int argc, int kwargc) {
+    static char *keywords[] = {"obj"};
+    Value obj;
+    PARSE_ARGS(&obj);
+
+    return INT_VAL((long long)valueHash(obj));
+}
+
 Value Py_Repr(int argc, int kwargc) {
     static char *keywords[] = {"obj"};
     Value obj;
     PARSE_ARGS(&obj);
 
-    return OBJ_VAL(valueToRepr(obj));
+    return STRING_VAL(valueToRepr(obj));
 }
 
 Value Py_Input(int argc, int kwargc) {
@@ -71,7 +185,8 @@ Value Py_Input(int argc, int kwargc) {
     PARSE_ARGS(&promt);
 
     if (!IS_UNDEFINED(promt))
-        valuePrint(promt);
+        valueWrite(promt, &vm.output);
+    flushOutput();
 
     const size_t size = 256;
     char buffer[size];
@@ -125,4 +240,14 @@ Value Py_Next(int argc, int kwargc) {
     PARSE_ARGS(&object);
 
     return valueNext(object);
-}
\ No newline at end of file
+}
+
+Value Py_HeapSnapshot(int argc, int kwargc) {
+    if (argc != 0 || kwargc != 0)
+        reportArityError(0, 0, argc + kwargc);
+
+    if (!traceAllocEnabled)
+        return createException(VAL_RUNTIME_ERROR, "heap_snapshot() requires --trace-alloc");
+
+    return heapSnapshot();
+}
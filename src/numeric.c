@@ -0,0 +1,379 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <float.h>
+
+#include "numeric.h"
+#include "string_scan.h"
+#include "memory.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SWAR_DIGITS
+#endif
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Powers of ten that doubles hold exactly.
+static const double POWERS_OF_TEN[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#define MAX_EXACT_POWER 22
+
+// Integers up to 2^53 are exact in a double.
+#define MAX_EXACT_INT 9007199254740992.0
+
+// Writes the digits of value so that they end just before end, and returns
+// where they start.
+static char *writeDigits(char *end, uint64_t value) {
+    while (value >= 100) {
+        end -= 2;
+        memcpy(end, DIGIT_PAIRS + (value % 100) * 2, 2);
+        value /= 100;
+    }
+    if (value >= 10) {
+        end -= 2;
+        memcpy(end, DIGIT_PAIRS + value * 2, 2);
+    } else {
+        *--end = '0' + value;
+    }
+    return end;
+}
+
+int formatInt(char *buffer, long long value) {
+    char digits[INT_BUFFER_SIZE];
+    char *end = digits + sizeof(digits);
+    // Negating in unsigned arithmetic keeps the most negative value exact.
+    uint64_t magnitude = value < 0 ? -(uint64_t)value : (uint64_t)value;
+    char *start = writeDigits(end, magnitude);
+    if (value < 0)
+        *--start = '-';
+
+    int length = end - start;
+    memcpy(buffer, start, length);
+    return length;
+}
+
+// Shortest digits of a positive finite value that read back as it, without
+// trailing zeros. Sets exponent to the power of ten of the first digit.
+//
+// Most values printed in practice are short decimals m / 10^k with m below
+// 2^53. For those, m and 10^k are exact doubles and the division is
+// correctly rounded, so a candidate is checked exactly with one division,
+// and the first k that works gives the shortest digits. Both neighbours
+// working means the digits are too close to tell apart this way. That case,
+// and everything else, falls back to printing 15, 16 and then 17
+// significant digits and keeping the first that reads back. Any shorter
+// digits that read back would have been found by the 15 digit print.
+static int shortestDigits(double value, char *digits, int *exponent) {
+    int count = 0;
+
+    for (int k = 0; k <= MAX_EXACT_POWER; k++) {
+        double scaled = value * POWERS_OF_TEN[k];
+        if (scaled >= MAX_EXACT_INT)
+            break;
+        double low = floor(scaled);
+        bool lowFits = low / POWERS_OF_TEN[k] == value;
+        bool highFits = (low + 1) / POWERS_OF_TEN[k] == value;
+        if (lowFits && highFits)
+            break;
+        if (lowFits || highFits) {
+            char buffer[INT_BUFFER_SIZE];
+            char *end = buffer + sizeof(buffer);
+            char *start = writeDigits(end, (uint64_t)(lowFits ? low : low + 1));
+            count = end - start;
+            memcpy(digits, start, count);
+            *exponent = count - 1 - k;
+            break;
+        }
+    }
+
+    if (count == 0) {
+        char text[FLOAT_BUFFER_SIZE];
+        // Subnormals have fewer significant bits, so they may need fewer
+        // than 15 digits to read back.
+        int precision = value < DBL_MIN ? 0 : 14;
+        for (; precision <= 16; precision++) {
+            snprintf(text, sizeof(text), "%.*e", precision, value);
+            if (strtod(text, NULL) == value)
+                break;
+        }
+        // The text is d.ddde[+-]x, without the point for a single digit.
+        for (const char *p = text; *p != 'e'; p++)
+            if (*p != '.')
+                digits[count++] = *p;
+        const char *p = strchr(text, 'e');
+        *exponent = strtol(p + 1, NULL, 10);
+    }
+
+    while (count > 1 && digits[count - 1] == '0')
+        count--;
+    return count;
+}
+
+int formatFloat(char *buffer, double value) {
+    char *out = buffer;
+    if (isnan(value)) {
+        memcpy(out, "nan", 3);
+        return 3;
+    }
+    if (signbit(value)) {
+        *out++ = '-';
+        value = -value;
+    }
+    if (isinf(value)) {
+        memcpy(out, "inf", 3);
+        return out + 3 - buffer;
+    }
+    if (value == 0) {
+        memcpy(out, "0.0", 3);
+        return out + 3 - buffer;
+    }
+
+    char digits[FLOAT_BUFFER_SIZE];
+    int exponent;
+    int count = shortestDigits(value, digits, &exponent);
+
+    // Like repr, use an exponent outside of 1e-4 <= value < 1e16.
+    if (exponent < -4 || exponent >= 16) {
+        *out++ = digits[0];
+        if (count > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, count - 1);
+            out += count - 1;
+        }
+        *out++ = 'e';
+        *out++ = exponent < 0 ? '-' : '+';
+        if (exponent < 0)
+            exponent = -exponent;
+        if (exponent < 10)
+            *out++ = '0';
+        char *end = out + (exponent >= 100 ? 3 : exponent >= 10 ? 2 : 1);
+        writeDigits(end, exponent);
+        out = end;
+    } else if (exponent < 0) {
+        memcpy(out, "0.", 2);
+        out += 2;
+        memset(out, '0', -exponent - 1);
+        out += -exponent - 1;
+        memcpy(out, digits, count);
+        out += count;
+    } else if (exponent + 1 >= count) {
+        memcpy(out, digits, count);
+        out += count;
+        memset(out, '0', exponent + 1 - count);
+        out += exponent + 1 - count;
+        memcpy(out, ".0", 2);
+        out += 2;
+    } else {
+        memcpy(out, digits, exponent + 1);
+        out += exponent + 1;
+        *out++ = '.';
+        memcpy(out, digits + exponent + 1, count - exponent - 1);
+        out += count - exponent - 1;
+    }
+    return out - buffer;
+}
+
+static bool isDigit(char c) {
+    return '0' <= c && c <= '9';
+}
+
+#ifdef SWAR_DIGITS
+
+// Whether the eight bytes of the word are all ASCII digits.
+static bool isEightDigits(uint64_t word) {
+    return !(((word + 0x4646464646464646ull) | (word - 0x3030303030303030ull)) & 0x8080808080808080ull);
+}
+
+// Value of eight ASCII digits, the first one in the lowest byte. Adjacent
+// digits are combined into pairs, then quads, with one multiply each.
+static uint32_t parseEightDigits(uint64_t word) {
+    word -= 0x3030303030303030ull;
+    word = word * 10 + (word >> 8);
+    word = ((word & 0x000000ff000000ffull) * 0x000f424000000064ull +
+            ((word >> 16) & 0x000000ff000000ffull) * 0x0000271000000001ull) >> 32;
+    return (uint32_t)word;
+}
+
+#endif
+
+// A run of digits with single underscores between them, accumulated into
+// value. Eight digits at a time are converted together while value still
+// has room for them. On overflow the rest of the run is only validated.
+typedef struct {
+    const char *p;
+    const char *end;
+    uint64_t value;
+    int digits;
+    bool overflow;
+} DigitReader;
+
+static void readDigits(DigitReader *reader) {
+    bool afterDigit = false;
+    while (reader->p < reader->end) {
+#ifdef SWAR_DIGITS
+        if (reader->end - reader->p >= 8 && reader->value <= (UINT64_MAX - 99999999) / 100000000) {
+            uint64_t word;
+            memcpy(&word, reader->p, sizeof(word));
+            if (isEightDigits(word)) {
+                reader->value = reader->value * 100000000 + parseEightDigits(word);
+                reader->p += 8;
+                reader->digits += 8;
+                afterDigit = true;
+                continue;
+            }
+        }
+#endif
+        char c = *reader->p;
+        if (isDigit(c)) {
+            int digit = c - '0';
+            if (reader->value > (UINT64_MAX - digit) / 10)
+                reader->overflow = true;
+            else
+                reader->value = reader->value * 10 + digit;
+            reader->digits++;
+            afterDigit = true;
+        } else if (c == '_' && afterDigit && reader->p + 1 < reader->end && isDigit(reader->p[1])) {
+            afterDigit = false;
+        } else {
+            break;
+        }
+        reader->p++;
+    }
+}
+
+// Narrows [*start, *end) to the text between surrounding whitespace and
+// reads an optional sign.
+static bool trimSign(const char **start, const char **end) {
+    size_t length = *end - *start;
+    size_t leading = spanClass(*start, length, CLASS_SPACE);
+    *start += leading;
+    *end -= rspanClass(*start, length - leading, CLASS_SPACE);
+
+    bool negative = *start < *end && **start == '-';
+    if (*start < *end && (**start == '-' || **start == '+'))
+        (*start)++;
+    return negative;
+}
+
+ParseResult parseInt(const char *chars, size_t length, long long *value) {
+    const char *start = chars;
+    const char *end = chars + length;
+    bool negative = trimSign(&start, &end);
+
+    DigitReader reader = {start, end, 0, 0, false};
+    readDigits(&reader);
+    if (reader.digits == 0 || reader.p != end)
+        return PARSE_INVALID;
+
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (reader.overflow || reader.value > limit)
+        return PARSE_OVERFLOW;
+
+    *value = negative ? (long long)-reader.value : (long long)reader.value;
+    return PARSE_OK;
+}
+
+// Case-insensitive match of [start, end) against a lowercase word.
+static bool matchWord(const char *start, const char *end, const char *word) {
+    size_t length = strlen(word);
+    if ((size_t)(end - start) != length)
+        return false;
+    for (size_t i = 0; i < length; i++)
+        if ((start[i] | 0x20) != word[i])
+            return false;
+    return true;
+}
+
+// Correctly rounded conversion of the validated text by strtod, for the
+// inputs that the exact fast path cannot take. Underscores are dropped.
+static double slowParseFloat(const char *start, const char *end) {
+    size_t length = end - start;
+    char *text = ALLOCATE(char, length + 1);
+    size_t count = 0;
+    for (const char *p = start; p < end; p++)
+        if (*p != '_')
+            text[count++] = *p;
+    text[count] = '\0';
+
+    double value = strtod(text, NULL);
+    FREE_VEC(char, text, length + 1);
+    return value;
+}
+
+// Mantissas of at most 2^53 scaled by exact powers of ten up to 1e22 need a
+// single correctly rounded multiply or divide (Clinger's fast path). Longer
+// mantissas and larger exponents go through strtod.
+ParseResult parseFloat(const char *chars, size_t length, double *value) {
+    const char *start = chars;
+    const char *end = chars + length;
+    bool negative = trimSign(&start, &end);
+
+    if (matchWord(start, end, "inf") || matchWord(start, end, "infinity")) {
+        *value = negative ? -INFINITY : INFINITY;
+        return PARSE_OK;
+    }
+    if (matchWord(start, end, "nan")) {
+        *value = negative ? -NAN : NAN;
+        return PARSE_OK;
+    }
+
+    DigitReader reader = {start, end, 0, 0, false};
+    readDigits(&reader);
+    int digits = reader.digits;
+    long long exponent = 0;
+    if (reader.p < end && *reader.p == '.') {
+        reader.p++;
+        reader.digits = 0;
+        readDigits(&reader);
+        digits += reader.digits;
+        exponent -= reader.digits;
+    }
+    if (digits == 0)
+        return PARSE_INVALID;
+
+    if (reader.p < end && (*reader.p | 0x20) == 'e') {
+        const char *p = reader.p + 1;
+        bool negativeExponent = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+'))
+            p++;
+        DigitReader exponentReader = {p, end, 0, 0, false};
+        readDigits(&exponentReader);
+        if (exponentReader.digits == 0)
+            return PARSE_INVALID;
+        reader.p = exponentReader.p;
+        // Anything this large is zero or infinity either way; strtod decides.
+        long long magnitude = exponentReader.overflow || exponentReader.value > 100000 ? 100000 : exponentReader.value;
+        exponent += negativeExponent ? -magnitude : magnitude;
+    }
+    if (reader.p != end)
+        return PARSE_INVALID;
+
+    double result;
+    if (!reader.overflow && reader.value <= (uint64_t)MAX_EXACT_INT && exponent >= -MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER) {
+        result = (double)reader.value;
+        if (exponent < 0)
+            result /= POWERS_OF_TEN[-exponent];
+        else
+            result *= POWERS_OF_TEN[exponent];
+    } else {
+        result = slowParseFloat(start, end);
+    }
+
+    *value = negative ? -result : result;
+    return PARSE_OK;
+}
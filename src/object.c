@@ -2,11 +2,14 @@
 
 #ifdef DEBUG_LOG_GC
     #include <stdio.h>
+    #include "debug.h"
 #endif
 
 #include "object.h"
 #include "vm.h"
 #include "memory.h"
+#include "arena.h"
+#include "alloc_trace.h"
 #include "value.h"
 #include "table.h"
 #include "common.h"
@@ -16,13 +19,33 @@ Obj* allocateObject(size_t size, ValueType type) {
     object->type = type;
     object->next = vm.objects;
     object->isMarked = false;
+    object->isImmortal = false;
     vm.objects = object;
+    vm.objectCount++;
+    if (traceAllocEnabled)
+        traceAllocation(object, size);
     #ifdef DEBUG_LOG_GC
-        printf("allocate %p, size %zu bytes, %s\n", object, size, decodeObjType(OBJ_VAL(object)));
+        printf("allocate %p, size %zu bytes, %s\n", object, size, decodeValueType(OBJ_VAL(object)));
+    #endif
+    return object;
+}
+
+// Immortal objects live in vm.immortals, are never linked into vm.objects
+// and are skipped by mark and sweep, so their pages are never written by the GC.
+Obj* allocateImmortalObject(size_t size, ValueType type) {
+    Obj *object = (Obj*)arenaAllocate(&vm.immortals, size);
+    object->type = type;
+    object->next = NULL;
+    object->isMarked = false;
+    object->isImmortal = true;
+    if (traceAllocEnabled)
+        traceAllocation(object, size);
+    #ifdef DEBUG_LOG_GC
+        printf("allocate immortal %p, size %zu bytes, %s\n", object, size, decodeValueType(OBJ_VAL(object)));
     #endif
     return object;
 }
 
 bool isObject(Value value) {
-    return value.type < VAL_STRING;
+    return value.type >= VAL_STRING;
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ ObjClass *createClass(ObjString *name, Value super) {
 }
 
 ObjNativeClass *createNativeClass(ObjString *name, ValueType type, ValueType super) {
-    ObjNativeClass *class = (ObjNativeClass*)allocateObject(sizeof(ObjNativeClass), VAL_NATIVE_CLASS);
+    ObjNativeClass *class = (ObjNativeClass*)allocateImmortalObject(sizeof(ObjNativeClass), VAL_NATIVE_CLASS);
     class->name = name;
     class->type = type;
     class->super = super;
@@ -37,8 +37,8 @@ ObjNativeMethod *createNativeMethod(Value reciever, NativeFn function, const cha
     return native;
 }
 
-int Class_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "<class '%s'>", AS_CLASS(value)->name->chars);
+void Class_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<class '%s'>", AS_CLASS(value)->name->chars);
 }
 
 Value Class_Call(Value callee, int argc, int kwargc, Value *argv) {
@@ -50,6 +50,7 @@ Value Class_Call(Value callee, int argc, int kwargc, Value *argv) {
     } else if (argc != 0) {
         return createException(VAL_TYPE_ERROR, "%s() takes no arguments", class->name->chars);
     }
+    return NONE_VAL;
 }
 
 Value Class_GetAttr(Value obj, ObjString *name) {
@@ -66,8 +67,8 @@ Value Class_Class(Value value) {
     return OBJ_VAL(vm.types.type);
 }
 
-int NativeClass_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "<class '%s'>", AS_NATIVE_CLASS(value)->name->chars);
+void NativeClass_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<class '%s'>", AS_NATIVE_CLASS(value)->name->chars);
 }
 
 Value NativeClass_Call(Value callee, int argc, int kwargc, Value *argv) {
@@ -76,28 +77,31 @@ Value NativeClass_Call(Value callee, int argc, int kwargc, Value *argv) {
     vm.top -= argc + 1;
     push(res);
     raiseIfException();
+    return NONE_VAL;
 }
 
 Value Method_Call(Value callee, int argc,  int kwargc, Value *argv) {
     ObjMethod *method = AS_METHOD(callee);
     insert(argc + 2*kwargc, method->reciever);
     call(method->method, argc + 1, kwargc, true);
+    return NONE_VAL;
 }
 
-int Method_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "<bound method %s>", AS_METHOD(value)->method->function->name->chars);
+void Method_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<bound method %s>", AS_METHOD(value)->method->function->name->chars);
 }
 
-int NativeMethod_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "<method-wrapper '%s'>", AS_NATIVE_METHOD(value)->name);
+void NativeMethod_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<method-wrapper '%s'>", AS_NATIVE_METHOD(value)->name);
 }
 
 Value NativeMethod_Call(Value callee, int argc, int kwargc, Value *argv) {
     ObjNativeMethod *method = AS_NATIVE_METHOD(callee);
     insert(argc + 2*kwargc, method->reciever);
     NativeFn native = method->method;
-    Value result = native(argc + 1, kwargc); 
-    vm.top -= argc + 1;
+    Value result = native(argc + 1, kwargc);
+    vm.top -= argc + 2 * kwargc + 1;
     push(result);
     raiseIfException();
+    return NONE_VAL;
 }
\ No newline at end of file
@@ -13,6 +13,13 @@ ObjDict *allocateDict() {
     return dict;
 }
 
+void dictUpdate(ObjDict *dest, ObjDict *source) {
+    size_t index = 0;
+    Value key, value;
+    while (tableNext(&source->table, &index, &key, &value))
+        tableSet(&dest->table, key, value);
+}
+
 Value Dict_Equal(Value a, Value b) {
     return BOOL_VAL(compareTables(&AS_DICT(a)->table, &AS_DICT(b)->table));
 }
@@ -21,6 +28,22 @@ Value Dict_NotEqual(Value a, Value b) {
     return BOOL_VAL(!compareTables(&AS_DICT(a)->table, &AS_DICT(b)->table));
 }
 
+Value Dict_Or(Value a, Value b) {
+    if (!IS_DICT(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjDict *result = allocateDict();
+    dictUpdate(result, AS_DICT(a));
+    dictUpdate(result, AS_DICT(b));
+    return OBJ_VAL(result);
+}
+
+Value Dict_InplaceOr(Value a, Value b) {
+    if (!IS_DICT(b))
+        return NOT_IMPLEMENTED_VAL;
+    dictUpdate(AS_DICT(a), AS_DICT(b));
+    return a;
+}
+
 Value Dict_Contains(Value a, Value b) {
     Value res = tableGet(&AS_DICT(a)->table, b);
     return BOOL_VAL(!IS_UNDEFINED(res));
@@ -65,24 +88,20 @@ bool Dict_ToBool(Value value) {
     return Dict_Len(value);
 }
 
-int Dict_ToStr(Value value, char *buffer, size_t size) {
-    size_t bytesLeft = size;
-
-    int bytesWritten = writeToBuffer(buffer, bytesLeft, "{");
-    bytesLeft -= movePointer(&buffer, bytesWritten);
-
-    size_t capacity = AS_DICT(value)->table.capacity;
-    size_t len = AS_DICT(value)->table.size;
+void Dict_ToStr(Value value, Writer *writer) {
+    writeChar(writer, '{');
 
-    for (int i = 0; i < len; i++) {
-        Entry *entry = AS_DICT(value)->table.order[i];
+    Table *table = &AS_DICT(value)->table;
+    size_t index = 0;
+    Value key, item;
 
-        valueReprWrite(entry->key, buffer, bytesLeft);
-        writeToBuffer(buffer, bytesLeft, ": ");
-        valueReprWrite(entry->value, buffer, bytesLeft);
-        if (i + 1!=  len)
-            writeToBuffer(buffer, bytesLeft, ", ");
+    for (int i = 0; tableNext(table, &index, &key, &item); i++) {
+        if (i != 0)
+            writeChars(writer, ", ", 2);
+        valueReprWrite(key, writer);
+        writeChars(writer, ": ", 2);
+        valueReprWrite(item, writer);
     }
 
-    writeToBuffer(buffer, bytesLeft, "}");
+    writeChar(writer, '}');
 }
\ No newline at end of file
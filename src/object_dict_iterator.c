@@ -6,9 +6,8 @@
 
 ObjDictIterator *allocateDictIterator(Value value) {
     ObjDictIterator *iter = (ObjDictIterator*)allocateObject(sizeof(ObjDictIterator), VAL_DICT_ITERATOR);
-    ObjDict *dict = AS_DICT(value);
-    iter->current = dict->table.order;
-    iter->end = dict->table.order + dict->table.size;
+    iter->iterable = value;
+    iter->index = 0;
     return iter;
 }
 
@@ -18,11 +17,9 @@ Value DictIterator_Iter(Value value) {
 
 Value DictIterator_Next(Value value) {
     ObjDictIterator *iter = AS_DICT_ITERATOR(value);
-    while (iter->current < iter->end) {
-        Entry *entry = *iter->current; 
-        iter->current++;
-        return entry->key;
-    }
+    Value key, item;
+    if (tableNext(&AS_DICT(iter->iterable)->table, &iter->index, &key, &item))
+        return key;
     return createException(VAL_STOP_ITERATION, "");
 }
 
@@ -12,15 +12,15 @@ ObjException *allocateException(Value value, ValueType type) {
 }
 
 Value createException(ValueType type, char *format, ...) {
-    static char buffer[1024];
+    Writer writer;
+    initWriter(&writer);
     va_list args;
     va_start(args, format);
+    writeVFormat(&writer, format, args);
+    va_end(args);
 
-    int len = vsnprintf(buffer, sizeof(buffer), format, args);
-    ObjString *string = copyString(buffer, len);
+    ObjString *string = writerToString(&writer);
     ObjException *exception = allocateException(OBJ_VAL(string), type);
-
-    va_end(args);
     return OBJ_VAL(exception);
 }
 
@@ -40,19 +40,14 @@ Value Exception_Class(Value value) {
     return TYPE_CLASS(exception);
 }
 
-int Exception_ToStr(Value value, char *buffer, const size_t size) {
-    valueWrite(AS_EXCEPTION(value)->value, buffer, size);
+void Exception_ToStr(Value value, Writer *writer) {
+    valueWrite(AS_EXCEPTION(value)->value, writer);
 }
 
-int Exception_ToRepr(Value value, char *buffer, const size_t size) {
-    size_t bytesLeft = size;
-    int bytesWritten = writeToBuffer(buffer, bytesLeft, "%s(", getValueType(value));
-    bytesLeft -= movePointer(&buffer, bytesWritten);
-
-    bytesWritten = valueReprWrite(AS_EXCEPTION(value)->value, buffer, bytesLeft);
-    bytesLeft -= movePointer(&buffer, bytesWritten);
-
-    writeToBuffer(buffer, bytesLeft, ")");
+void Exception_ToRepr(Value value, Writer *writer) {
+    writeFormat(writer, "%s(", getValueType(value));
+    valueReprWrite(AS_EXCEPTION(value)->value, writer);
+    writeChar(writer, ')');
 }
 
 Value ZeroDivisionError_Init(Value callee, int argc, Value *argv) {
@@ -142,3 +137,11 @@ Value NotImplementedError_Init(Value callee, int argc, Value *argv) {
 Value NotImplementedError_Class(Value value) {
     return TYPE_CLASS(notImplementedError);
 }
+
+Value MemoryError_Init(Value callee, int argc, Value *argv) {
+    return init(argc, argv, VAL_MEMORY_ERROR);
+}
+
+Value MemoryError_Class(Value value) {
+    return TYPE_CLASS(memoryError);
+}
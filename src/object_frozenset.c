@@ -0,0 +1,50 @@
+#include "object_frozenset.h"
+#include "object_exception.h"
+#include "methods_frozenset.h"
+#include "vm.h"
+
+Value FrozenSet_Init(Value callee, int argc, Value *argv) {
+    (void)callee;
+    if (argc > 1)
+        return createException(VAL_TYPE_ERROR, "frozenset expected at most 1 argument, got %d", argc);
+    if (argc == 0)
+        return OBJ_VAL(allocateSet(VAL_FROZENSET));
+    if (IS_FROZENSET(argv[0]))
+        return argv[0];
+    return setFromIterable(VAL_FROZENSET, argv[0]);
+}
+
+Value FrozenSet_Class(Value value) {
+    (void)value;
+    return TYPE_CLASS(frozenset);
+}
+
+Value FrozenSet_GetAttr(Value value, ObjString *name) {
+    return getStaticAttribute(value, name, in_frozenset_set);
+}
+
+// CPython's frozenset hash: element hashes are shuffled before being xored so
+// that the result does not depend on iteration order.
+static uint64_t shuffleBits(uint64_t hash) {
+    return ((hash ^ 89869747ull) ^ (hash << 16)) * 3644798167ull;
+}
+
+uint64_t FrozenSet_Hash(Value value) {
+    ObjSet *set = AS_SET(value);
+    if (set->isHashed)
+        return set->hash;
+
+    uint64_t hash = 0;
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(&set->set, &index)) != NULL)
+        hash ^= shuffleBits(entry->hash);
+
+    hash ^= ((uint64_t)set->set.size + 1) * 1927868237ull;
+    hash ^= (hash >> 11) ^ (hash >> 25);
+    hash = hash * 69069u + 907133923ull;
+
+    set->hash = hash;
+    set->isHashed = true;
+    return hash;
+}
@@ -21,6 +21,9 @@ ObjFunction* createFunction() {
     function->extraKwargs = -1;
     function->upvalueCount = 0;
     function->name = NULL;
+    function->defaults = NULL;
+    function->localNames = NULL;
+    function->module = NULL;
     initCodeVec(&function->code);
     return function;
 }
@@ -38,23 +41,24 @@ ObjClosure* createClosure(ObjFunction *function) {
 }
 
 ObjNative* createNative(NativeFn function, const char *name) {
-    ObjNative *native = (ObjNative*)allocateObject(sizeof(ObjNative), VAL_NATIVE);
+    ObjNative *native = (ObjNative*)allocateImmortalObject(sizeof(ObjNative), VAL_NATIVE);
     native->function = function;
     native->name = name;
     return native;
 }
 
-int Function_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "<function %s>", AS_FUNCTION(value)->name->chars);
+void Function_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<function %s>", AS_FUNCTION(value)->name->chars);
 }
 
 Value Closure_Call(Value callee, int argc, int kwargc, Value *argv) {
     ObjClosure *closure = AS_CLOSURE(callee);
     call(closure, argc, kwargc, false);
+    return NONE_VAL;
 }
 
-int Closure_ToStr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "<function %s at %p>", AS_CLOSURE(value)->function->name->chars, valueId(value));
+void Closure_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<function %s at %p>", AS_CLOSURE(value)->function->name->chars, valueId(value));
 }
 
 Value Native_Call(Value callee, int argc, int kwargc, Value *argv) {
@@ -63,8 +67,9 @@ Value Native_Call(Value callee, int argc, int kwargc, Value *argv) {
     vm.top -= argc + 2 * kwargc + 1;
     push(res);
     raiseIfException();
+    return NONE_VAL;
 }
 
-int Native_ToStr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "<built-in function %s>", AS_NATIVE(value)->name);
+void Native_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<built-in function %s>", AS_NATIVE(value)->name);
 }
\ No newline at end of file
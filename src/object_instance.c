@@ -117,6 +117,7 @@ Value Instance_GetAttr(Value obj, ObjString *name) {
 
 Value Instance_SetAttr(Value obj, ObjString *name, Value value) {
     nameTableSet(&AS_INSTANCE(obj)->attributes, name, value);
+    return NONE_VAL;
 }
 
 Value Instance_DelAttr(Value obj, ObjString *name) {
@@ -158,10 +159,10 @@ double Instance_ToFloat(Value value) {
 
 }
 
-int Instance_ToStr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "%s object at %p", AS_INSTANCE(value)->class->name->chars, valueId(value));
+void Instance_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "%s object at %p", AS_INSTANCE(value)->class->name->chars, valueId(value));
 }
 
-int Instance_ToRepr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "%s object at %p", AS_INSTANCE(value)->class->name->chars, valueId(value));
+void Instance_ToRepr(Value value, Writer *writer) {
+    writeFormat(writer, "%s object at %p", AS_INSTANCE(value)->class->name->chars, valueId(value));
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include <stdio.h>
+#include <string.h>
+#include <limits.h>
 
 #include "object_list.h"
 #include "object_list_iterator.h"
@@ -6,9 +8,11 @@
 #include "object_class.h"
 #include "object_exception.h"
 #include "object_slice.h"
+#include "object_tuple.h"
 #include "object_range.h"
 #include "methods_list.h"
 #include "value_int.h"
+#include "value_float.h"
 #include "value_methods.h"
 #include "memory.h"
 #include "vm.h"
@@ -17,43 +21,216 @@ static int min(int a, int b) {
     return a < b ? a : b;
 }
 
-ObjList* allocateList(int size) {
+static size_t itemSize(ListStrategy strategy) {
+    switch (strategy) {
+        case LIST_INTS:   return sizeof(long long);
+        case LIST_FLOATS: return sizeof(double);
+        default:          return sizeof(Value);
+    }
+}
+
+static ListStrategy strategyFor(Value value) {
+    switch (value.type) {
+        case VAL_INT:   return LIST_INTS;
+        case VAL_FLOAT: return LIST_FLOATS;
+        default:        return LIST_OBJECTS;
+    }
+}
+
+static void resizeItems(ObjList *list, int capacity) {
+    size_t width = itemSize(list->strategy);
+    list->items.values = reallocate(list->items.values, list->capacity * width, capacity * width);
+    list->capacity = capacity;
+}
+
+// Allocates a list of `size` items. Boxed lists are filled with None; unboxed
+// items are left for the caller to fill.
+static ObjList *allocateListWith(ListStrategy strategy, int size) {
     ObjList *list = (ObjList*)allocateObject(sizeof(ObjList), VAL_LIST);
-    list->vec.size = size; 
-    list->vec.capacity = size; 
-    list->vec.values = NULL;
-    list->vec.values = (Value*)reallocate(list->vec.values, 0, size * sizeof(Value));
+    list->strategy = strategy;
+    list->size = size;
+    list->capacity = 0;
+    list->items.values = NULL;
+    resizeItems(list, size);
+    if (strategy == LIST_OBJECTS) {
+        for (int i = 0; i < size; i++)
+            list->items.values[i] = NONE_VAL;
+    }
+    return list;
+}
+
+ObjList* allocateList(int size) {
+    return allocateListWith(LIST_OBJECTS, size);
+}
+
+// Stores a value that already fits the list's strategy.
+static void storeItem(ObjList *list, int index, Value value) {
+    switch (list->strategy) {
+        case LIST_INTS:
+            list->items.ints[index] = AS_INT(value);
+            break;
+        case LIST_FLOATS:
+            list->items.floats[index] = AS_FLOAT(value);
+            break;
+        default:
+            list->items.values[index] = value;
+            break;
+    }
+}
+
+// Copies one item between lists that share a strategy.
+static void copyItem(ObjList *dest, int to, ObjList *source, int from) {
+    size_t width = itemSize(source->strategy);
+    memcpy((char*)dest->items.values + to * width, (char*)source->items.values + from * width, width);
+}
+
+static void copyItems(ObjList *dest, int offset, ObjList *source) {
+    if (dest->strategy == source->strategy) {
+        size_t width = itemSize(source->strategy);
+        memcpy((char*)dest->items.values + offset * width, source->items.values, source->size * width);
+        return;
+    }
+    for (int i = 0; i < source->size; i++)
+        storeItem(dest, offset + i, listGet(source, i));
+}
+
+ObjList* listFromValues(Value *values, int count) {
+    ListStrategy strategy = count > 0 ? strategyFor(values[0]) : LIST_OBJECTS;
+    for (int i = 1; i < count && strategy != LIST_OBJECTS; i++) {
+        if (strategyFor(values[i]) != strategy)
+            strategy = LIST_OBJECTS;
+    }
+
+    ObjList *list = allocateListWith(strategy, count);
+    for (int i = 0; i < count; i++)
+        storeItem(list, i, values[i]);
     return list;
 }
 
-int List_ToStr(Value value, char *buffer, size_t size) {
+ObjList* copyList(ObjList *list) {
+    ObjList *result = allocateListWith(list->strategy, list->size);
+    copyItems(result, 0, list);
+    return result;
+}
+
+void freeListItems(ObjList *list) {
+    resizeItems(list, 0);
+    list->size = 0;
+}
+
+// Boxes every item so the list can hold values of any type.
+static void generalize(ObjList *list) {
+    Value *values = GROW_VEC(Value, NULL, 0, list->capacity);
+    for (int i = 0; i < list->size; i++)
+        values[i] = listGet(list, i);
+
+    int capacity = list->capacity;
+    resizeItems(list, 0);
+    list->strategy = LIST_OBJECTS;
+    list->items.values = values;
+    list->capacity = capacity;
+}
+
+// Makes the list able to hold `value`: an empty list takes on the value's
+// strategy, a non-empty unboxed one is generalized if the value does not fit.
+static void adoptStrategy(ObjList *list, Value value) {
+    ListStrategy strategy = strategyFor(value);
+    if (list->strategy == strategy)
+        return;
+
+    if (list->size == 0) {
+        resizeItems(list, 0);
+        list->strategy = strategy;
+    } else if (list->strategy != LIST_OBJECTS) {
+        generalize(list);
+    }
+}
+
+Value listGet(ObjList *list, int index) {
+    switch (list->strategy) {
+        case LIST_INTS:   return INT_VAL(list->items.ints[index]);
+        case LIST_FLOATS: return FLOAT_VAL(list->items.floats[index]);
+        default:          return list->items.values[index];
+    }
+}
+
+void listSet(ObjList *list, int index, Value value) {
+    adoptStrategy(list, value);
+    storeItem(list, index, value);
+}
+
+void listAppend(ObjList *list, Value value) {
+    adoptStrategy(list, value);
+    if (list->size + 1 > list->capacity)
+        resizeItems(list, GROW_CAPACITY(list->capacity));
+    storeItem(list, list->size++, value);
+}
+
+void listInsert(ObjList *list, int index, Value value) {
+    adoptStrategy(list, value);
+    if (list->size + 1 > list->capacity)
+        resizeItems(list, GROW_CAPACITY(list->capacity));
+
+    size_t width = itemSize(list->strategy);
+    char *items = (char*)list->items.values;
+    memmove(items + (index + 1) * width, items + index * width, (list->size - index) * width);
+    storeItem(list, index, value);
+    list->size++;
+}
+
+void listDelete(ObjList *list, int index) {
+    size_t width = itemSize(list->strategy);
+    char *items = (char*)list->items.values;
+    memmove(items + index * width, items + (index + 1) * width, (list->size - index - 1) * width);
+    list->size--;
+}
+
+void listClear(ObjList *list) {
+    freeListItems(list);
+    list->strategy = LIST_OBJECTS;
+}
+
+void listReverse(ObjList *list) {
+    size_t width = itemSize(list->strategy);
+    char *items = (char*)list->items.values;
+    char tmp[sizeof(Value)];
+    for (int i = 0, j = list->size - 1; i < j; i++, j--) {
+        memcpy(tmp, items + i * width, width);
+        memcpy(items + i * width, items + j * width, width);
+        memcpy(items + j * width, tmp, width);
+    }
+}
+
+void List_ToStr(Value value, Writer *writer) {
     ObjList *list = AS_LIST(value);
-    int total_written = 0;
-    int bytesWritten = writeToBuffer(buffer, size, "[");
-    total_written += bytesWritten;
-    size -= movePointer(&buffer, bytesWritten);
-
-    size_t length = list->vec.size;
-    for (int i = 0; i < length; i++) {
-        bytesWritten = valueReprWrite(list->vec.values[i], buffer, size);
-        total_written += bytesWritten;
-        size -= movePointer(&buffer, bytesWritten);
-        if (i + 1 != length) {
-            bytesWritten = writeToBuffer(buffer, size, ", ");
-            total_written += bytesWritten;
-            size -= movePointer(&buffer, bytesWritten);
-        }
+    writeChar(writer, '[');
+    for (int i = 0; i < list->size; i++) {
+        if (i != 0)
+            writeChars(writer, ", ", 2);
+        valueReprWrite(listGet(list, i), writer);
     }
-    bytesWritten = writeToBuffer(buffer, size, "]");
-    total_written += bytesWritten;
-    return total_written;
+    writeChar(writer, ']');
 }
 
 Value List_Equal(Value a, Value b) {
-    if (AS_LIST(a)->vec.size != AS_LIST(b)->vec.size)
+    ObjList *l1 = AS_LIST(a);
+    ObjList *l2 = AS_LIST(b);
+    if (l1->size != l2->size)
         return BOOL_VAL(false);
-    for (int i = 0; i < AS_LIST(a)->vec.size; i++) {
-        if (!valueToBool(valueEqual(AS_LIST(a)->vec.values[i], AS_LIST(b)->vec.values[i])))
+
+    if (l1->strategy == LIST_INTS && l2->strategy == LIST_INTS)
+        return BOOL_VAL(memcmp(l1->items.ints, l2->items.ints, l1->size * sizeof(long long)) == 0);
+
+    if (l1->strategy == LIST_FLOATS && l2->strategy == LIST_FLOATS) {
+        for (int i = 0; i < l1->size; i++) {
+            if (l1->items.floats[i] != l2->items.floats[i])
+                return BOOL_VAL(false);
+        }
+        return BOOL_VAL(true);
+    }
+
+    for (int i = 0; i < l1->size; i++) {
+        if (!valueToBool(valueEqual(listGet(l1, i), listGet(l2, i))))
             return BOOL_VAL(false);
     }
     return BOOL_VAL(true);
@@ -63,16 +240,31 @@ Value List_NotEqual(Value a, Value b) {
     return BOOL_VAL(!AS_BOOL(List_Equal(a, b)));
 }
 
+#define RAW_INEQUALITY(x, y, length)       \
+    for (int i = 0; i < (length); i++) {   \
+        if ((x)[i] == (y)[i])              \
+            continue;                      \
+        return (x)[i] > (y)[i] ? 1 : -1;   \
+    }
+
 static int inequality(ObjList *a, ObjList *b) {
-    int minLength = min(a->vec.size, b->vec.size);
-    for (int i = 0; i < minLength; i++) {
-        if (valueToBool(valueEqual(a->vec.values[i], b->vec.values[i])))
-            continue;
-        if (valueToBool(valueGreater(a->vec.values[i], b->vec.values[i])))
-            return 1;
-        return -1;
+    int minLength = min(a->size, b->size);
+    if (a->strategy == LIST_INTS && b->strategy == LIST_INTS) {
+        RAW_INEQUALITY(a->items.ints, b->items.ints, minLength);
+    } else if (a->strategy == LIST_FLOATS && b->strategy == LIST_FLOATS) {
+        RAW_INEQUALITY(a->items.floats, b->items.floats, minLength);
+    } else {
+        for (int i = 0; i < minLength; i++) {
+            Value x = listGet(a, i);
+            Value y = listGet(b, i);
+            if (valueToBool(valueEqual(x, y)))
+                continue;
+            if (valueToBool(valueGreater(x, y)))
+                return 1;
+            return -1;
+        }
     }
-    return a->vec.size - b->vec.size;
+    return a->size - b->size;
 }
 
 Value List_Greater(Value a, Value b) {
@@ -106,15 +298,15 @@ Value List_Add(Value a, Value b) {
     ObjList *l1 = AS_LIST(a);
     ObjList *l2 = AS_LIST(b);
 
-    size_t size = l1->vec.size + l2->vec.size; 
-
-    ObjList *result = allocateList(size);
-
-    for (int i = 0; i < l1->vec.size; i++)
-        result->vec.values[i] = l1->vec.values[i];
+    ListStrategy strategy = LIST_OBJECTS;
+    if (l1->size == 0)
+        strategy = l2->strategy;
+    else if (l2->size == 0 || l1->strategy == l2->strategy)
+        strategy = l1->strategy;
 
-    for (int i = 0; i < l1->vec.size; i++)
-        result->vec.values[l1->vec.size + i] = l2->vec.values[i];
+    ObjList *result = allocateListWith(strategy, l1->size + l2->size);
+    copyItems(result, 0, l1);
+    copyItems(result, l1->size, l2);
 
     return OBJ_VAL(result);
 }
@@ -123,13 +315,23 @@ Value List_Multiply(Value a, Value b) {
     if (!IS_INT(b))
         return NOT_IMPLEMENTED_VAL;
 
-    size_t oldSize = AS_LIST(a)->vec.size;
-    size_t newSize = oldSize * AS_INT(b);
+    long long scalar = AS_INT(b);
+    if (scalar < 0)
+        scalar = 0;
 
-    ObjList *result = allocateList(newSize);
+    ObjList *list = AS_LIST(a);
+    size_t oldSize = list->size;
+    if (scalar > 0 && oldSize > (size_t)(INT_MAX / scalar))
+        return createException(VAL_MEMORY_ERROR, "repeated list is too long");
+    size_t newSize = oldSize * scalar;
+    size_t width = itemSize(list->strategy);
+    if (exceedsHeapLimit(newSize * width))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    ObjList *result = allocateListWith(list->strategy, newSize);
 
-    for (int i = 0; i < newSize; i++)
-        result->vec.values[i] = AS_LIST(a)->vec.values[i % oldSize];
+    for (size_t i = 0; i < newSize; i += oldSize)
+        memcpy((char*)result->items.values + i * width, list->items.values, oldSize * width);
 
     return OBJ_VAL(result);
 }
@@ -138,10 +340,64 @@ Value List_RightMultiply(Value a, Value b) {
     return List_Multiply(a, b);
 }
 
+Value List_InplaceAdd(Value a, Value b) {
+    Value res = List_Extend(a, b);
+    if (isInstance(res, TYPE_CLASS(exception)))
+        return res;
+    return a;
+}
+
+Value List_InplaceMultiply(Value a, Value b) {
+    if (!IS_INT(b))
+        return NOT_IMPLEMENTED_VAL;
+
+    ObjList *list = AS_LIST(a);
+    long long scalar = AS_INT(b);
+    if (scalar <= 0) {
+        listClear(list);
+        return a;
+    }
+
+    size_t oldSize = list->size;
+    if (oldSize > (size_t)(INT_MAX / scalar))
+        return createException(VAL_MEMORY_ERROR, "repeated list is too long");
+    size_t newSize = oldSize * scalar;
+    size_t width = itemSize(list->strategy);
+    if (exceedsHeapLimit(newSize * width))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    if (newSize > (size_t)list->capacity)
+        resizeItems(list, newSize);
+
+    for (size_t i = oldSize; i < newSize; i += oldSize)
+        memcpy((char*)list->items.values + i * width, list->items.values, oldSize * width);
+    list->size = newSize;
+
+    return a;
+}
+
 Value List_Contains(Value a, Value b) {
     ObjList *list = AS_LIST(a);
-    for (int i = 0; i < list->vec.size; i++) {
-        if (valueToBool(valueEqual(list->vec.values[i], b)))
+
+    if (list->strategy == LIST_INTS && (IS_INT(b) || IS_BOOL(b))) {
+        for (int i = 0; i < list->size; i++) {
+            if (list->items.ints[i] == AS_INT(b))
+                return BOOL_VAL(true);
+        }
+        return BOOL_VAL(false);
+    }
+
+    if (list->strategy == LIST_FLOATS && (IS_FLOAT(b) || IS_INT(b))) {
+        double needle = IS_FLOAT(b) ? AS_FLOAT(b) : AS_INT(b);
+        for (int i = 0; i < list->size; i++) {
+            if (list->items.floats[i] == needle)
+                return BOOL_VAL(true);
+        }
+        return BOOL_VAL(false);
+    }
+
+    for (int i = 0; i < list->size; i++) {
+        if (valueToBool(valueEqual(listGet(list, i), b)))
             return BOOL_VAL(true);
     }
     return BOOL_VAL(false);
@@ -158,17 +414,22 @@ Value List_Class(Value value) {
 Value List_Init(Value callee, int argc, Value *argv) {
     if (argc == 0)
         return OBJ_VAL(allocateList(0));
-    
-    long long length = valueLen(argv[0]);
 
-    ObjList *list = allocateList(length);
+    if (IS_LIST(argv[0]))
+        return OBJ_VAL(copyList(AS_LIST(argv[0])));
 
     Value iterator = valueIter(argv[0]);
-    Value item = valueNext(iterator);
+    if (isInstance(iterator, TYPE_CLASS(exception)))
+        return iterator;
 
-    for (int i = 0; i < length; i++) {
-        list->vec.values[i] = item;
-        item = valueNext(iterator);
+    ObjList *list = allocateList(0);
+    while (true) {
+        Value item = valueNext(iterator);
+        if (item.type == VAL_STOP_ITERATION)
+            break;
+        if (isInstance(item, TYPE_CLASS(exception)))
+            return item;
+        listAppend(list, item);
     }
 
     return OBJ_VAL(list);
@@ -179,45 +440,50 @@ Value List_GetAttr(Value list, ObjString *name) {
 }
 
 Value List_GetItem(Value obj, Value key) {
+    ObjList *list = AS_LIST(obj);
+
     if (IS_INT(key)) {
-        int index = calculateIndex(AS_INT(key), AS_LIST(obj)->vec.size);
+        int index = calculateIndex(AS_INT(key), list->size);
 
         if (index < 0)
             return createException(VAL_INDEX_ERROR, "list index out of range");
         
-        return AS_LIST(obj)->vec.values[index];
+        return listGet(list, index);
     } else if (IS_SLICE(key)) {
-        ParsedSlice slice = parseSlice(AS_SLICE(key), AS_LIST(obj)->vec.size);
-        if (slice.step == 0)
-            return createException(VAL_VALUE_ERROR, "slice step cannot be zero");
-        
-        ObjList *result = allocateList(slice.length);
-
-        if (slice.step > 0) {
-            for (int i = slice.start, j = 0; i < slice.stop; i += slice.step, j++) {
-                result->vec.values[j] = AS_LIST(obj)->vec.values[i];
-            }
-        } else {
-            for (int i = slice.stop - 1, j = 0; i >= slice.start; i += slice.step, j++) {
-                result->vec.values[j] = AS_LIST(obj)->vec.values[i];
-            }
-        }
-        return OBJ_VAL(result);
+        ObjSlice *slice = AS_SLICE(key);
+        return List_GetSlice(obj, slice->start, slice->stop, slice->step);
     }
     
     return createException(VAL_INDEX_ERROR, "list indices must be integers or slices, not %s", getValueType(key));
 }
 
+Value List_GetSlice(Value obj, Value start, Value stop, Value step) {
+    ObjList *list = AS_LIST(obj);
+    ParsedSlice slice = resolveSlice(start, stop, step, list->size);
+    if (slice.step == 0)
+        return createException(VAL_VALUE_ERROR, "slice step cannot be zero");
+
+    ObjList *result = allocateListWith(list->strategy, slice.length);
+    if (slice.step == 1 && slice.length > 0) {
+        size_t width = itemSize(list->strategy);
+        memcpy(result->items.values, (char*)list->items.values + slice.start * width, slice.length * width);
+    } else {
+        for (long long i = slice.start, j = 0; j < slice.length; i += slice.step, j++)
+            copyItem(result, j, list, i);
+    }
+    return OBJ_VAL(result);
+}
+
 Value List_SetItem(Value obj, Value key, Value value) {
     if (!IS_INT(key))
         return createException(VAL_INDEX_ERROR, "list indices must be integers or slices, not %s", getValueType(key));
     
-    int index = calculateIndex(AS_INT(key), AS_LIST(obj)->vec.size);
+    int index = calculateIndex(AS_INT(key), AS_LIST(obj)->size);
 
     if (index < 0)
         return createException(VAL_INDEX_ERROR, "list index out of range");
     
-    AS_LIST(obj)->vec.values[index] = value;
+    listSet(AS_LIST(obj), index, value);
     return NONE_VAL;
 }
 
@@ -225,35 +491,728 @@ Value List_DelItem(Value obj, Value key) {
     if (!IS_INT(key))
         return createException(VAL_INDEX_ERROR, "list indices must be integers or slices, not %s", getValueType(key));
     
-    int index = calculateIndex(AS_INT(key), AS_LIST(obj)->vec.size);
+    int index = calculateIndex(AS_INT(key), AS_LIST(obj)->size);
 
     if (index < 0)
         return createException(VAL_INDEX_ERROR, "list index out of range");
 
+    listDelete(AS_LIST(obj), index);
+
+    return NONE_VAL;
+}
+
+// Appends the items of `iterable` in place. Another list is copied in one go,
+// keeping the unboxed strategy when both sides share it; anything else goes
+// through the iterator protocol.
+Value List_Extend(Value obj, Value iterable) {
     ObjList *list = AS_LIST(obj);
-    
-    for (int i = index; i < list->vec.size - 1; i++)
-        list->vec.values[i] = list->vec.values[i + 1];
-    list->vec.size--;
 
+    if (IS_LIST(iterable)) {
+        ObjList *source = AS_LIST(iterable);
+        int size = source->size;
+        if (size == 0)
+            return NONE_VAL;
+
+        if (list->size == 0) {
+            resizeItems(list, 0);
+            list->strategy = source->strategy;
+        } else if (list->strategy != source->strategy && list->strategy != LIST_OBJECTS) {
+            generalize(list);
+        }
+
+        if (list->size + size > list->capacity) {
+            int capacity = GROW_CAPACITY(list->capacity);
+            resizeItems(list, capacity < list->size + size ? list->size + size : capacity);
+        }
+        copyItems(list, list->size, source);
+        list->size += size;
+        return NONE_VAL;
+    }
+
+    if (IS_TUPLE(iterable)) {
+        ObjTuple *tuple = AS_TUPLE(iterable);
+        for (size_t i = 0; i < tuple->size; i++)
+            listAppend(list, tuple->values[i]);
+        return NONE_VAL;
+    }
+
+    Value iterator = valueIter(iterable);
+    if (isInstance(iterator, TYPE_CLASS(exception)))
+        return iterator;
+
+    while (true) {
+        Value item = valueNext(iterator);
+        if (item.type == VAL_STOP_ITERATION)
+            break;
+        if (isInstance(item, TYPE_CLASS(exception)))
+            return item;
+        listAppend(list, item);
+    }
     return NONE_VAL;
 }
 
 Value List_Append(Value obj, Value value) {
-    pushValue(&AS_LIST(obj)->vec, value);
+    listAppend(AS_LIST(obj), value);
     return NONE_VAL;
 }
 
 Value List_Pop(Value obj) {
-    return popValue(&AS_LIST(obj)->vec);
+    ObjList *list = AS_LIST(obj);
+    return listGet(list, --list->size);
+}
+
+// Timsort, following CPython's listsort: natural runs are found and extended
+// to minrun with binary insertion, then merged with galloping. Items carry
+// their key so that key= is computed once per item. A pre-pass picks a
+// direct C comparison when every key is an int, a float or a str.
+
+#define MIN_GALLOP 7
+#define MAX_MERGE_PENDING 85
+
+typedef struct {
+    Value key;
+    Value value;
+} SortItem;
+
+typedef struct {
+    SortItem *base;
+    long length;
+} SortRun;
+
+typedef struct SortState {
+    // Returns 1 if a < b, 0 if not and -1 after storing an exception in error.
+    int (*lessThan)(struct SortState *state, Value a, Value b);
+    Value error;
+    long minGallop;
+    SortItem *temp;
+    long tempSize;
+    int pendingCount;
+    SortRun pending[MAX_MERGE_PENDING];
+} SortState;
+
+static int intLessThan(SortState *state, Value a, Value b) {
+    (void)state;
+    return AS_INT(a) < AS_INT(b);
+}
+
+static int floatLessThan(SortState *state, Value a, Value b) {
+    (void)state;
+    return AS_FLOAT(a) < AS_FLOAT(b);
+}
+
+static int stringLessThan(SortState *state, Value a, Value b) {
+    (void)state;
+    ObjString *x = AS_STRING(a);
+    ObjString *y = AS_STRING(b);
+    int result = memcmp(x->chars, y->chars, min(x->length, y->length));
+    return result != 0 ? result < 0 : x->length < y->length;
+}
+
+static int genericLessThan(SortState *state, Value a, Value b) {
+    Value result = valueLess(a, b);
+    if (isInstance(result, TYPE_CLASS(exception))) {
+        state->error = result;
+        return -1;
+    }
+    return valueToBool(result);
+}
+
+#define IF_LESS(a, b)                                           \
+    if ((k = state->lessThan(state, (a).key, (b).key)) < 0)      \
+        goto fail;                                              \
+    if (k)
+
+static void reverseItems(SortItem *lo, SortItem *hi) {
+    for (--hi; lo < hi; lo++, hi--) {
+        SortItem tmp = *lo;
+        *lo = *hi;
+        *hi = tmp;
+    }
+}
+
+// Sorts [lo, hi) by binary insertion, given that [lo, start) is sorted.
+static int binaryInsertionSort(SortState *state, SortItem *lo, SortItem *hi, SortItem *start) {
+    int k;
+    if (lo == start)
+        start++;
+    for (; start < hi; start++) {
+        SortItem *l = lo;
+        SortItem *r = start;
+        SortItem pivot = *r;
+        do {
+            SortItem *p = l + ((r - l) >> 1);
+            IF_LESS(pivot, *p)
+                r = p;
+            else
+                l = p + 1;
+        } while (l < r);
+        memmove(l + 1, l, (start - l) * sizeof(SortItem));
+        *l = pivot;
+    }
+    return 0;
+fail:
+    return -1;
+}
+
+// Length of the run starting at lo: either non-descending or strictly
+// descending, the latter reported through *descending.
+static long countRun(SortState *state, SortItem *lo, SortItem *hi, bool *descending) {
+    int k;
+    long n = 2;
+    *descending = false;
+    if (++lo == hi)
+        return 1;
+
+    IF_LESS(lo[0], lo[-1]) {
+        *descending = true;
+        for (lo++; lo < hi; lo++, n++) {
+            IF_LESS(lo[0], lo[-1])
+                ;
+            else
+                break;
+        }
+    } else {
+        for (lo++; lo < hi; lo++, n++) {
+            IF_LESS(lo[0], lo[-1])
+                break;
+        }
+    }
+    return n;
+fail:
+    return -1;
+}
+
+// Leftmost position in the sorted a[0, n) where key can be inserted,
+// searching outward from a[hint].
+static long gallopLeft(SortState *state, SortItem key, SortItem *a, long n, long hint) {
+    int k;
+    long lastOffset = 0;
+    long offset = 1;
+
+    a += hint;
+    IF_LESS(a[0], key) {
+        long maxOffset = n - hint;
+        while (offset < maxOffset) {
+            IF_LESS(a[offset], key) {
+                lastOffset = offset;
+                offset = (offset << 1) + 1;
+            } else {
+                break;
+            }
+        }
+        if (offset > maxOffset)
+            offset = maxOffset;
+        lastOffset += hint;
+        offset += hint;
+    } else {
+        long maxOffset = hint + 1;
+        while (offset < maxOffset) {
+            IF_LESS(*(a - offset), key)
+                break;
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset)
+            offset = maxOffset;
+        long tmp = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - tmp;
+    }
+    a -= hint;
+
+    lastOffset++;
+    while (lastOffset < offset) {
+        long m = lastOffset + ((offset - lastOffset) >> 1);
+        IF_LESS(a[m], key)
+            lastOffset = m + 1;
+        else
+            offset = m;
+    }
+    return offset;
+fail:
+    return -1;
+}
+
+// Like gallopLeft, but returns the position after any items equal to key.
+static long gallopRight(SortState *state, SortItem key, SortItem *a, long n, long hint) {
+    int k;
+    long lastOffset = 0;
+    long offset = 1;
+
+    a += hint;
+    IF_LESS(key, a[0]) {
+        long maxOffset = hint + 1;
+        while (offset < maxOffset) {
+            IF_LESS(key, *(a - offset)) {
+                lastOffset = offset;
+                offset = (offset << 1) + 1;
+            } else {
+                break;
+            }
+        }
+        if (offset > maxOffset)
+            offset = maxOffset;
+        long tmp = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - tmp;
+    } else {
+        long maxOffset = n - hint;
+        while (offset < maxOffset) {
+            IF_LESS(key, a[offset])
+                break;
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset)
+            offset = maxOffset;
+        lastOffset += hint;
+        offset += hint;
+    }
+    a -= hint;
+
+    lastOffset++;
+    while (lastOffset < offset) {
+        long m = lastOffset + ((offset - lastOffset) >> 1);
+        IF_LESS(key, a[m])
+            offset = m;
+        else
+            lastOffset = m + 1;
+    }
+    return offset;
+fail:
+    return -1;
+}
+
+static void reserveTemp(SortState *state, long need) {
+    if (need <= state->tempSize)
+        return;
+    state->temp = GROW_VEC(SortItem, state->temp, state->tempSize, need);
+    state->tempSize = need;
+}
+
+// Merges the adjacent runs a and b, na <= nb, in place. The first item of b
+// belongs before a[0] and the last of a after b[nb - 1].
+static int mergeLow(SortState *state, SortItem *a, long na, SortItem *b, long nb) {
+    int k;
+    int result = -1;
+    SortItem *dest = a;
+    long minGallop = state->minGallop;
+
+    reserveTemp(state, na);
+    memcpy(state->temp, a, na * sizeof(SortItem));
+    a = state->temp;
+
+    *dest++ = *b++;
+    if (--nb == 0)
+        goto succeed;
+    if (na == 1)
+        goto copyB;
+
+    for (;;) {
+        long aCount = 0;
+        long bCount = 0;
+
+        for (;;) {
+            IF_LESS(b[0], a[0]) {
+                *dest++ = *b++;
+                bCount++;
+                aCount = 0;
+                if (--nb == 0)
+                    goto succeed;
+                if (bCount >= minGallop)
+                    break;
+            } else {
+                *dest++ = *a++;
+                aCount++;
+                bCount = 0;
+                if (--na == 1)
+                    goto copyB;
+                if (aCount >= minGallop)
+                    break;
+            }
+        }
+
+        minGallop++;
+        do {
+            minGallop -= minGallop > 1;
+            state->minGallop = minGallop;
+
+            long n = gallopRight(state, b[0], a, na, 0);
+            if (n < 0)
+                goto fail;
+            aCount = n;
+            if (n) {
+                memcpy(dest, a, n * sizeof(SortItem));
+                dest += n;
+                a += n;
+                na -= n;
+                if (na == 1)
+                    goto copyB;
+                if (na == 0)
+                    goto succeed;
+            }
+            *dest++ = *b++;
+            if (--nb == 0)
+                goto succeed;
+
+            n = gallopLeft(state, a[0], b, nb, 0);
+            if (n < 0)
+                goto fail;
+            bCount = n;
+            if (n) {
+                memmove(dest, b, n * sizeof(SortItem));
+                dest += n;
+                b += n;
+                nb -= n;
+                if (nb == 0)
+                    goto succeed;
+            }
+            *dest++ = *a++;
+            if (--na == 1)
+                goto copyB;
+        } while (aCount >= MIN_GALLOP || bCount >= MIN_GALLOP);
+        minGallop++;
+        state->minGallop = minGallop;
+    }
+
+succeed:
+    result = 0;
+fail:
+    if (na)
+        memcpy(dest, a, na * sizeof(SortItem));
+    return result;
+copyB:
+    memmove(dest, b, nb * sizeof(SortItem));
+    dest[nb] = *a;
+    return 0;
+}
+
+// Mirror image of mergeLow for na > nb, merging from the right.
+static int mergeHigh(SortState *state, SortItem *a, long na, SortItem *b, long nb) {
+    int k;
+    int result = -1;
+    SortItem *dest = b + nb - 1;
+    SortItem *baseA = a;
+    SortItem *baseB;
+    long minGallop = state->minGallop;
+
+    reserveTemp(state, nb);
+    memcpy(state->temp, b, nb * sizeof(SortItem));
+    baseB = state->temp;
+    b = state->temp + nb - 1;
+    a += na - 1;
+
+    *dest-- = *a--;
+    if (--na == 0)
+        goto succeed;
+    if (nb == 1)
+        goto copyA;
+
+    for (;;) {
+        long aCount = 0;
+        long bCount = 0;
+
+        for (;;) {
+            IF_LESS(b[0], a[0]) {
+                *dest-- = *a--;
+                aCount++;
+                bCount = 0;
+                if (--na == 0)
+                    goto succeed;
+                if (aCount >= minGallop)
+                    break;
+            } else {
+                *dest-- = *b--;
+                bCount++;
+                aCount = 0;
+                if (--nb == 1)
+                    goto copyA;
+                if (bCount >= minGallop)
+                    break;
+            }
+        }
+
+        minGallop++;
+        do {
+            minGallop -= minGallop > 1;
+            state->minGallop = minGallop;
+
+            long n = gallopRight(state, b[0], baseA, na, na - 1);
+            if (n < 0)
+                goto fail;
+            n = na - n;
+            aCount = n;
+            if (n) {
+                dest -= n;
+                a -= n;
+                memmove(dest + 1, a + 1, n * sizeof(SortItem));
+                na -= n;
+                if (na == 0)
+                    goto succeed;
+            }
+            *dest-- = *b--;
+            if (--nb == 1)
+                goto copyA;
+
+            n = gallopLeft(state, a[0], baseB, nb, nb - 1);
+            if (n < 0)
+                goto fail;
+            n = nb - n;
+            bCount = n;
+            if (n) {
+                dest -= n;
+                b -= n;
+                memcpy(dest + 1, b + 1, n * sizeof(SortItem));
+                nb -= n;
+                if (nb == 1)
+                    goto copyA;
+                if (nb == 0)
+                    goto succeed;
+            }
+            *dest-- = *a--;
+            if (--na == 0)
+                goto succeed;
+        } while (aCount >= MIN_GALLOP || bCount >= MIN_GALLOP);
+        minGallop++;
+        state->minGallop = minGallop;
+    }
+
+succeed:
+    result = 0;
+fail:
+    if (nb)
+        memcpy(dest - (nb - 1), baseB, nb * sizeof(SortItem));
+    return result;
+copyA:
+    dest -= na;
+    a -= na;
+    memmove(dest + 1, a + 1, na * sizeof(SortItem));
+    *dest = *b;
+    return 0;
+}
+
+// Merges pending runs i and i + 1.
+static int mergeAt(SortState *state, int i) {
+    SortItem *a = state->pending[i].base;
+    long na = state->pending[i].length;
+    SortItem *b = state->pending[i + 1].base;
+    long nb = state->pending[i + 1].length;
+
+    state->pending[i].length = na + nb;
+    if (i == state->pendingCount - 3)
+        state->pending[i + 1] = state->pending[i + 2];
+    state->pendingCount--;
+
+    // Items of a before b[0] and items of b after a's last are in place.
+    long k = gallopRight(state, b[0], a, na, 0);
+    if (k < 0)
+        return -1;
+    a += k;
+    na -= k;
+    if (na == 0)
+        return 0;
+
+    nb = gallopLeft(state, a[na - 1], b, nb, nb - 1);
+    if (nb <= 0)
+        return nb;
+
+    if (na <= nb)
+        return mergeLow(state, a, na, b, nb);
+    return mergeHigh(state, a, na, b, nb);
+}
+
+// Restores the run-length invariants on the pending stack:
+// len[n-2] > len[n-1] + len[n] and len[n-1] > len[n].
+static int mergeCollapse(SortState *state) {
+    SortRun *p = state->pending;
+    while (state->pendingCount > 1) {
+        int n = state->pendingCount - 2;
+        if ((n > 0 && p[n - 1].length <= p[n].length + p[n + 1].length) ||
+            (n > 1 && p[n - 2].length <= p[n - 1].length + p[n].length)) {
+            if (p[n - 1].length < p[n + 1].length)
+                n--;
+            if (mergeAt(state, n) < 0)
+                return -1;
+        } else if (p[n].length <= p[n + 1].length) {
+            if (mergeAt(state, n) < 0)
+                return -1;
+        } else {
+            break;
+        }
+    }
+    return 0;
+}
+
+static int mergeForceCollapse(SortState *state) {
+    SortRun *p = state->pending;
+    while (state->pendingCount > 1) {
+        int n = state->pendingCount - 2;
+        if (n > 0 && p[n - 1].length < p[n + 1].length)
+            n--;
+        if (mergeAt(state, n) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+static long computeMinRun(long n) {
+    long r = 0;
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+static int timsort(SortState *state, SortItem *items, long count) {
+    long remaining = count;
+    long minRun = computeMinRun(count);
+    SortItem *lo = items;
+
+    while (remaining > 0) {
+        bool descending;
+        long n = countRun(state, lo, lo + remaining, &descending);
+        if (n < 0)
+            return -1;
+        if (descending)
+            reverseItems(lo, lo + n);
+        if (n < minRun) {
+            long force = remaining <= minRun ? remaining : minRun;
+            if (binaryInsertionSort(state, lo, lo + force, lo + n) < 0)
+                return -1;
+            n = force;
+        }
+        state->pending[state->pendingCount].base = lo;
+        state->pending[state->pendingCount].length = n;
+        state->pendingCount++;
+        if (mergeCollapse(state) < 0)
+            return -1;
+        lo += n;
+        remaining -= n;
+    }
+    return mergeForceCollapse(state);
 }
 
-Value List_Sort(Value obj) {
+static void chooseComparison(SortState *state, ObjList *list, SortItem *items, bool hasKey) {
+    if (!hasKey && list->strategy == LIST_INTS) {
+        state->lessThan = intLessThan;
+        return;
+    }
+    if (!hasKey && list->strategy == LIST_FLOATS) {
+        state->lessThan = floatLessThan;
+        return;
+    }
+
+    ValueType type = list->size > 0 ? items[0].key.type : VAL_UNDEFINED;
+    for (int i = 1; i < list->size; i++) {
+        if (items[i].key.type != type) {
+            type = VAL_UNDEFINED;
+            break;
+        }
+    }
+
+    switch (type) {
+        case VAL_INT:    state->lessThan = intLessThan; break;
+        case VAL_FLOAT:  state->lessThan = floatLessThan; break;
+        case VAL_STRING: state->lessThan = stringLessThan; break;
+        default:         state->lessThan = genericLessThan; break;
+    }
+}
+
+// Sorts the list in place. key is UNDEFINED or None for no key function.
+// Keys are computed into a list kept on the stack, so the collector sees them
+// while later key calls run.
+Value List_Sort(Value obj, Value key, bool reverse) {
+    ObjList *list = AS_LIST(obj);
+    int size = list->size;
+    bool hasKey = !IS_UNDEFINED(key) && !IS_NONE(key);
+
+    ObjList *keys = NULL;
+    if (hasKey) {
+        keys = allocateList(0);
+        push(OBJ_VAL(keys));
+        for (int i = 0; i < size && i < list->size; i++) {
+            push(key);
+            push(listGet(list, i));
+            Value result = callNovaValue(key, 1);
+            if (isInstance(result, TYPE_CLASS(exception))) {
+                pop();
+                return result;
+            }
+            listAppend(keys, result);
+        }
+        pop();
+        if (list->size != size)
+            return createException(VAL_VALUE_ERROR, "list modified during sort");
+    }
+
+    // Nothing to reorder, and no items array to reverse.
+    if (size < 2)
+        return NONE_VAL;
+
+    SortItem *items = ALLOCATE(SortItem, size);
+    for (int i = 0; i < size; i++) {
+        items[i].value = listGet(list, i);
+        items[i].key = hasKey ? listGet(keys, i) : items[i].value;
+    }
+
+    SortState state = {.error = NONE_VAL, .minGallop = MIN_GALLOP, .temp = NULL, .tempSize = 0, .pendingCount = 0};
+    chooseComparison(&state, list, items, hasKey);
+
+    // Reversing before and after keeps equal items in their original order.
+    if (reverse)
+        reverseItems(items, items + size);
+    int status = timsort(&state, items, size);
+    if (reverse)
+        reverseItems(items, items + size);
+
+    if (status == 0) {
+        for (int i = 0; i < size; i++)
+            listSet(list, i, items[i].value);
+    }
+
+    FREE_VEC(SortItem, state.temp, state.tempSize);
+    FREE_VEC(SortItem, items, size);
+    return status == 0 ? NONE_VAL : state.error;
+}
+
+// Sums unboxed int and float lists directly; anything else goes through
+// valueAdd one item at a time.
+Value List_Sum(Value obj, Value start) {
+    ObjList *list = AS_LIST(obj);
+
+    if (list->strategy == LIST_INTS && IS_INT(start)) {
+        long long total = AS_INT(start);
+        for (int i = 0; i < list->size; i++)
+            total += list->items.ints[i];
+        return INT_VAL(total);
+    }
+
+    if ((list->strategy == LIST_FLOATS || list->strategy == LIST_INTS) && IS_FLOAT(start)) {
+        double total = AS_FLOAT(start);
+        for (int i = 0; i < list->size; i++)
+            total += list->strategy == LIST_FLOATS ? list->items.floats[i] : list->items.ints[i];
+        return FLOAT_VAL(total);
+    }
+
+    if (list->strategy == LIST_FLOATS && IS_INT(start) && list->size > 0) {
+        double total = AS_INT(start);
+        for (int i = 0; i < list->size; i++)
+            total += list->items.floats[i];
+        return FLOAT_VAL(total);
+    }
 
+    Value total = start;
+    for (int i = 0; i < list->size; i++) {
+        total = valueAdd(total, listGet(list, i));
+        if (isInstance(total, TYPE_CLASS(exception)))
+            return total;
+    }
+    return total;
 }
 
 long long List_Len(Value value) {
-    return AS_LIST(value)->vec.size;
+    return AS_LIST(value)->size;
 }
 
 bool List_ToBool(Value value) {
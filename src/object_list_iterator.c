@@ -6,9 +6,8 @@
 
 ObjListIterator *allocateListIterator(Value value) {
     ObjListIterator *iter = (ObjListIterator*)allocateObject(sizeof(ObjListIterator), VAL_LIST_ITERATOR);
-    ObjList *list = AS_LIST(value);
-    iter->current = list->vec.values;
-    iter->end = list->vec.values + list->vec.size;
+    iter->iterable = value;
+    iter->index = 0;
     return iter;
 }
 
@@ -18,11 +17,10 @@ Value ListIterator_Iter(Value value) {
 
 Value ListIterator_Next(Value value) {
     ObjListIterator *iter = AS_LIST_ITERATOR(value);
-    if (iter->current >= iter->end)
+    ObjList *list = AS_LIST(iter->iterable);
+    if (iter->index >= list->size)
         return createException(VAL_STOP_ITERATION, "");
-    Value res = *iter->current;
-    iter->current++;
-    return res;
+    return listGet(list, iter->index++);
 }
 
 Value ListIterator_Class(Value value) {
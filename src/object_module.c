@@ -8,14 +8,21 @@ ObjModule *allocateModule() {
     return module;
 }
 
+ObjModule *findBuiltinModule(const char *name, int length) {
+    Value module = tableGet(&vm.modules, OBJ_VAL(internString(name, length)));
+    if (IS_UNDEFINED(module))
+        return NULL;
+    return AS_MODULE(module);
+}
+
 Value Module_GetAttribute(Value obj, ObjString *name) {
     ObjModule *module = AS_MODULE(obj);
-    return tableGet(&module->globals, OBJ_VAL(name));
+    return String_Share(tableGet(&module->globals, OBJ_VAL(name)));
 }
 
 Value Module_Call(Value callee, int argc, int kwargc, Value *argv) {
 }
 
-int Module_ToStr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "<module '%s'>", AS_MODULE(value)->function->name->chars);
+void Module_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<module '%s'>", AS_MODULE(value)->function->name->chars);
 }
\ No newline at end of file
@@ -80,9 +80,10 @@ long long Range_Len(Value value) {
     return length > 0 ? length : 0;
 }
 
-int Range_ToStr(Value value, char *buffer, size_t size) {
+void Range_ToStr(Value value, Writer *writer) {
     ObjRange *range = AS_RANGE(value);
     if (range->step != 1)
-        return writeToBuffer(buffer, size, "range(%lld, %lld, %lld)", range->start, range->end, range->step);
-    return writeToBuffer(buffer, size, "range(%lld, %lld)", range->start, range->end);
+        writeFormat(writer, "range(%lld, %lld, %lld)", range->start, range->end, range->step);
+    else
+        writeFormat(writer, "range(%lld, %lld)", range->start, range->end);
 }
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "object_set.h"
+#include "object_set_iterator.h"
+#include "object_list.h"
+#include "object_tuple.h"
+#include "object_exception.h"
+#include "methods_set.h"
+#include "value_int.h"
+#include "vm.h"
+
+ObjSet *allocateSet(ValueType type) {
+    ObjSet *set = (ObjSet*)allocateObject(sizeof(ObjSet), type);
+    initHashSet(&set->set);
+    set->isHashed = false;
+    set->hash = 0;
+    return set;
+}
+
+// Set elements must be hashable; anything else is a TypeError instead of a
+// fatal error in valueHash.
+Value expectHashable(Value value) {
+    Value part = findUnhashable(value);
+    if (!IS_UNDEFINED(part))
+        return createException(VAL_TYPE_ERROR, "unhashable type: '%s'", getValueType(part));
+    return value;
+}
+
+static Value addValue(ObjSet *set, Value value) {
+    Value res = expectHashable(value);
+    if (!isInstance(res, TYPE_CLASS(exception)))
+        hashSetAdd(&set->set, value);
+    return res;
+}
+
+static Value addValues(ObjSet *set, Value *values, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        Value res = addValue(set, values[i]);
+        if (isInstance(res, TYPE_CLASS(exception)))
+            return res;
+    }
+    return NONE_VAL;
+}
+
+static void addAll(ObjSet *dest, ObjSet *source) {
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(&source->set, &index)) != NULL)
+        hashSetAddEntry(&dest->set, entry);
+}
+
+// Builds a set of the given type from any iterable. Sets, lists and tuples are
+// walked directly; anything else goes through the iterator protocol.
+Value setFromIterable(ValueType type, Value iterable) {
+    ObjSet *set = allocateSet(type);
+
+    if (IS_ANY_SET(iterable)) {
+        addAll(set, AS_SET(iterable));
+    } else if (IS_LIST(iterable)) {
+        ObjList *list = AS_LIST(iterable);
+        for (int i = 0; i < list->size; i++) {
+            Value res = addValue(set, listGet(list, i));
+            if (isInstance(res, TYPE_CLASS(exception)))
+                return res;
+        }
+    } else if (IS_TUPLE(iterable)) {
+        Value res = addValues(set, AS_TUPLE(iterable)->values, AS_TUPLE(iterable)->size);
+        if (isInstance(res, TYPE_CLASS(exception)))
+            return res;
+    } else {
+        Value iterator = valueIter(iterable);
+        if (isInstance(iterator, TYPE_CLASS(exception)))
+            return iterator;
+
+        while (true) {
+            Value item = valueNext(iterator);
+            if (item.type == VAL_STOP_ITERATION)
+                break;
+            if (isInstance(item, TYPE_CLASS(exception)))
+                return item;
+            Value res = addValue(set, item);
+            if (isInstance(res, TYPE_CLASS(exception)))
+                return res;
+        }
+    }
+    return OBJ_VAL(set);
+}
+
+static bool isSubset(ObjSet *a, ObjSet *b) {
+    if (a->set.size > b->set.size)
+        return false;
+
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(&a->set, &index)) != NULL) {
+        if (!hashSetContainsEntry(&b->set, entry))
+            return false;
+    }
+    return true;
+}
+
+Value Set_Equal(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    return BOOL_VAL(AS_SET(a)->set.size == AS_SET(b)->set.size && isSubset(AS_SET(a), AS_SET(b)));
+}
+
+Value Set_NotEqual(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    return BOOL_VAL(!AS_BOOL(Set_Equal(a, b)));
+}
+
+Value Set_Greater(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    return BOOL_VAL(AS_SET(a)->set.size > AS_SET(b)->set.size && isSubset(AS_SET(b), AS_SET(a)));
+}
+
+Value Set_GreaterEqual(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    return BOOL_VAL(isSubset(AS_SET(b), AS_SET(a)));
+}
+
+Value Set_Less(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    return BOOL_VAL(AS_SET(a)->set.size < AS_SET(b)->set.size && isSubset(AS_SET(a), AS_SET(b)));
+}
+
+Value Set_LessEqual(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    return BOOL_VAL(isSubset(AS_SET(a), AS_SET(b)));
+}
+
+// Entries of `source` that are (or are not) in `other`, added to `dest`.
+static void addFiltered(ObjSet *dest, ObjSet *source, ObjSet *other, bool present) {
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(&source->set, &index)) != NULL) {
+        if (hashSetContainsEntry(&other->set, entry) == present)
+            hashSetAddEntry(&dest->set, entry);
+    }
+}
+
+Value Set_Subtract(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjSet *result = allocateSet(a.type);
+    addFiltered(result, AS_SET(a), AS_SET(b), false);
+    return OBJ_VAL(result);
+}
+
+Value Set_And(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjSet *result = allocateSet(a.type);
+    ObjSet *smaller = AS_SET(a)->set.size <= AS_SET(b)->set.size ? AS_SET(a) : AS_SET(b);
+    ObjSet *larger = smaller == AS_SET(a) ? AS_SET(b) : AS_SET(a);
+    addFiltered(result, smaller, larger, true);
+    return OBJ_VAL(result);
+}
+
+Value Set_Xor(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjSet *result = allocateSet(a.type);
+    addFiltered(result, AS_SET(a), AS_SET(b), false);
+    addFiltered(result, AS_SET(b), AS_SET(a), false);
+    return OBJ_VAL(result);
+}
+
+Value Set_Or(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjSet *result = allocateSet(a.type);
+    addAll(result, AS_SET(a));
+    addAll(result, AS_SET(b));
+    return OBJ_VAL(result);
+}
+
+// In-place variants are only installed on set; a frozenset falls back to the
+// operators above and gets rebound to a new object.
+Value Set_InplaceSubtract(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjSet *set = AS_SET(a);
+    if (set == AS_SET(b)) {
+        freeHashSet(&set->set);
+        return a;
+    }
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(&AS_SET(b)->set, &index)) != NULL)
+        hashSetRemoveEntry(&set->set, entry);
+    return a;
+}
+
+Value Set_InplaceAnd(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjSet *set = AS_SET(a);
+    HashSet kept;
+    initHashSet(&kept);
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(&set->set, &index)) != NULL) {
+        if (hashSetContainsEntry(&AS_SET(b)->set, entry))
+            hashSetAddEntry(&kept, entry);
+    }
+    freeHashSet(&set->set);
+    set->set = kept;
+    return a;
+}
+
+Value Set_InplaceXor(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    ObjSet *set = AS_SET(a);
+    if (set == AS_SET(b)) {
+        freeHashSet(&set->set);
+        return a;
+    }
+    size_t index = 0;
+    SetEntry *entry;
+    while ((entry = hashSetNext(&AS_SET(b)->set, &index)) != NULL) {
+        if (!hashSetRemoveEntry(&set->set, entry))
+            hashSetAddEntry(&set->set, entry);
+    }
+    return a;
+}
+
+Value Set_InplaceOr(Value a, Value b) {
+    if (!IS_ANY_SET(b))
+        return NOT_IMPLEMENTED_VAL;
+    addAll(AS_SET(a), AS_SET(b));
+    return a;
+}
+
+Value Set_Contains(Value a, Value b) {
+    Value res = expectHashable(b);
+    if (isInstance(res, TYPE_CLASS(exception)))
+        return res;
+    return BOOL_VAL(hashSetContains(&AS_SET(a)->set, b));
+}
+
+Value Set_Init(Value callee, int argc, Value *argv) {
+    (void)callee;
+    if (argc > 1)
+        return createException(VAL_TYPE_ERROR, "set expected at most 1 argument, got %d", argc);
+    if (argc == 0)
+        return OBJ_VAL(allocateSet(VAL_SET));
+    return setFromIterable(VAL_SET, argv[0]);
+}
+
+Value Set_Class(Value value) {
+    (void)value;
+    return TYPE_CLASS(set);
+}
+
+Value Set_Iter(Value value) {
+    return OBJ_VAL(allocateSetIterator(value));
+}
+
+Value Set_GetAttr(Value value, ObjString *name) {
+    return getStaticAttribute(value, name, in_set_set);
+}
+
+long long Set_Len(Value value) {
+    return AS_SET(value)->set.size;
+}
+
+bool Set_ToBool(Value value) {
+    return Set_Len(value);
+}
+
+void Set_ToStr(Value value, Writer *writer) {
+    const char *name = IS_FROZENSET(value) ? "frozenset" : "set";
+
+    if (AS_SET(value)->set.size == 0) {
+        writeFormat(writer, "%s()", name);
+        return;
+    }
+
+    writeCString(writer, IS_FROZENSET(value) ? "frozenset({" : "{");
+
+    size_t index = 0;
+    SetEntry *entry;
+    for (int i = 0; (entry = hashSetNext(&AS_SET(value)->set, &index)) != NULL; i++) {
+        if (i != 0)
+            writeChars(writer, ", ", 2);
+        valueReprWrite(entry->key, writer);
+    }
+
+    writeCString(writer, IS_FROZENSET(value) ? "})" : "}");
+}
@@ -0,0 +1,29 @@
+#include "object_set_iterator.h"
+#include "object_set.h"
+#include "object.h"
+#include "object_exception.h"
+#include "vm.h"
+
+ObjSetIterator *allocateSetIterator(Value value) {
+    ObjSetIterator *iter = (ObjSetIterator*)allocateObject(sizeof(ObjSetIterator), VAL_SET_ITERATOR);
+    iter->iterable = value;
+    iter->index = 0;
+    return iter;
+}
+
+Value SetIterator_Iter(Value value) {
+    return value;
+}
+
+Value SetIterator_Next(Value value) {
+    ObjSetIterator *iter = AS_SET_ITERATOR(value);
+    SetEntry *entry = hashSetNext(&AS_SET(iter->iterable)->set, &iter->index);
+    if (entry != NULL)
+        return entry->key;
+    return createException(VAL_STOP_ITERATION, "");
+}
+
+Value SetIterator_Class(Value value) {
+    (void)value;
+    return TYPE_CLASS(setIterator);
+}
@@ -13,44 +13,52 @@ ObjSlice *allocateSlice(Value start, Value stop, Value step) {
     return slice;
 }
 
-ParsedSlice parseSlice(ObjSlice *slice, long long length) {
-    ParsedSlice result;
-
-    if (IS_NONE(slice->start))
-        result.start = 0;
-    else {
-        int index = calculateIndex(valueToInt(slice->start), length);
-        if (index == -1)
-            result.start = 0;
-        else if (index == -2)
-            result.start = length;
-        else
-            result.start = index;
+// Clamps one bound the way slice.indices() does: negative indices count from
+// the end, and anything out of range sticks to the nearest end for the
+// direction of travel.
+static long long clampBound(long long index, long long length, long long lower, long long upper) {
+    if (index < 0) {
+        index += length;
+        if (index < lower)
+            index = lower;
+    } else if (index > upper) {
+        index = upper;
     }
+    return index;
+}
 
-    if (IS_NONE(slice->stop))
-        result.stop = length;
-    else {
-        int index = calculateIndex(valueToInt(slice->stop), length);
-        if (index == -1)
-            result.stop = 0;
-        else if (index == -2)
-            result.stop = length;
-        else
-            result.stop = index;
-    }
+ParsedSlice resolveSlice(Value start, Value stop, Value step, long long length) {
+    ParsedSlice result = {0, 0, 0, 0};
+
+    result.step = IS_NONE(step) ? 1 : valueToInt(step);
+    if (result.step == 0)
+        return result;
+
+    long long lower = result.step > 0 ? 0 : -1;
+    long long upper = result.step > 0 ? length : length - 1;
+
+    if (IS_NONE(start))
+        result.start = result.step > 0 ? lower : upper;
+    else
+        result.start = clampBound(valueToInt(start), length, lower, upper);
 
-    if (IS_NONE(slice->step))
-        result.step = 1;
+    if (IS_NONE(stop))
+        result.stop = result.step > 0 ? upper : lower;
     else
-        result.step = valueToInt(slice->step);
-    
-    if (result.step != 0)
-        result.length = (result.stop - result.start + result.step - (result.step > 0 ? 1 : -1)) / (result.step > 0 ? result.step : -result.step);
-    
+        result.stop = clampBound(valueToInt(stop), length, lower, upper);
+
+    if (result.step > 0 && result.start < result.stop)
+        result.length = (result.stop - result.start - 1) / result.step + 1;
+    else if (result.step < 0 && result.start > result.stop)
+        result.length = (result.start - result.stop - 1) / -result.step + 1;
+
     return result;
 }
 
+ParsedSlice parseSlice(ObjSlice *slice, long long length) {
+    return resolveSlice(slice->start, slice->stop, slice->step, length);
+}
+
 Value Slice_Equal(Value a, Value b) {
     ObjSlice *s1 = AS_SLICE(a);
     ObjSlice *s2 = AS_SLICE(b);
@@ -79,6 +87,13 @@ Value Slice_GetAttr(Value list, ObjString *name) {
     return getStaticAttribute(list, name, in_slice_set);
 }
 
-int Slice_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "slice(%s, %s, %s)", valueToStr(AS_SLICE(value)->start)->chars, valueToStr(AS_SLICE(value)->stop)->chars, valueToStr(AS_SLICE(value)->step)->chars);
+void Slice_ToStr(Value value, Writer *writer) {
+    ObjSlice *slice = AS_SLICE(value);
+    writeCString(writer, "slice(");
+    valueReprWrite(slice->start, writer);
+    writeChars(writer, ", ", 2);
+    valueReprWrite(slice->stop, writer);
+    writeChars(writer, ", ", 2);
+    valueReprWrite(slice->step, writer);
+    writeChar(writer, ')');
 }
\ No newline at end of file
@@ -9,27 +9,89 @@
 #include "object_class.h"
 #include "methods_string.h"
 #include "object_slice.h"
+#include "object_tuple.h"
+#include "object_dict.h"
+#include "name_table.h"
+#include "hash.h"
+#include "string_search.h"
+#include "string_format.h"
+#include "utf8.h"
+#include "memory.h"
 #include "vm.h"
 
-ObjString *allocateString(size_t length) {
-    size_t size = sizeof(ObjString) + length + 1;
-    ObjString *string = (ObjString*)allocateObject(size, VAL_STRING);
+static ObjString *initString(ObjString *string, size_t length) {
     string->chars[length] = '\0';
     string->isInterned = false;
     string->isHashed = false;
+    string->isBuilder = false;
     string->length = length;
+    string->capacity = length;
+    string->codePoints = -1;
+    string->offsets = NULL;
+    string->formatTemplate = NULL;
     return string;
 }
 
+ObjString *allocateString(size_t length) {
+    size_t size = sizeof(ObjString) + length + 1;
+    return initString((ObjString*)allocateObject(size, VAL_STRING), length);
+}
+
+ObjString *allocateImmortalString(size_t length) {
+    size_t size = sizeof(ObjString) + length + 1;
+    return initString((ObjString*)allocateImmortalObject(size, VAL_STRING), length);
+}
+
+// "" and every single-byte string are interned once at startup, and each
+// producer of such a string returns the shared object, so loops over the
+// characters of a string do not allocate.
+void initCharacterStrings() {
+    vm.emptyString = internImmortalString("", 0);
+    for (int c = 0; c < 256; c++) {
+        char byte = (char)c;
+        vm.characters[c] = internImmortalString(&byte, 1);
+    }
+}
+
 ObjString *copyString(const char *chars, size_t length) {
     if (length == 0)
         length = strlen(chars);
+    if (length == 1)
+        return CHARACTER_STRING(chars[0]);
+    if (length == 0)
+        return EMPTY_STRING();
     ObjString *string = allocateString(length);
     memcpy(string->chars, chars, length);
     string->chars[string->length] = '\0';
     return string;
 }
 
+static ObjString *intern(const char *chars, size_t length, bool immortal) {
+    uint64_t hash = hashBytes(chars, length);
+    ObjString *interned = nameTableFindString(&vm.strings, chars, length, hash);
+    if (interned != NULL)
+        return interned;
+
+    ObjString *string = immortal ? allocateImmortalString(length) : allocateString(length);
+    memcpy(string->chars, chars, length);
+    string->hash = hash;
+    string->isHashed = true;
+    string->isInterned = true;
+
+    push(STRING_VAL(string));
+    nameTableSet(&vm.strings, string, NONE_VAL);
+    pop();
+    return string;
+}
+
+ObjString *internString(const char *chars, size_t length) {
+    return intern(chars, length, false);
+}
+
+ObjString *internImmortalString(const char *chars, size_t length) {
+    return intern(chars, length, true);
+}
+
 static char convertToEscapeChar(char c) {
     switch (c) {
         case 'a':
@@ -76,12 +138,85 @@ static int resolveEscapeSequence(const char *source, int sourceLength, char *des
 }
 
 ObjString *copyEscapedString(const char *chars, size_t length) {
-    ObjString *string = allocateString(length);
+    ObjString *string = allocateImmortalString(length);
     string->length = resolveEscapeSequence(chars, length, string->chars);
+    String_Hash(STRING_VAL(string));
     return string;
 }
 
+int stringCodePoints(ObjString *string) {
+    if (string->codePoints < 0)
+        string->codePoints = countCodePoints(string->chars, string->length);
+    return string->codePoints;
+}
+
+bool stringIsAscii(ObjString *string) {
+    return stringCodePoints(string) == string->length;
+}
+
+void freeStringIndex(ObjString *string) {
+    if (string->offsets != NULL)
+        FREE_VEC(int, string->offsets, string->codePoints / STRING_INDEX_STRIDE + 1);
+    string->offsets = NULL;
+    string->codePoints = -1;
+}
+
+void freeStringFormat(ObjString *string) {
+    freeFormatTemplate(string->formatTemplate);
+    string->formatTemplate = NULL;
+}
+
+static void buildStringIndex(ObjString *string) {
+    int count = string->codePoints / STRING_INDEX_STRIDE + 1;
+    int *offsets = ALLOCATE(int, count);
+    int offset = 0;
+    for (int i = 0; i < count; i++) {
+        offsets[i] = offset;
+        for (int j = 0; j < STRING_INDEX_STRIDE && offset < string->length; j++)
+            offset = nextCodePoint(string->chars, string->length, offset);
+    }
+    string->offsets = offsets;
+}
+
+// Byte offset of code point `index`, which may be one past the last.
+int stringByteOffset(ObjString *string, int index) {
+    if (stringIsAscii(string))
+        return index;
+    if (index >= string->codePoints)
+        return string->length;
+    if (string->offsets == NULL)
+        buildStringIndex(string);
+
+    int offset = string->offsets[index / STRING_INDEX_STRIDE];
+    for (int i = index % STRING_INDEX_STRIDE; i > 0; i--)
+        offset = nextCodePoint(string->chars, string->length, offset);
+    return offset;
+}
+
+// Code point index of the byte offset, which must start a code point or be the
+// length.
+int stringCodePointIndex(ObjString *string, int offset) {
+    if (stringIsAscii(string))
+        return offset;
+    if (string->offsets == NULL)
+        buildStringIndex(string);
+
+    int low = 0;
+    int high = string->codePoints / STRING_INDEX_STRIDE;
+    while (low < high) {
+        int middle = (low + high + 1) / 2;
+        if (string->offsets[middle] <= offset)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    int base = string->offsets[low];
+    return low * STRING_INDEX_STRIDE + countCodePoints(string->chars + base, offset - base);
+}
+
 static bool compareStrings(ObjString *a, ObjString *b) {
+    if (a == b)
+        return true;
     if (a->length != b->length)
         return false;
     if (a->isInterned && b->isInterned)
@@ -125,6 +260,14 @@ Value String_LessEqual(Value a, Value b) {
     return NOT_IMPLEMENTED_VAL;
 }
 
+// Keeps a known code point count across concatenation, so appending ASCII to
+// ASCII never rescans.
+static int sumCodePoints(ObjString *a, ObjString *b) {
+    if (a->codePoints < 0 || b->codePoints < 0)
+        return -1;
+    return a->codePoints + b->codePoints;
+}
+
 Value String_Add(Value a, Value b) {
     if (!IS_STRING(b))
         return NOT_IMPLEMENTED_VAL;
@@ -135,6 +278,7 @@ Value String_Add(Value a, Value b) {
     int length = s1->length + s2->length;
 
     ObjString *result = allocateString(length);
+    result->codePoints = sumCodePoints(s1, s2);
 
     memcpy(result->chars, s1->chars, s1->length);
     memcpy(result->chars + s1->length, s2->chars, s2->length);
@@ -142,15 +286,81 @@ Value String_Add(Value a, Value b) {
     return STRING_VAL(result);
 }
 
+// `x += y` on a variable, see ObjString. Growing geometrically makes a loop of
+// appends linear overall.
+Value String_Concat(Value a, Value b) {
+    ObjString *left = AS_STRING(a);
+    ObjString *right = AS_STRING(b);
+    size_t length = (size_t)left->length + right->length;
+
+    int codePoints = sumCodePoints(left, right);
+
+    bool claimed = vm.claimedBuilder == left;
+    vm.claimedBuilder = NULL;
+    if (claimed && length <= (size_t)left->capacity) {
+        memcpy(left->chars + left->length, right->chars, right->length);
+        left->length = length;
+        left->chars[length] = '\0';
+        left->isHashed = false;
+        freeStringIndex(left);
+        freeStringFormat(left);
+        left->codePoints = codePoints;
+        left->isBuilder = true;
+        return a;
+    }
+
+    size_t capacity = length < 8 ? 16 : length * 2;
+    if (exceedsHeapLimit(capacity))
+        capacity = length;
+    if (exceedsHeapLimit(length))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    ObjString *result = initString((ObjString*)allocateObject(sizeof(ObjString) + capacity + 1, VAL_STRING), length);
+    result->capacity = capacity;
+    result->codePoints = codePoints;
+    result->isBuilder = true;
+    memcpy(result->chars, left->chars, left->length);
+    memcpy(result->chars + left->length, right->chars, right->length);
+    return OBJ_VAL(result);
+}
+
+// Called on every read that may hand out a second reference to a builder.
+Value String_Share(Value value) {
+    if (IS_STRING(value)) {
+        AS_STRING(value)->isBuilder = false;
+        if (vm.claimedBuilder == AS_STRING(value))
+            vm.claimedBuilder = NULL;
+    }
+    return value;
+}
+
+// The read of `x += y`. The builder leaves the variable until the concat, so
+// a nested `+=` on the same variable while y is evaluated copies instead of
+// appending to it, and any other read in between revokes the claim.
+Value String_Claim(Value value) {
+    ObjString *string = IS_STRING(value) ? AS_STRING(value) : NULL;
+    vm.claimedBuilder = string != NULL && string->isBuilder ? string : NULL;
+    if (string != NULL)
+        string->isBuilder = false;
+    return value;
+}
+
 Value String_Multiply(Value a, Value b) {
     if (!IS_INT(b))
         return NOT_IMPLEMENTED_VAL;
     
     ObjString *string = AS_STRING(a);
     long long scalar = AS_INT(b);
+    if (scalar < 0)
+        scalar = 0;
 
     size_t oldLength = string->length;
     size_t newLength = oldLength * scalar;
+    if (exceedsHeapLimit(newLength))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    if (newLength <= 1)
+        return newLength == 0 ? STRING_VAL(EMPTY_STRING()) : a;
 
     ObjString *result = allocateString(newLength);
 
@@ -164,18 +374,28 @@ Value String_RightMultiply(Value a, Value b) {
     return String_Multiply(a, b);
 }
 
+// printf-style formatting. A tuple supplies the arguments in order, a dict
+// the `%(name)s` keys, and anything else is the only argument.
+Value String_Modulo(Value a, Value b) {
+    FormatArgs args = {
+        .positional = &b,
+        .positionalCount = 1,
+        .mapping = IS_DICT(b) ? b : UNDEFINED_VAL,
+    };
+    if (IS_TUPLE(b)) {
+        args.positional = AS_TUPLE(b)->values;
+        args.positionalCount = AS_TUPLE(b)->size;
+    }
+    return formatTemplate(AS_STRING(a), TEMPLATE_PERCENT, &args);
+}
+
 Value String_Contains(Value a, Value b) {
     if (!IS_STRING(b))
         return createException(VAL_TYPE_ERROR, "'in <string>' requires string as left operand, not %s", getValueType(b));
 
     ObjString *s1 = AS_STRING(a);
     ObjString *s2 = AS_STRING(b);
-
-    for (int offset = 0; offset <= s1->length - s2->length; offset++) {
-        if (strncmp(s1->chars + offset, s2->chars, s2->length) == 0)
-            return BOOL_VAL(true);
-    }
-    return BOOL_VAL(false);
+    return BOOL_VAL(findSubstring(s1->chars, s1->length, s2->chars, s2->length) >= 0);
 }
 
 Value String_Class(Value value) {
@@ -183,7 +403,9 @@ Value String_Class(Value value) {
 }
 
 Value String_Init(Value callee, int argc, Value *argv) {
-    return OBJ_VAL(valueToStr(argv[0]));
+    if (argc == 0)
+        return STRING_VAL(EMPTY_STRING());
+    return STRING_VAL(valueToStr(argv[0]));
 }
 
 Value String_Iter(Value value) {
@@ -194,73 +416,97 @@ Value String_GetAttribute(Value value, ObjString *name) {
     return getStaticAttribute(value, name, in_string_set);
 }
 
+// Copies the code points starting at byte offsets [from, to); a piece of an
+// ASCII string is ASCII too.
+Value substring(ObjString *string, int from, int to) {
+    if (to - from == 1)
+        return STRING_VAL(CHARACTER_STRING(string->chars[from]));
+    if (to == from)
+        return STRING_VAL(EMPTY_STRING());
+    ObjString *res = allocateString(to - from);
+    memcpy(res->chars, string->chars + from, to - from);
+    if (string->codePoints == string->length)
+        res->codePoints = res->length;
+    return OBJ_VAL(res);
+}
+
 Value String_GetItem(Value value, Value key) {
     if (IS_INT(key)) {
-        int index = calculateIndex(AS_INT(key), AS_STRING(value)->length);
+        ObjString *string = AS_STRING(value);
+        int index = calculateIndex(AS_INT(key), stringCodePoints(string));
         if (index < 0)
             return createException(VAL_INDEX_ERROR, "string index out of range");
-        
-        ObjString *res = copyString(AS_STRING(value)->chars + index, 1);
-        return OBJ_VAL(res);
+
+        int offset = stringByteOffset(string, index);
+        return substring(string, offset, nextCodePoint(string->chars, string->length, offset));
     } else if (IS_SLICE(key)) {
-        ParsedSlice slice = parseSlice(AS_SLICE(key), AS_STRING(value)->length);
-        if (slice.step == 0)
-            return createException(VAL_VALUE_ERROR, "slice step cannot be zero");
+        ObjSlice *slice = AS_SLICE(key);
+        return String_GetSlice(value, slice->start, slice->stop, slice->step);
+    }
+    return createException(VAL_TYPE_ERROR, "string indices must be integers, not '%s'", getValueType(key));
+}
 
-        ObjString *res = allocateString(slice.length);
+Value String_GetSlice(Value value, Value start, Value stop, Value step) {
+    ObjString *string = AS_STRING(value);
+    int codePoints = stringCodePoints(string);
+    ParsedSlice slice = resolveSlice(start, stop, step, codePoints);
+    if (slice.step == 0)
+        return createException(VAL_VALUE_ERROR, "slice step cannot be zero");
+
+    // Strings are immutable, so a slice covering all of it is the string itself.
+    if (slice.step == 1 && slice.length == codePoints)
+        return value;
+
+    if (slice.step == 1) {
+        int from = stringByteOffset(string, slice.start);
+        return substring(string, from, stringByteOffset(string, slice.start + slice.length));
+    }
 
-        if (slice.step > 0) {
-            for (int i = slice.start, j = 0; i < slice.stop; i += slice.step, j++) {
-                res->chars[j] = AS_STRING(value)->chars[i];
-            }
-        } else {
-            for (int i = slice.stop - 1, j = 0; i >= slice.start; i += slice.step, j++) {
-                res->chars[j] = AS_STRING(value)->chars[i];
-            }
-        }
+    if (slice.length <= 1)
+        return slice.length == 0 ? STRING_VAL(EMPTY_STRING()) : String_GetItem(value, INT_VAL(slice.start));
+
+    if (stringIsAscii(string)) {
+        ObjString *res = allocateString(slice.length);
+        for (long long i = slice.start, j = 0; j < slice.length; i += slice.step, j++)
+            res->chars[j] = string->chars[i];
+        res->codePoints = res->length;
         return OBJ_VAL(res);
     }
-    return createException(VAL_TYPE_ERROR, "string indices must be integers, not '%s'", getValueType(key));
-}
 
-static uint64_t hashString(const char *value) {
-    uint64_t hash = 0;
-    while (*value) {
-        hash = (hash * 31) + (unsigned char)(*value); 
-        value++;  
+    Writer writer;
+    initWriter(&writer);
+    for (long long i = slice.start, j = 0; j < slice.length; i += slice.step, j++) {
+        int offset = stringByteOffset(string, i);
+        writeChars(&writer, string->chars + offset, nextCodePoint(string->chars, string->length, offset) - offset);
     }
-    return hash;
+    ObjString *res = writerToString(&writer);
+    res->codePoints = slice.length;
+    return OBJ_VAL(res);
 }
 
 uint64_t String_Hash(Value value) {
     ObjString *string = AS_STRING(value);
     if (!string->isHashed) {
-        string->hash = hashString(string->chars);
+        string->hash = hashBytes(string->chars, string->length);
         string->isHashed = true;
     }
     return string->hash;
 }
 
 long long String_Len(Value value) {
-    return AS_STRING(value)->length;
+    return stringCodePoints(AS_STRING(value));
 }
 
 bool String_ToBool(Value value) {
-    return String_Len(value);
-}
-
-long long String_ToInt(Value value) {
-    return atoi(AS_CHARS(value));
-}
-
-double String_ToFloat(Value value) {
-    return atof(AS_CHARS(value));
+    return AS_STRING(value)->length != 0;
 }
 
-int String_ToStr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "%s", AS_CHARS(value));
+void String_ToStr(Value value, Writer *writer) {
+    writeChars(writer, AS_CHARS(value), AS_STRING(value)->length);
 }
 
-int String_ToRepr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "'%s'", AS_CHARS(value));
+void String_ToRepr(Value value, Writer *writer) {
+    writeChar(writer, '\'');
+    writeChars(writer, AS_CHARS(value), AS_STRING(value)->length);
+    writeChar(writer, '\'');
 }
\ No newline at end of file
@@ -1,11 +1,16 @@
+#include <string.h>
+
 #include "object_string_iterator.h"
 #include "object_string.h"
 #include "object_exception.h"
+#include "utf8.h"
 #include "vm.h"
 
 ObjStringIterator *allocateStringIterator(Value value) {
     ObjStringIterator *iter = (ObjStringIterator*)allocateObject(sizeof(ObjStringIterator), VAL_STRING_ITERATOR);
-    iter->current = AS_STRING(value)->chars;
+    iter->iterable = value;
+    iter->offset = 0;
+    return iter;
 }
 
 Value StringIterator_Iter(Value value) {
@@ -14,11 +19,13 @@ Value StringIterator_Iter(Value value) {
 
 Value StringIterator_Next(Value value) {
     ObjStringIterator *iter = AS_STRING_ITERATOR(value);
-    char res = *iter->current;
-    if (res == '\0')
+    ObjString *string = AS_STRING(iter->iterable);
+    if (iter->offset >= string->length)
         return createException(VAL_STOP_ITERATION, "");
-    iter->current++;
-    return OBJ_VAL(copyString(&res, 1));
+
+    int start = iter->offset;
+    iter->offset = nextCodePoint(string->chars, string->length, start);
+    return STRING_VAL(copyString(string->chars + start, iter->offset - start));
 }
 
 Value StringIterator_Class(Value value) {
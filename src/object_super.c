@@ -24,6 +24,6 @@ Value Super_GetAttr(Value value, ObjString *name) {
     return OBJ_VAL(createMethod(self, method));
 }
 
-int Super_ToStr(Value value, char *buffer, const size_t size) {
-    writeToBuffer(buffer, size, "<super: ");
+void Super_ToStr(Value value, Writer *writer) {
+    writeCString(writer, "<super: ");
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 
 #include "value_methods.h"
 #include "object_tuple.h"
@@ -11,7 +12,11 @@
 
 ObjTuple* allocateTuple(size_t size) {
     ObjTuple *tuple = (ObjTuple*)allocateObject(sizeof(ObjTuple) + size * sizeof(Value), VAL_TUPLE);
+    tuple->isHashed = false;
+    tuple->hash = 0;
     tuple->size = size;
+    for (size_t i = 0; i < size; i++)
+        tuple->values[i] = NONE_VAL;
     return tuple;
 }
 
@@ -93,6 +98,10 @@ Value Tuple_Multiply(Value a, Value b) {
     
     ObjTuple *tuple = AS_TUPLE(a);
     long long scalar = AS_INT(b);
+    if (scalar < 0)
+        scalar = 0;
+    if (exceedsHeapLimit(tuple->size * scalar * sizeof(Value)))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
 
     ObjTuple *result = allocateTuple(tuple->size * scalar);
 
@@ -124,27 +133,33 @@ Value Tuple_GetItem(Value obj, Value key) {
         
         return AS_TUPLE(obj)->values[index];
     } else if (IS_SLICE(key)) {
-        ParsedSlice slice = parseSlice(AS_SLICE(key), AS_TUPLE(obj)->size);
-        if (slice.step == 0)
-            return createException(VAL_VALUE_ERROR, "slice step cannot be zero");
-        
-        ObjTuple *result = allocateTuple(slice.length);
-
-        if (slice.step > 0) {
-            for (int i = slice.start, j = 0; i < slice.stop; i += slice.step, j++) {
-                result->values[j] = AS_TUPLE(obj)->values[i];
-            }
-        } else {
-            for (int i = slice.stop - 1, j = 0; i >= slice.start; i += slice.step, j++) {
-                result->values[j] = AS_TUPLE(obj)->values[i];
-            }
-        }
-        return OBJ_VAL(result);
+        ObjSlice *slice = AS_SLICE(key);
+        return Tuple_GetSlice(obj, slice->start, slice->stop, slice->step);
     }
     
     return createException(VAL_INDEX_ERROR, "tuple indices must be integers or slices, not %s", getValueType(key));
 }
 
+Value Tuple_GetSlice(Value obj, Value start, Value stop, Value step) {
+    ObjTuple *tuple = AS_TUPLE(obj);
+    ParsedSlice slice = resolveSlice(start, stop, step, tuple->size);
+    if (slice.step == 0)
+        return createException(VAL_VALUE_ERROR, "slice step cannot be zero");
+
+    // Tuples are immutable, so a slice covering all of it is the tuple itself.
+    if (slice.step == 1 && (size_t)slice.length == tuple->size)
+        return obj;
+
+    ObjTuple *result = allocateTuple(slice.length);
+    if (slice.step == 1) {
+        memcpy(result->values, tuple->values + slice.start, slice.length * sizeof(Value));
+    } else {
+        for (long long i = slice.start, j = 0; j < slice.length; i += slice.step, j++)
+            result->values[j] = tuple->values[i];
+    }
+    return OBJ_VAL(result);
+}
+
 Value Tuple_Class(Value value) {
     return TYPE_CLASS(tuple);
 }
@@ -192,30 +207,43 @@ long long Tuple_Len(Value value) {
     return AS_TUPLE(value)->size;
 }
 
-bool Tuple_ToBool(Value value) {
-    return Tuple_Len(value);
-}
+// xxHash-style combination of the element hashes, as in CPython.
+#define XXPRIME_1 11400714785074694791ULL
+#define XXPRIME_2 14029467366897019727ULL
+#define XXPRIME_5 2870177450012600261ULL
+#define XXROTATE(x) (((x) << 31) | ((x) >> 33))
 
-int Tuple_ToStr(Value value, char *buffer, size_t size) {
-    size_t bytesLeft = size;
-    int bytesWritten = writeToBuffer(buffer, bytesLeft, "(");
-    bytesLeft -= movePointer(&buffer, bytesWritten);
-    size_t length = AS_TUPLE(value)->size; 
+uint64_t Tuple_Hash(Value value) {
+    ObjTuple *tuple = AS_TUPLE(value);
+    if (tuple->isHashed)
+        return tuple->hash;
 
-    if (length == 1) {
-        bytesWritten = valueReprWrite(AS_TUPLE(value)->values[0], buffer, bytesLeft);
-        bytesLeft -= movePointer(&buffer, bytesWritten);
-        writeToBuffer(buffer, bytesLeft, ",)");
-        return 0;
+    uint64_t acc = XXPRIME_5;
+    for (size_t i = 0; i < tuple->size; i++) {
+        acc += valueHash(tuple->values[i]) * XXPRIME_2;
+        acc = XXROTATE(acc);
+        acc *= XXPRIME_1;
     }
+    acc += tuple->size ^ (XXPRIME_5 ^ 3527539ULL);
 
-    for (int i = 0; i < length; i++) {
-        bytesWritten = valueReprWrite(AS_TUPLE(value)->values[i], buffer, bytesLeft);
-        bytesLeft -= movePointer(&buffer, bytesWritten);
-        if (i + 1 != length) {
-            bytesWritten = writeToBuffer(buffer, bytesLeft, ", ");
-            bytesLeft -= movePointer(&buffer, bytesWritten);
-        }
+    tuple->hash = acc;
+    tuple->isHashed = true;
+    return acc;
+}
+
+bool Tuple_ToBool(Value value) {
+    return Tuple_Len(value);
+}
+
+void Tuple_ToStr(Value value, Writer *writer) {
+    ObjTuple *tuple = AS_TUPLE(value);
+    writeChar(writer, '(');
+    for (size_t i = 0; i < tuple->size; i++) {
+        if (i != 0)
+            writeChars(writer, ", ", 2);
+        valueReprWrite(tuple->values[i], writer);
     }
-    writeToBuffer(buffer, size, ")");
+    if (tuple->size == 1)
+        writeChar(writer, ',');
+    writeChar(writer, ')');
 }
\ No newline at end of file
@@ -6,8 +6,10 @@
 ObjTupleIterator *allocateTupleIterator(Value value) {
     ObjTupleIterator *iter = (ObjTupleIterator*)allocateObject(sizeof(ObjTupleIterator), VAL_TUPLE_ITERATOR);
     ObjTuple *tuple = AS_TUPLE(value);
+    iter->iterable = value;
     iter->current = tuple->values;
     iter->end = tuple->values + tuple->size;
+    return iter;
 }
 
 Value TupleIterator_Iter(Value value) {
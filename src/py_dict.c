@@ -50,11 +50,11 @@ Value PyDict_Items(int argc, int kwargc) {
 
     ObjList *list = allocateList(length);
 
+    size_t index = 0;
     for (int i = 0; i < length; i++) {
         ObjTuple *tuple = allocateTuple(2);
-        tuple->values[0] = AS_DICT(self)->table.order[i]->key;
-        tuple->values[1] = AS_DICT(self)->table.order[i]->value;
-        list->vec.values[i] = OBJ_VAL(tuple);
+        tableNext(&AS_DICT(self)->table, &index, &tuple->values[0], &tuple->values[1]);
+        list->items.values[i] = OBJ_VAL(tuple);
     }
     
     return OBJ_VAL(list);
@@ -67,10 +67,14 @@ Value PyDict_Keys(int argc, int kwargc) {
 
     long long length = Dict_Len(self);
 
-    ObjList *list = allocateList(length);
+    ObjList *list = allocateList(0);
 
-    for (int i = 0; i < length; i++)
-        list->vec.values[i] = AS_DICT(self)->table.order[i]->key;
+    size_t index = 0;
+    Value key, value;
+    for (int i = 0; i < length; i++) {
+        tableNext(&AS_DICT(self)->table, &index, &key, &value);
+        listAppend(list, key);
+    }
     
     return OBJ_VAL(list);
 }
@@ -97,17 +101,13 @@ Value PyDict_PopItem(int argc, int kwargc) {
     Value self;
     PARSE_ARGS(&self);
 
-    ObjDict *dict = AS_DICT(self);
-    if (dict->table.size == 0)
+    Value key, value;
+    if (!tablePopLast(&AS_DICT(self)->table, &key, &value))
         return createException(VAL_KEY_ERROR, "popitem(): dictionary is empty");
 
     ObjTuple *tuple = allocateTuple(2);
-    tuple->values[0] = dict->table.order[dict->table.size - 1]->key;
-    tuple->values[1] = dict->table.order[dict->table.size - 1]->value;
-
-    dict->table.order[dict->table.size - 1]->key = (Value){.type=VAL_UNDEFINED, .as.integer=1};
-    dict->table.order[dict->table.size - 1]->key = UNDEFINED_VAL;
-    dict->table.size--;
+    tuple->values[0] = key;
+    tuple->values[1] = value;
 
     return OBJ_VAL(tuple);
 }
@@ -140,13 +140,7 @@ Value PyDict_Update(int argc, int kwargc) {
     if (!IS_DICT(m))
         return createException(VAL_TYPE_ERROR, "expect dict");
     
-    ObjDict *dest = AS_DICT(self);
-    ObjDict *source = AS_DICT(m);
-
-    for (int i = 0; i < source->table.size; i++) {
-        Entry *entry = source->table.order[i];
-        tableSet(&dest->table, entry->key, entry->value);
-    }
+    dictUpdate(AS_DICT(self), AS_DICT(m));
     return NONE_VAL;
 }
 
@@ -157,10 +151,14 @@ Value PyDict_Values(int argc, int kwargc) {
 
     long long length = Dict_Len(self);
 
-    ObjList *list = allocateList(length);
+    ObjList *list = allocateList(0);
 
-    for (int i = 0; i < length; i++)
-        list->vec.values[i] = AS_DICT(self)->table.order[i]->value;
+    size_t index = 0;
+    Value key, value;
+    for (int i = 0; i < length; i++) {
+        tableNext(&AS_DICT(self)->table, &index, &key, &value);
+        listAppend(list, value);
+    }
     
     return OBJ_VAL(list);
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <string.h>
+
+#include "py_gc.h"
+#include "memory.h"
+#include "object_string.h"
+#include "object_tuple.h"
+#include "object_dict.h"
+#include "object_exception.h"
+#include "value_int.h"
+#include "value_float.h"
+#include "value_methods.h"
+#include "object_function.h"
+#include "vm.h"
+
+static void expectNoArgs(int argc, int kwargc) {
+    if (argc != 0 || kwargc != 0)
+        reportArityError(0, 0, argc + kwargc);
+}
+
+Value PyGC_Collect(int argc, int kwargc) {
+    expectNoArgs(argc, kwargc);
+    return INT_VAL(collectGarbage());
+}
+
+Value PyGC_Enable(int argc, int kwargc) {
+    expectNoArgs(argc, kwargc);
+    vm.gc.enabled = true;
+    return NONE_VAL;
+}
+
+Value PyGC_Disable(int argc, int kwargc) {
+    expectNoArgs(argc, kwargc);
+    vm.gc.enabled = false;
+    return NONE_VAL;
+}
+
+Value PyGC_IsEnabled(int argc, int kwargc) {
+    expectNoArgs(argc, kwargc);
+    return BOOL_VAL(vm.gc.enabled);
+}
+
+// Whether the collector manages value. Immortal objects (compile-time
+// literals, builtin names, natives) and unboxed values are not tracked.
+Value PyGC_IsTracked(int argc, int kwargc) {
+    static char *keywords[] = {"obj"};
+    Value obj;
+    PARSE_ARGS(&obj);
+
+    if (IS_UNDEFINED(obj))
+        return createException(VAL_TYPE_ERROR, "is_tracked() takes exactly one argument (0 given)");
+    return BOOL_VAL(isObject(obj) && !obj.as.object->isImmortal);
+}
+
+static void setStat(ObjDict *dict, const char *name, Value value) {
+    Dict_SetItem(OBJ_VAL(dict), OBJ_VAL(internImmortalString(name, strlen(name))), value);
+}
+
+Value PyGC_GetStats(int argc, int kwargc) {
+    expectNoArgs(argc, kwargc);
+
+    ObjDict *stats = allocateDict();
+    setStat(stats, "collections", INT_VAL(vm.gc.collections));
+    setStat(stats, "collected", INT_VAL(vm.gc.objectsFreed));
+    setStat(stats, "freed_bytes", INT_VAL(vm.gc.bytesFreed));
+    setStat(stats, "total_pause", FLOAT_VAL(vm.gc.totalPause));
+    setStat(stats, "max_pause", FLOAT_VAL(vm.gc.maxPause));
+    setStat(stats, "objects", INT_VAL(vm.objectCount));
+    setStat(stats, "heap_bytes", INT_VAL(vm.bytesAllocated));
+    setStat(stats, "next_collection", INT_VAL(vm.nextGC));
+    setStat(stats, "heap_limit", INT_VAL(vm.gc.heapLimit));
+    return OBJ_VAL(stats);
+}
+
+Value PyGC_GetThreshold(int argc, int kwargc) {
+    expectNoArgs(argc, kwargc);
+
+    ObjTuple *threshold = allocateTuple(2);
+    threshold->values[0] = INT_VAL(vm.gc.threshold);
+    threshold->values[1] = FLOAT_VAL(vm.gc.growFactor);
+    return OBJ_VAL(threshold);
+}
+
+Value PyGC_SetThreshold(int argc, int kwargc) {
+    static char *keywords[] = {"threshold", "grow_factor"};
+    Value threshold, growFactor;
+    PARSE_ARGS(&threshold, &growFactor);
+
+    if (!IS_INT(threshold))
+        return createException(VAL_TYPE_ERROR, "threshold must be int, not %s", getValueType(threshold));
+    if (AS_INT(threshold) < 0)
+        return createException(VAL_VALUE_ERROR, "threshold must be non-negative");
+
+    if (!IS_UNDEFINED(growFactor)) {
+        double factor;
+        if (IS_INT(growFactor))
+            factor = AS_INT(growFactor);
+        else if (IS_FLOAT(growFactor))
+            factor = AS_FLOAT(growFactor);
+        else
+            return createException(VAL_TYPE_ERROR, "grow_factor must be a number, not %s", getValueType(growFactor));
+        if (factor < 1)
+            return createException(VAL_VALUE_ERROR, "grow_factor must be at least 1");
+        vm.gc.growFactor = factor;
+    }
+
+    vm.gc.threshold = AS_INT(threshold);
+    vm.nextGC = vm.gc.threshold;
+    return NONE_VAL;
+}
+
+Value PyGC_GetDebug(int argc, int kwargc) {
+    expectNoArgs(argc, kwargc);
+    return INT_VAL(vm.gc.debug);
+}
+
+Value PyGC_SetDebug(int argc, int kwargc) {
+    static char *keywords[] = {"flags"};
+    Value flags;
+    PARSE_ARGS(&flags);
+
+    if (!IS_INT(flags))
+        return createException(VAL_TYPE_ERROR, "flags must be int, not %s", getValueType(flags));
+
+    vm.gc.debug = AS_INT(flags);
+    return NONE_VAL;
+}
+
+static void defineModuleNative(ObjModule *module, const char *name, NativeFn function) {
+    ObjNative *native = createNative(function, name);
+    tableSet(&module->globals, OBJ_VAL(internImmortalString(name, strlen(name))), OBJ_VAL(native));
+}
+
+ObjModule *createGCModule() {
+    ObjModule *module = allocateModule();
+    module->function = createFunction();
+    module->function->name = internImmortalString("gc", 2);
+    module->path = "<builtin>";
+    module->source = "";
+
+    defineModuleNative(module, "collect", PyGC_Collect);
+    defineModuleNative(module, "enable", PyGC_Enable);
+    defineModuleNative(module, "disable", PyGC_Disable);
+    defineModuleNative(module, "isenabled", PyGC_IsEnabled);
+    defineModuleNative(module, "is_tracked", PyGC_IsTracked);
+    defineModuleNative(module, "get_stats", PyGC_GetStats);
+    defineModuleNative(module, "get_threshold", PyGC_GetThreshold);
+    defineModuleNative(module, "set_threshold", PyGC_SetThreshold);
+    defineModuleNative(module, "get_debug", PyGC_GetDebug);
+    defineModuleNative(module, "set_debug", PyGC_SetDebug);
+    tableSet(&module->globals, OBJ_VAL(internImmortalString("DEBUG_STATS", 11)), INT_VAL(GC_DEBUG_STATS));
+    return module;
+}
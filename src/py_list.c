@@ -18,9 +18,7 @@ Value PyList_Clear(int argc, int kwargc) {
     Value self;
     PARSE_ARGS(&self);
 
-    ObjList *list = AS_LIST(self);
-    freeValueVec(&list->vec);
-    initValueVec(&list->vec);
+    listClear(AS_LIST(self));
 
     return NONE_VAL;
 }
@@ -30,13 +28,7 @@ Value PyList_Copy(int argc, int kwargc) {
     Value self;
     PARSE_ARGS(&self);
 
-    ObjList *list = AS_LIST(self);
-    ObjList *result = allocateList(list->vec.size);
-
-    for (int i = 0; i < list->vec.size; i++)
-        result->vec.values[i] = list->vec.values[i];
-    
-    return OBJ_VAL(result);
+    return OBJ_VAL(copyList(AS_LIST(self)));
 }
 
 Value PyList_Count(int argc, int kwargc) {
@@ -47,8 +39,8 @@ Value PyList_Count(int argc, int kwargc) {
     long long count = 0;
     ObjList *list = AS_LIST(self);
 
-    for (int i = 0; i < list->vec.size; i++)
-        count += valueToBool(valueEqual(list->vec.values[i], value));
+    for (int i = 0; i < list->size; i++)
+        count += valueToBool(valueEqual(listGet(list, i), value));
     
     return INT_VAL(count);
 }
@@ -58,16 +50,7 @@ Value PyList_Extend(int argc, int kwargc) {
     Value self, iterable;
     PARSE_ARGS(&self, &iterable);
 
-    ObjList *list = AS_LIST(self);
-    Value iterator = valueIter(iterable);
-    Value item = valueNext(iterator);
-
-    while (!isInstance(item, TYPE_CLASS(stopIteration))) {
-        List_Append(self, item);
-        item = valueNext(iterator);
-    }
-    
-    return NONE_VAL;
+    return List_Extend(self, iterable);
 }
 
 Value PyList_Index(int argc, int kwargc) {
@@ -85,12 +68,12 @@ Value PyList_Index(int argc, int kwargc) {
         istart = valueToInt(start);
     
     if (IS_UNDEFINED(stop))
-        istop = list->vec.size;
+        istop = list->size;
     else
         istop = valueToInt(stop);
 
     for (int i = istart; i < istop; i++) {
-        if (valueToBool(valueEqual(list->vec.values[i], value)))
+        if (valueToBool(valueEqual(listGet(list, i), value)))
             return INT_VAL(i);
     }
 
@@ -103,15 +86,15 @@ Value PyList_Insert(int argc, int kwargc) {
     PARSE_ARGS(&self, &index, &object);
 
     ObjList *list = AS_LIST(self);
-    long long i = calculateIndex(valueToInt(index), list->vec.size);
+    long long i = calculateIndex(valueToInt(index), list->size);
 
     if (i == -1)
         i = 0;
     
     if (i == -2)
-        i = list->vec.size;
+        i = list->size;
 
-    insertValue(&list->vec, i, object);
+    listInsert(list, i, object);
 
     return NONE_VAL;
 }
@@ -125,11 +108,11 @@ Value PyList_Pop(int argc, int kwargc) {
     long long i;
     
     if (IS_UNDEFINED(index))
-        i = list->vec.size - 1;
+        i = list->size - 1;
     else 
-        i = calculateIndex(AS_INT(index), list->vec.size);
+        i = calculateIndex(AS_INT(index), list->size);
 
-    Value result = list->vec.values[i];
+    Value result = listGet(list, i);
 
     List_DelItem(self, INT_VAL(i));
 
@@ -143,8 +126,8 @@ Value PyList_Remove(int argc, int kwargc) {
 
     ObjList *list = AS_LIST(self);
 
-    for (int i = 0; i < list->vec.size; i++) {
-        if (valueToBool(valueEqual(list->vec.values[i], value))) {
+    for (int i = 0; i < list->size; i++) {
+        if (valueToBool(valueEqual(listGet(list, i), value))) {
             List_DelItem(self, INT_VAL(i));
             return NONE_VAL;
         }
@@ -158,11 +141,15 @@ Value PyList_Reverse(int argc, int kwargc) {
     Value self;
     PARSE_ARGS(&self);
 
-    reverseValueVec(&AS_LIST(self)->vec);
+    listReverse(AS_LIST(self));
 
     return NONE_VAL;
 }
 
 Value PyList_Sort(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "list.sort is not implemented");
+    static char *keywords[] = {"self", "key", "reverse"};
+    Value self, key, reverse;
+    PARSE_ARGS(&self, &key, &reverse);
+
+    return List_Sort(self, key, !IS_UNDEFINED(reverse) && valueToBool(reverse));
 }
\ No newline at end of file
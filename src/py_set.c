@@ -0,0 +1,178 @@
+#include "py_set.h"
+#include "object_set.h"
+#include "value_int.h"
+#include "object_exception.h"
+#include "object_string.h"
+#include "object_tuple.h"
+#include "vm.h"
+
+// Methods accept any iterable where the operators insist on a set; the
+// argument is turned into a temporary frozenset first.
+static Value asSet(Value iterable) {
+    if (IS_ANY_SET(iterable))
+        return iterable;
+    return setFromIterable(VAL_FROZENSET, iterable);
+}
+
+#define SET_BINARY_METHOD(name, function)                  \
+Value name(int argc, int kwargc) {                         \
+    static char *keywords[] = {"self", "other"};           \
+    Value self, other;                                     \
+    PARSE_ARGS(&self, &other);                             \
+                                                           \
+    other = asSet(other);                                  \
+    if (!IS_ANY_SET(other))                                \
+        return other;                                      \
+    return function(self, other);                          \
+}
+
+// union, intersection and difference take any number of iterables and fold
+// the operator over them from the left; with none they return a copy.
+// Partial results stay on the stack, as turning an iterable into a set can
+// run user code.
+static Value foldSets(Value self, Value others, Value (*function)(Value, Value)) {
+    if (IS_UNDEFINED(others))
+        return setFromIterable(self.type, self);
+
+    ObjTuple *tuple = AS_TUPLE(others);
+    Value result = self;
+    push(others);
+    for (size_t i = 0; i < tuple->size; i++) {
+        push(result);
+        Value other = asSet(tuple->values[i]);
+        if (!IS_ANY_SET(other)) {
+            vm.top -= 2;
+            return other;
+        }
+        push(other);
+        result = function(result, other);
+        vm.top -= 2;
+        if (!IS_ANY_SET(result))
+            break;
+    }
+    pop();
+    return result;
+}
+
+#define SET_FOLD_METHOD(name, function)                    \
+Value name(int argc, int kwargc) {                         \
+    static char *keywords[] = {"self", "*others"};         \
+    Value self, others;                                    \
+    PARSE_ARGS(&self, &others);                            \
+                                                           \
+    return foldSets(self, others, function);               \
+}
+
+Value PySet_Add(int argc, int kwargc) {
+    static char *keywords[] = {"self", "element"};
+    Value self, element;
+    PARSE_ARGS(&self, &element);
+
+    Value res = expectHashable(element);
+    if (isInstance(res, TYPE_CLASS(exception)))
+        return res;
+    hashSetAdd(&AS_SET(self)->set, element);
+    return NONE_VAL;
+}
+
+Value PySet_Clear(int argc, int kwargc) {
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    freeHashSet(&AS_SET(self)->set);
+    return NONE_VAL;
+}
+
+Value PySet_Copy(int argc, int kwargc) {
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    if (IS_FROZENSET(self))
+        return self;
+    return setFromIterable(self.type, self);
+}
+
+SET_FOLD_METHOD(PySet_Difference, Set_Subtract)
+
+Value PySet_Discard(int argc, int kwargc) {
+    static char *keywords[] = {"self", "element"};
+    Value self, element;
+    PARSE_ARGS(&self, &element);
+
+    Value res = expectHashable(element);
+    if (isInstance(res, TYPE_CLASS(exception)))
+        return res;
+    hashSetRemove(&AS_SET(self)->set, element);
+    return NONE_VAL;
+}
+
+SET_FOLD_METHOD(PySet_Intersection, Set_And)
+
+Value PySet_IsDisjoint(int argc, int kwargc) {
+    static char *keywords[] = {"self", "other"};
+    Value self, other;
+    PARSE_ARGS(&self, &other);
+
+    other = asSet(other);
+    if (!IS_ANY_SET(other))
+        return other;
+    return BOOL_VAL(Set_Len(Set_And(self, other)) == 0);
+}
+
+SET_BINARY_METHOD(PySet_IsSubset, Set_LessEqual)
+
+SET_BINARY_METHOD(PySet_IsSuperset, Set_GreaterEqual)
+
+Value PySet_Pop(int argc, int kwargc) {
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    Value element;
+    if (!hashSetPop(&AS_SET(self)->set, &element))
+        return createException(VAL_KEY_ERROR, "pop from an empty set");
+    return element;
+}
+
+Value PySet_Remove(int argc, int kwargc) {
+    static char *keywords[] = {"self", "element"};
+    Value self, element;
+    PARSE_ARGS(&self, &element);
+
+    Value res = expectHashable(element);
+    if (isInstance(res, TYPE_CLASS(exception)))
+        return res;
+    if (!hashSetRemove(&AS_SET(self)->set, element))
+        return createException(VAL_KEY_ERROR, "%s", valueToStr(element)->chars);
+    return NONE_VAL;
+}
+
+SET_FOLD_METHOD(PySet_Union, Set_Or)
+
+Value PySet_Update(int argc, int kwargc) {
+    static char *keywords[] = {"self", "*others"};
+    Value self, others;
+    PARSE_ARGS(&self, &others);
+
+    if (IS_UNDEFINED(others))
+        return NONE_VAL;
+
+    ObjTuple *tuple = AS_TUPLE(others);
+    HashSet *set = &AS_SET(self)->set;
+    push(others);
+    for (size_t i = 0; i < tuple->size; i++) {
+        Value other = asSet(tuple->values[i]);
+        if (!IS_ANY_SET(other)) {
+            pop();
+            return other;
+        }
+        size_t index = 0;
+        SetEntry *entry;
+        while ((entry = hashSetNext(&AS_SET(other)->set, &index)) != NULL)
+            hashSetAddEntry(set, entry);
+    }
+    pop();
+    return NONE_VAL;
+}
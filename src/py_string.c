@@ -1,13 +1,295 @@
 #include <string.h>
-#include <ctype.h>
 
 #include "py_string.h"
 #include "object_string.h"
 #include "object_exception.h"
 #include "value_int.h"
 #include "value_float.h"
+#include "object_list.h"
+#include "object_tuple.h"
+#include "string_search.h"
+#include "string_scan.h"
+#include "string_format.h"
+#include "utf8.h"
+#include "memory.h"
 #include "vm.h"    
 
+// Strings of at most one byte map to the shared singletons.
+static Value mapShortString(ObjString *string, CaseMapping mapping) {
+    if (string->length == 0)
+        return STRING_VAL(EMPTY_STRING());
+    char c;
+    mapAsciiCase(&c, string->chars, 1, mapping);
+    return STRING_VAL(CHARACTER_STRING(c));
+}
+
+// Shared by upper, lower, swapcase and casefold. Only ASCII letters change.
+static Value mapCase(Value self, CaseMapping mapping) {
+    ObjString *string = AS_STRING(self);
+    if (string->length <= 1)
+        return mapShortString(string, mapping);
+
+    ObjString *res = allocateString(string->length);
+    mapAsciiCase(res->chars, string->chars, string->length, mapping);
+    return OBJ_VAL(res);
+}
+
+// Whether the string is non-empty and made only of bytes in the class.
+static Value allInClass(Value self, CharClass class) {
+    ObjString *string = AS_STRING(self);
+    size_t length = string->length;
+    return BOOL_VAL(length > 0 && spanClass(string->chars, length, class) == length);
+}
+
+// islower and isupper: at least one letter of the case and none of the other.
+static Value allCased(Value self, CharClass cased, CharClass uncased) {
+    ObjString *string = AS_STRING(self);
+    size_t length = string->length;
+    return BOOL_VAL(findClass(string->chars, length, uncased) == length && findClass(string->chars, length, cased) < length);
+}
+
+static Value expectInt(Value value) {
+    if (!IS_INT(value))
+        return createException(VAL_TYPE_ERROR, "'%s' object cannot be interpreted as an integer", getValueType(value));
+    return value;
+}
+
+static Value expectString(Value value) {
+    if (!IS_STRING(value))
+        return createException(VAL_TYPE_ERROR, "must be str, not %s", getValueType(value));
+    return value;
+}
+
+static Value expectIndex(Value value, long long *index) {
+    if (IS_UNDEFINED(value) || IS_NONE(value))
+        return NONE_VAL;
+    if (!IS_INT(value))
+        return createException(VAL_TYPE_ERROR, "slice indices must be integers or None");
+    *index = AS_INT(value);
+    return NONE_VAL;
+}
+
+// Resolves the optional start/end of the search family to byte offsets.
+// Unlike slicing, start is not clamped to the length, so a start past the end
+// finds nothing, not even the empty string.
+static Value searchBounds(ObjString *string, Value start, Value end, long long *from, long long *to) {
+    long long length = stringCodePoints(string);
+    *from = 0;
+    *to = length;
+
+    Value res = expectIndex(start, from);
+    if (IS_NONE(res))
+        res = expectIndex(end, to);
+    if (!IS_NONE(res))
+        return res;
+
+    if (*to > length)
+        *to = length;
+    else if (*to < 0 && (*to += length) < 0)
+        *to = 0;
+    if (*from < 0 && (*from += length) < 0)
+        *from = 0;
+
+    *to = stringByteOffset(string, *to);
+    *from = *from > length ? string->length + 1 : stringByteOffset(string, *from);
+    return NONE_VAL;
+}
+
+#define SEARCH_ARGS()                                                    \
+    Value res = expectString(sub);                                       \
+    if (!IS_STRING(res))                                                 \
+        return res;                                                      \
+    ObjString *string = AS_STRING(self);                                 \
+    ObjString *needle = AS_STRING(sub);                                  \
+    long long from, to;                                                  \
+    res = searchBounds(string, start, end, &from, &to);                  \
+    if (!IS_NONE(res))                                                   \
+        return res;
+
+static long long findIn(ObjString *string, ObjString *needle, long long from, long long to, bool reverse) {
+    if (to - from < needle->length)
+        return -1;
+    Searcher searcher;
+    initSearcher(&searcher, needle->chars, needle->length, reverse);
+    long long index = searchIn(&searcher, string->chars + from, to - from);
+    return index < 0 ? -1 : stringCodePointIndex(string, from + index);
+}
+
+// Shared by startswith and endswith, whose first argument is a str or a
+// tuple of them.
+static Value matchAffix(Value self, Value affix, Value start, Value end, bool suffix) {
+    const char *name = suffix ? "endswith" : "startswith";
+    Value *affixes = &affix;
+    size_t count = 1;
+    if (IS_TUPLE(affix)) {
+        affixes = AS_TUPLE(affix)->values;
+        count = AS_TUPLE(affix)->size;
+    } else if (!IS_STRING(affix)) {
+        return createException(VAL_TYPE_ERROR, "%s first arg must be str or a tuple of str, not %s", name, getValueType(affix));
+    }
+
+    ObjString *string = AS_STRING(self);
+    long long from, to;
+    Value res = searchBounds(string, start, end, &from, &to);
+    if (!IS_NONE(res))
+        return res;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!IS_STRING(affixes[i]))
+            return createException(VAL_TYPE_ERROR, "tuple for %s must only contain str, not %s", name, getValueType(affixes[i]));
+        ObjString *candidate = AS_STRING(affixes[i]);
+        if (to - from < candidate->length)
+            continue;
+        const char *at = string->chars + (suffix ? to - candidate->length : from);
+        if (memcmp(at, candidate->chars, candidate->length) == 0)
+            return BOOL_VAL(true);
+    }
+    return BOOL_VAL(false);
+}
+
+// Shared by partition and rpartition.
+static Value partitionString(Value self, Value sep, bool reverse) {
+    Value res = expectString(sep);
+    if (!IS_STRING(res))
+        return res;
+
+    ObjString *string = AS_STRING(self);
+    ObjString *separator = AS_STRING(sep);
+    if (separator->length == 0)
+        return createException(VAL_VALUE_ERROR, "empty separator");
+
+    Searcher searcher;
+    initSearcher(&searcher, separator->chars, separator->length, reverse);
+    long long index = searchIn(&searcher, string->chars, string->length);
+
+    ObjTuple *parts = allocateTuple(3);
+    Value empty = STRING_VAL(EMPTY_STRING());
+    if (index < 0) {
+        parts->values[0] = reverse ? empty : self;
+        parts->values[1] = empty;
+        parts->values[2] = reverse ? self : empty;
+    } else {
+        parts->values[0] = substring(string, 0, index);
+        parts->values[1] = sep;
+        parts->values[2] = substring(string, index + separator->length, string->length);
+    }
+    return OBJ_VAL(parts);
+}
+
+#define STRIP_LEFT  1
+#define STRIP_RIGHT 2
+
+// Whether the code point chars[0, length) is one of the strip characters.
+static bool inStripSet(ObjString *set, const char *chars, size_t length) {
+    if (length == 1)
+        return memchr(set->chars, chars[0], set->length) != NULL;
+    return findSubstring(set->chars, set->length, chars, length) >= 0;
+}
+
+// Shared by strip, lstrip and rstrip. Whitespace is skipped by the class
+// scanner; explicit characters are matched a code point at a time.
+static Value stripString(Value self, Value chars, int sides, const char *name) {
+    if (!IS_UNDEFINED(chars) && !IS_NONE(chars) && !IS_STRING(chars))
+        return createException(VAL_TYPE_ERROR, "%s arg must be None or str", name);
+
+    ObjString *string = AS_STRING(self);
+    int start = 0;
+    int end = string->length;
+
+    if (IS_UNDEFINED(chars) || IS_NONE(chars)) {
+        if (sides & STRIP_LEFT)
+            start = spanClass(string->chars, end, CLASS_SPACE);
+        if (sides & STRIP_RIGHT)
+            end -= rspanClass(string->chars + start, end - start, CLASS_SPACE);
+    } else {
+        ObjString *set = AS_STRING(chars);
+        while ((sides & STRIP_LEFT) && start < end) {
+            int next = nextCodePoint(string->chars, end, start);
+            if (!inStripSet(set, string->chars + start, next - start))
+                break;
+            start = next;
+        }
+        while ((sides & STRIP_RIGHT) && end > start) {
+            int previous = end - 1;
+            while (previous > start && IS_CONTINUATION_BYTE(string->chars[previous]))
+                previous--;
+            if (!inStripSet(set, string->chars + previous, end - previous))
+                break;
+            end = previous;
+        }
+    }
+
+    if (start == 0 && end == string->length)
+        return self;
+    return substring(string, start, end);
+}
+
+typedef enum {
+    ALIGN_LEFT,
+    ALIGN_RIGHT,
+    ALIGN_CENTER,
+} Alignment;
+
+// Shared by ljust, rjust and center. Widths count code points, and the fill
+// character may take several bytes.
+static Value justify(Value self, Value width, Value fillchar, Alignment alignment) {
+    Value res = expectInt(width);
+    if (!IS_INT(res))
+        return res;
+
+    const char *fill = " ";
+    int fillLength = 1;
+    if (!IS_UNDEFINED(fillchar)) {
+        if (!IS_STRING(fillchar))
+            return createException(VAL_TYPE_ERROR, "The fill character must be a unicode character, not %s", getValueType(fillchar));
+        if (stringCodePoints(AS_STRING(fillchar)) != 1)
+            return createException(VAL_TYPE_ERROR, "The fill character must be exactly one character long");
+        fill = AS_CHARS(fillchar);
+        fillLength = AS_STRING(fillchar)->length;
+    }
+
+    ObjString *string = AS_STRING(self);
+    long long pad = AS_INT(width) - stringCodePoints(string);
+    if (pad <= 0)
+        return self;
+
+    long long left;
+    switch (alignment) {
+        case ALIGN_LEFT:  left = 0; break;
+        case ALIGN_RIGHT: left = pad; break;
+        default:          left = pad / 2 + (pad & AS_INT(width) & 1); break;
+    }
+
+    long long length = string->length + pad * fillLength;
+    if (exceedsHeapLimit(length))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    ObjString *result = allocateString(length);
+    char *dest = result->chars;
+    for (long long i = 0; i < left; i++, dest += fillLength)
+        memcpy(dest, fill, fillLength);
+    memcpy(dest, string->chars, string->length);
+    dest += string->length;
+    for (long long i = left; i < pad; i++, dest += fillLength)
+        memcpy(dest, fill, fillLength);
+    return OBJ_VAL(result);
+}
+
+// Bytes taken by a line break at chars[i], or 0. Besides the ASCII breaks
+// these are U+0085, U+2028 and U+2029, as for splitlines.
+static int lineBreakAt(const char *chars, int length, int i) {
+    unsigned char c = chars[i];
+    if (c == '\r')
+        return i + 1 < length && chars[i + 1] == '\n' ? 2 : 1;
+    if (('\n' <= c && c <= '\f') || ('\x1c' <= c && c <= '\x1e'))
+        return 1;
+    if (c == 0xc2 && i + 1 < length && (unsigned char)chars[i + 1] == 0x85)
+        return 2;
+    if (c == 0xe2 && i + 2 < length && (unsigned char)chars[i + 1] == 0x80 && ((unsigned char)chars[i + 2] & 0xfe) == 0xa8)
+        return 3;
+    return 0;
+}
+
 Value PyString_Equal(int argc, int kwargc) {
     static char *keywords[] = {"self", "value"};
     Value self, value;
@@ -80,6 +362,14 @@ Value PyString_RightMultiply(int argc, int kwargc) {
     return String_RightMultiply(self, value);
 }
 
+Value PyString_Modulo(int argc, int kwargc) {
+    static char *keywords[] = {"self", "value"};
+    Value self, value;
+    PARSE_ARGS(&self, &value);
+
+    return String_Modulo(self, value);
+}
+
 Value PyString_Contains(int argc, int kwargc) {
     static char *keywords[] = {"self", "value"};
     Value self, value;
@@ -134,29 +424,51 @@ Value PyString_Capitalize(int argc, int kwargc) {
     PARSE_ARGS(&self);
 
     ObjString *string = AS_STRING(self);
-    ObjString *res = allocateString(string->length);
-
-    if (string->length == 0)
-        return OBJ_VAL(res);
-    
-    res->chars[0] = toupper(string->chars[0]);
+    if (string->length <= 1)
+        return mapShortString(string, CASE_UPPER);
 
-    for (int i = 1; i < res->length; i++)
-        res->chars[i] = tolower(string->chars[i]);
-    
+    ObjString *res = allocateString(string->length);
+    mapAsciiCase(res->chars, string->chars, 1, CASE_UPPER);
+    mapAsciiCase(res->chars + 1, string->chars + 1, string->length - 1, CASE_LOWER);
     return OBJ_VAL(res);
 }
 
 Value PyString_CaseFold(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.casefold is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return mapCase(self, CASE_LOWER);
 }
 
 Value PyString_Center(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.center is not implemented");
+    static char *keywords[] = {"self", "width", "fillchar"};
+    Value self, width, fillchar;
+    PARSE_ARGS(&self, &width, &fillchar);
+
+    return justify(self, width, fillchar, ALIGN_CENTER);
 }
 
 Value PyString_Count(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.count is not implemented");
+    static char *keywords[] = {"self", "sub", "start", "end"};
+    Value self, sub, start, end;
+    PARSE_ARGS(&self, &sub, &start, &end);
+    SEARCH_ARGS();
+
+    if (to - from < needle->length)
+        return INT_VAL(0);
+    if (needle->length == 0)
+        return INT_VAL(stringCodePointIndex(string, to) - stringCodePointIndex(string, from) + 1);
+
+    Searcher searcher;
+    initSearcher(&searcher, needle->chars, needle->length, false);
+    long long count = 0;
+    long long index;
+    while ((index = searchIn(&searcher, string->chars + from, to - from)) >= 0) {
+        count++;
+        from += index + needle->length;
+    }
+    return INT_VAL(count);
 }
 
 Value PyString_Encode(int argc, int kwargc) {
@@ -164,7 +476,11 @@ Value PyString_Encode(int argc, int kwargc) {
 }
 
 Value PyString_Endswith(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.endswith is not implemented");
+    static char *keywords[] = {"self", "suffix", "start", "end"};
+    Value self, affix, start, end;
+    PARSE_ARGS(&self, &affix, &start, &end);
+
+    return matchAffix(self, affix, start, end, true);
 }
 
 Value PyString_Expandtabs(int argc, int kwargc) {
@@ -172,59 +488,146 @@ Value PyString_Expandtabs(int argc, int kwargc) {
 }
 
 Value PyString_Find(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.find is not implemented");
+    static char *keywords[] = {"self", "sub", "start", "end"};
+    Value self, sub, start, end;
+    PARSE_ARGS(&self, &sub, &start, &end);
+    SEARCH_ARGS();
+
+    return INT_VAL(findIn(string, needle, from, to, false));
 }
 
+// Takes any positional and keyword arguments, so they are read straight off
+// the stack: self and the positionals, then (name, value) pairs.
 Value PyString_Format(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.format is not implemented");
+    Value *argv = vm.top - argc - 2 * kwargc;
+    FormatArgs args = {
+        .positional = argv + 1,
+        .positionalCount = argc - 1,
+        .keywords = argv + argc,
+        .keywordCount = kwargc,
+        .mapping = UNDEFINED_VAL,
+    };
+    return formatTemplate(AS_STRING(argv[0]), TEMPLATE_BRACES, &args);
 }
 
 Value PyString_FormatMap(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.format_map is not implemented");
+    static char *keywords[] = {"self", "mapping"};
+    Value self, mapping;
+    PARSE_ARGS(&self, &mapping);
+
+    if (IS_UNDEFINED(mapping))
+        return createException(VAL_TYPE_ERROR, "format_map() takes exactly one argument (0 given)");
+    FormatArgs args = {.mapping = mapping};
+    return formatTemplate(AS_STRING(self), TEMPLATE_BRACES, &args);
 }
 
 Value PyString_Index(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.index is not implemented");
+    static char *keywords[] = {"self", "sub", "start", "end"};
+    Value self, sub, start, end;
+    PARSE_ARGS(&self, &sub, &start, &end);
+    SEARCH_ARGS();
+
+    long long index = findIn(string, needle, from, to, false);
+    if (index < 0)
+        return createException(VAL_VALUE_ERROR, "substring not found");
+    return INT_VAL(index);
 }
 
 Value PyString_IsAlnum(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isalnum is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allInClass(self, CLASS_ALNUM);
 }
 
 Value PyString_IsAlpha(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isalpha is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allInClass(self, CLASS_ALPHA);
 }
 
 Value PyString_IsAscii(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isascii is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return BOOL_VAL(stringIsAscii(AS_STRING(self)));
 }
 
 Value PyString_IsDecimal(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isdecimal is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allInClass(self, CLASS_DIGIT);
 }
 
 Value PyString_IsDigit(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isdigit is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allInClass(self, CLASS_DIGIT);
 }
 
+// Non-ASCII code points are accepted anywhere, which holds for letters of
+// other scripts but not for their punctuation.
 Value PyString_IsIdentifier(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isidentifier is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    ObjString *string = AS_STRING(self);
+    if (string->length == 0 || inClass(string->chars[0], CLASS_DIGIT))
+        return BOOL_VAL(false);
+    for (int i = 0; i < string->length; i++) {
+        char c = string->chars[i];
+        if (!inClass(c, CLASS_ALNUM) && c != '_' && (unsigned char)c < 0x80)
+            return BOOL_VAL(false);
+    }
+    return BOOL_VAL(true);
 }
 
 Value PyString_IsLower(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.islower is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allCased(self, CLASS_LOWER, CLASS_UPPER);
 }
 
 Value PyString_IsNumeric(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isnumeric is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allInClass(self, CLASS_DIGIT);
 }
 
+// ASCII control characters are the only ones treated as unprintable.
 Value PyString_IsPrintable(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isprintable is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    ObjString *string = AS_STRING(self);
+    for (int i = 0; i < string->length; i++) {
+        unsigned char c = string->chars[i];
+        if (c < 0x20 || c == 0x7f)
+            return BOOL_VAL(false);
+    }
+    return BOOL_VAL(true);
 }
 
 Value PyString_IsSpace(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isspace is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allInClass(self, CLASS_SPACE);
 }
 
 Value PyString_IsTitle(int argc, int kwargc) {
@@ -232,15 +635,77 @@ Value PyString_IsTitle(int argc, int kwargc) {
 }
 
 Value PyString_IsUpper(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.isupper is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return allCased(self, CLASS_UPPER, CLASS_LOWER);
 }
 
+// The result is sized in a first pass over the items and filled by a single
+// copy per item, instead of concatenating pairwise.
 Value PyString_Join(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.join is not implemented");
+    static char *keywords[] = {"self", "iterable"};
+    Value self, iterable;
+    PARSE_ARGS(&self, &iterable);
+
+    Value *items;
+    size_t count;
+    if (IS_TUPLE(iterable)) {
+        items = AS_TUPLE(iterable)->values;
+        count = AS_TUPLE(iterable)->size;
+    } else {
+        if (!IS_LIST(iterable)) {
+            iterable = List_Init(UNDEFINED_VAL, 1, &iterable);
+            if (isInstance(iterable, TYPE_CLASS(exception)))
+                return iterable;
+        }
+        ObjList *list = AS_LIST(iterable);
+        if (list->size > 0 && list->strategy != LIST_OBJECTS)
+            return createException(VAL_TYPE_ERROR, "sequence item 0: expected str instance, %s found",
+                list->strategy == LIST_INTS ? "int" : "float");
+        items = list->items.values;
+        count = list->size;
+    }
+
+    ObjString *separator = AS_STRING(self);
+    size_t length = count > 0 ? separator->length * (count - 1) : 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!IS_STRING(items[i]))
+            return createException(VAL_TYPE_ERROR, "sequence item %zu: expected str instance, %s found", i, getValueType(items[i]));
+        length += AS_STRING(items[i])->length;
+    }
+
+    if (count == 0)
+        return STRING_VAL(EMPTY_STRING());
+    if (count == 1)
+        return items[0];
+    if (exceedsHeapLimit(length))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    push(iterable);
+    ObjString *result = allocateString(length);
+    pop();
+
+    char *dest = result->chars;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+            memcpy(dest, separator->chars, separator->length);
+            dest += separator->length;
+        }
+        ObjString *item = AS_STRING(items[i]);
+        memcpy(dest, item->chars, item->length);
+        dest += item->length;
+    }
+    return OBJ_VAL(result);
 }
 
 Value PyString_Ljust(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.ljust is not implemented");
+    static char *keywords[] = {"self", "width", "fillchar"};
+    Value self, width, fillchar;
+    PARSE_ARGS(&self, &width, &fillchar);
+
+    return justify(self, width, fillchar, ALIGN_LEFT);
 }
 
 Value PyString_Lower(int argc, int kwargc) {
@@ -248,17 +713,15 @@ Value PyString_Lower(int argc, int kwargc) {
     Value self;
     PARSE_ARGS(&self);
 
-    ObjString *string = AS_STRING(self);
-    ObjString *res = allocateString(string->length);
-
-    for (int i = 0; i < res->length; i++)
-        res->chars[i] = tolower(string->chars[i]);
-    
-    return OBJ_VAL(res);
+    return mapCase(self, CASE_LOWER);
 }
 
 Value PyString_Lstrip(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.lstrip is not implemented");
+    static char *keywords[] = {"self", "chars"};
+    Value self, chars;
+    PARSE_ARGS(&self, &chars);
+
+    return stripString(self, chars, STRIP_LEFT, "lstrip");
 }
 
 Value PyString_Maketrans(int argc, int kwargc) {
@@ -266,55 +729,274 @@ Value PyString_Maketrans(int argc, int kwargc) {
 }
 
 Value PyString_Partition(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.partition is not implemented");
+    static char *keywords[] = {"self", "sep"};
+    Value self, sep;
+    PARSE_ARGS(&self, &sep);
+
+    return partitionString(self, sep, false);
 }
 
 Value PyString_Replace(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.replace is not implemented");
+    static char *keywords[] = {"self", "old", "new", "count"};
+    Value self, old, new, count;
+    PARSE_ARGS(&self, &old, &new, &count);
+
+    Value res = expectString(old);
+    if (IS_STRING(res))
+        res = expectString(new);
+    if (!IS_STRING(res))
+        return res;
+    if (!IS_UNDEFINED(count) && !IS_INT(count))
+        return createException(VAL_TYPE_ERROR, "'%s' object cannot be interpreted as an integer", getValueType(count));
+
+    ObjString *string = AS_STRING(self);
+    ObjString *from = AS_STRING(old);
+    ObjString *to = AS_STRING(new);
+    long long limit = IS_UNDEFINED(count) || AS_INT(count) < 0 ? -1 : AS_INT(count);
+
+    // First pass counts the replacements so the result is allocated once.
+    Searcher searcher;
+    initSearcher(&searcher, from->chars, from->length, false);
+    long long matches = 0;
+    if (from->length == 0) {
+        // An empty pattern matches before every code point and at the end.
+        matches = stringCodePoints(string) + 1;
+    } else {
+        long long offset = 0, index;
+        while (matches != limit && (index = searchIn(&searcher, string->chars + offset, string->length - offset)) >= 0) {
+            matches++;
+            offset += index + from->length;
+        }
+    }
+    if (limit >= 0 && matches > limit)
+        matches = limit;
+    if (matches == 0)
+        return self;
+
+    long long length = string->length + matches * (to->length - from->length);
+    if (exceedsHeapLimit(length))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    ObjString *result = allocateString(length);
+    char *dest = result->chars;
+    long long offset = 0;
+    for (long long i = 0; i < matches; i++) {
+        long long index;
+        if (from->length != 0)
+            index = searchIn(&searcher, string->chars + offset, string->length - offset);
+        else
+            index = i == 0 ? 0 : nextCodePoint(string->chars, string->length, offset) - offset;
+        memcpy(dest, string->chars + offset, index);
+        dest += index;
+        memcpy(dest, to->chars, to->length);
+        dest += to->length;
+        offset += index + from->length;
+    }
+    memcpy(dest, string->chars + offset, string->length - offset);
+
+    return OBJ_VAL(result);
 }
 
 Value PyString_Rfind(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.rfind is not implemented");
+    static char *keywords[] = {"self", "sub", "start", "end"};
+    Value self, sub, start, end;
+    PARSE_ARGS(&self, &sub, &start, &end);
+    SEARCH_ARGS();
+
+    return INT_VAL(findIn(string, needle, from, to, true));
 }
 
 Value PyString_Rindex(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.rindex is not implemented");
+    static char *keywords[] = {"self", "sub", "start", "end"};
+    Value self, sub, start, end;
+    PARSE_ARGS(&self, &sub, &start, &end);
+    SEARCH_ARGS();
+
+    long long index = findIn(string, needle, from, to, true);
+    if (index < 0)
+        return createException(VAL_VALUE_ERROR, "substring not found");
+    return INT_VAL(index);
 }
 
 Value PyString_Rjust(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.rjust is not implemented");
+    static char *keywords[] = {"self", "width", "fillchar"};
+    Value self, width, fillchar;
+    PARSE_ARGS(&self, &width, &fillchar);
+
+    return justify(self, width, fillchar, ALIGN_RIGHT);
 }
 
 Value PyString_Rpartition(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.rpartition is not implemented");
+    static char *keywords[] = {"self", "sep"};
+    Value self, sep;
+    PARSE_ARGS(&self, &sep);
+
+    return partitionString(self, sep, true);
+}
+
+// Shared argument handling of split and rsplit. A missing or None separator
+// splits on runs of whitespace.
+static Value splitArgs(Value sep, Value maxsplit, long long *limit) {
+    if (!IS_UNDEFINED(sep) && !IS_NONE(sep)) {
+        if (!IS_STRING(sep))
+            return createException(VAL_TYPE_ERROR, "must be str or None, not %s", getValueType(sep));
+        if (AS_STRING(sep)->length == 0)
+            return createException(VAL_VALUE_ERROR, "empty separator");
+    }
+    if (!IS_UNDEFINED(maxsplit) && !IS_INT(maxsplit))
+        return createException(VAL_TYPE_ERROR, "'%s' object cannot be interpreted as an integer", getValueType(maxsplit));
+    *limit = IS_UNDEFINED(maxsplit) ? -1 : AS_INT(maxsplit);
+    return NONE_VAL;
 }
 
 Value PyString_Rsplit(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.rsplit is not implemented");
+    static char *keywords[] = {"self", "sep", "maxsplit"};
+    Value self, sep, maxsplit;
+    PARSE_ARGS(&self, &sep, &maxsplit);
+
+    long long limit;
+    Value res = splitArgs(sep, maxsplit, &limit);
+    if (!IS_NONE(res))
+        return res;
+
+    ObjString *string = AS_STRING(self);
+    ObjList *list = allocateList(0);
+    long long end = string->length;
+
+    if (IS_UNDEFINED(sep) || IS_NONE(sep)) {
+        while (true) {
+            end -= rspanClass(string->chars, end, CLASS_SPACE);
+            if (end == 0)
+                break;
+            long long start = end;
+            if (limit-- == 0) {
+                listAppend(list, substring(string, 0, end));
+                break;
+            }
+            start = rfindClass(string->chars, end, CLASS_SPACE) + 1;
+            listAppend(list, substring(string, start, end));
+            end = start;
+        }
+    } else {
+        ObjString *separator = AS_STRING(sep);
+        Searcher searcher;
+        initSearcher(&searcher, separator->chars, separator->length, true);
+        long long index;
+        while (limit-- != 0 && (index = searchIn(&searcher, string->chars, end)) >= 0) {
+            listAppend(list, substring(string, index + separator->length, end));
+            end = index;
+        }
+        listAppend(list, substring(string, 0, end));
+    }
+
+    listReverse(list);
+    return OBJ_VAL(list);
 }
 
 Value PyString_Rstrip(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.rstrip is not implemented");
+    static char *keywords[] = {"self", "chars"};
+    Value self, chars;
+    PARSE_ARGS(&self, &chars);
+
+    return stripString(self, chars, STRIP_RIGHT, "rstrip");
 }
 
 Value PyString_Split(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.split is not implemented");
+    static char *keywords[] = {"self", "sep", "maxsplit"};
+    Value self, sep, maxsplit;
+    PARSE_ARGS(&self, &sep, &maxsplit);
+
+    long long limit;
+    Value res = splitArgs(sep, maxsplit, &limit);
+    if (!IS_NONE(res))
+        return res;
+
+    ObjString *string = AS_STRING(self);
+    ObjList *list = allocateList(0);
+    long long start = 0;
+
+    if (IS_UNDEFINED(sep) || IS_NONE(sep)) {
+        while (true) {
+            start += spanClass(string->chars + start, string->length - start, CLASS_SPACE);
+            if (start == string->length)
+                break;
+            long long end = start;
+            if (limit-- == 0) {
+                listAppend(list, substring(string, start, string->length));
+                break;
+            }
+            end += findClass(string->chars + start, string->length - start, CLASS_SPACE);
+            listAppend(list, substring(string, start, end));
+            start = end;
+        }
+    } else {
+        ObjString *separator = AS_STRING(sep);
+        Searcher searcher;
+        initSearcher(&searcher, separator->chars, separator->length, false);
+        long long index;
+        while (limit-- != 0 && (index = searchIn(&searcher, string->chars + start, string->length - start)) >= 0) {
+            listAppend(list, substring(string, start, start + index));
+            start += index + separator->length;
+        }
+        listAppend(list, substring(string, start, string->length));
+    }
+
+    return OBJ_VAL(list);
 }
 
 Value PyString_Splitlines(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.splitlines is not implemented");
+    static char *keywords[] = {"self", "keepends"};
+    Value self, keepends;
+    PARSE_ARGS(&self, &keepends);
+
+    if (!IS_UNDEFINED(keepends) && !IS_BOOL(keepends)) {
+        Value res = expectInt(keepends);
+        if (!IS_INT(res))
+            return res;
+    }
+    bool keep = !IS_UNDEFINED(keepends) && AS_INT(keepends) != 0;
+
+    ObjString *string = AS_STRING(self);
+    ObjList *list = allocateList(0);
+    int start = 0;
+    for (int i = 0; i < string->length;) {
+        int width = lineBreakAt(string->chars, string->length, i);
+        if (width == 0) {
+            i++;
+            continue;
+        }
+        listAppend(list, substring(string, start, keep ? i + width : i));
+        i += width;
+        start = i;
+    }
+    if (start < string->length)
+        listAppend(list, substring(string, start, string->length));
+
+    return OBJ_VAL(list);
 }
 
 Value PyString_Startswith(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.startswith is not implemented");
+    static char *keywords[] = {"self", "prefix", "start", "end"};
+    Value self, affix, start, end;
+    PARSE_ARGS(&self, &affix, &start, &end);
+
+    return matchAffix(self, affix, start, end, false);
 }
 
 Value PyString_Strip(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.strip is not implemented");
+    static char *keywords[] = {"self", "chars"};
+    Value self, chars;
+    PARSE_ARGS(&self, &chars);
+
+    return stripString(self, chars, STRIP_LEFT | STRIP_RIGHT, "strip");
 }
 
 Value PyString_Swapcase(int argc, int kwargc) {
-    return createException(VAL_NOT_IMPLEMENTED_ERROR, "str.swapcase is not implemented");
+    static char *keywords[] = {"self"};
+    Value self;
+    PARSE_ARGS(&self);
+
+    return mapCase(self, CASE_SWAP);
 }
 
 Value PyString_Title(int argc, int kwargc) {
@@ -330,17 +1012,32 @@ Value PyString_Upper(int argc, int kwargc) {
     Value self;
     PARSE_ARGS(&self);
 
-    ObjString *string = AS_STRING(self);
-    ObjString *res = allocateString(string->length);
-
-    for (int i = 0; i < res->length; i++)
-        res->chars[i] = toupper(string->chars[i]);
-    
-    return OBJ_VAL(res);
+    return mapCase(self, CASE_UPPER);
 }
 
 Value PyString_Zfill(int argc, int kwargc) {
-    return NOT_IMPLEMENTED_VAL;
+    static char *keywords[] = {"self", "width"};
+    Value self, width;
+    PARSE_ARGS(&self, &width);
+
+    Value res = expectInt(width);
+    if (!IS_INT(res))
+        return res;
+
+    ObjString *string = AS_STRING(self);
+    long long pad = AS_INT(width) - stringCodePoints(string);
+    if (pad <= 0)
+        return self;
+    if (exceedsHeapLimit(string->length + pad))
+        return createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit);
+
+    // The zeros go after a leading sign.
+    int sign = string->length > 0 && (string->chars[0] == '+' || string->chars[0] == '-');
+    ObjString *result = allocateString(string->length + pad);
+    memcpy(result->chars, string->chars, sign);
+    memset(result->chars + sign, '0', pad);
+    memcpy(result->chars + sign + pad, string->chars + sign, string->length - sign);
+    return OBJ_VAL(result);
 }
 
 Value PyString_Class(Value self) {
@@ -141,20 +141,32 @@ static Token createErrorToken(const char *message) {
     return token;
 }
 
-static Token scanNumber() {
-    while (isDigit(peek(0)))
+// Digits with single underscores between them, as in 1_000_000.
+static void scanDigits() {
+    while (isDigit(peek(0)) || (peek(0) == '_' && isDigit(peek(1))))
         advance();
+}
+
+static Token scanNumber() {
+    scanDigits();
 
     if (peek(0) == '.') {
         if (isDigit(peek(1))) {
             advance();
-            while (isDigit(peek(0)))
-                advance();
+            scanDigits();
         } else {
             return createErrorToken("Missing fractional part after '.");
         }
     }
 
+    char sign = peek(1);
+    if ((peek(0) == 'e' || peek(0) == 'E') && (isDigit(sign) || ((sign == '+' || sign == '-') && isDigit(peek(2))))) {
+        advance();
+        if (!isDigit(peek(0)))
+            advance();
+        scanDigits();
+    }
+
     return createToken(TOKEN_NUMBER);
 }
 
@@ -223,15 +235,26 @@ static Token scanRawString(char stop) {
     return string; 
 }
 
+// One literal part of an f-string, up to the next field or the closing quote.
+// Doubled braces stay doubled: the compiler turns the f-string into a format
+// template, where they are the escapes.
 static Token scanFormattedString(char stop) {
     skipChar();
 
     while (peek(0) != stop && peek(0) != '\n' && !reachEnd()) {
         if (peek(0) == '\\' && peek(1) == stop)
             advance();
-        if (peek(0) == '{' && peek(1) != '{') {
+        if ((peek(0) == '{' || peek(0) == '}') && peek(1) == peek(0)) {
+            advance();
+            advance();
+            continue;
+        }
+        if (peek(0) == '}')
+            return createErrorToken("f-string: single '}' is not allowed");
+        if (peek(0) == '{') {
             scanner->inFormattedString = true;
             scanner->stop = stop;
+            scanner->formatDepth = 0;
             Token token = createToken(TOKEN_FSTRING);
             advance();
             return token;
@@ -239,7 +262,7 @@ static Token scanFormattedString(char stop) {
         advance();
     }
 
-    Token string = createToken(TOKEN_STRING);
+    Token string = createToken(TOKEN_FSTRING_END);
     
     if (!match(stop))
         return createErrorToken("Unterminated string");
@@ -248,6 +271,26 @@ static Token scanFormattedString(char stop) {
     return string; 
 }
 
+// The format spec of an f-string field, from after the ':' up to the closing
+// brace, which is left for the next token.
+static Token scanFormatSpec() {
+    skipChar();
+
+    while (peek(0) != '}' && peek(0) != scanner->stop && peek(0) != '\n' && !reachEnd()) {
+        if (peek(0) == '{')
+            return createErrorToken("f-string: nested fields in a format spec are not supported");
+        advance();
+    }
+
+    if (peek(0) != '}')
+        return createErrorToken("f-string: expecting '}'");
+    return createToken(TOKEN_FORMAT_SPEC);
+}
+
+static bool isConversion(char c) {
+    return c == 'r' || c == 's' || c == 'a';
+}
+
 static bool isQuote(char c) {
     return c == '\'' || c == '"';
 }
@@ -260,6 +303,9 @@ void initScanner(Scanner *s, const char *source) {
     s->column = 1;
     s->startLine = 1;
     s->startColumn = 1;
+    s->indentationPointer = 0;
+    s->indent = 0;
+    s->inFormattedString = false;
     s->enclosing = scanner;
     scanner = s;
     pushIndent(0);
@@ -301,8 +347,24 @@ Token scanToken(bool skip) {
 
     char c = advance();
 
-    if (scanner->inFormattedString && c == '}')
-        return scanFormattedString(scanner->stop);
+    // Inside an f-string field, only brackets opened within the field may
+    // hold a '}', ':' or '!' of their own.
+    if (scanner->inFormattedString) {
+        if (scanner->formatDepth == 0) {
+            if (c == '}')
+                return scanFormattedString(scanner->stop);
+            if (c == ':')
+                return scanFormatSpec();
+            if (c == '!' && isConversion(peek(0)) && (peek(1) == ':' || peek(1) == '}')) {
+                advance();
+                return createToken(TOKEN_CONVERSION);
+            }
+        }
+        if (c == '(' || c == '[' || c == '{')
+            scanner->formatDepth++;
+        else if (c == ')' || c == ']' || c == '}')
+            scanner->formatDepth--;
+    }
 
     if (isDigit(c))
         return scanNumber();
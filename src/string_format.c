@@ -0,0 +1,1225 @@
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+
+#include "string_format.h"
+#include "object_exception.h"
+#include "value_int.h"
+#include "value_float.h"
+#include "value_methods.h"
+#include "numeric.h"
+#include "string_scan.h"
+#include "utf8.h"
+#include "memory.h"
+#include "vm.h"
+
+typedef enum {
+    SPEC_OK,
+    SPEC_INVALID,
+    SPEC_MISSING_PRECISION,
+    SPEC_TOO_LARGE,
+} SpecError;
+
+// [[fill]align][sign][z][#][0][width][grouping][.precision][type], parsed
+// without looking at the value. Which parts a value accepts is checked when it
+// is rendered, since the same field may get an int one time and a str the next.
+typedef struct {
+    const char *text;
+    int textLength;
+    char fill[4];
+    int fillLength;
+    bool explicitFill;
+    char align;             // '<', '>', '^', '=', or 0 for the value's default
+    char sign;              // '+', '-', ' ' or 0
+    bool noNegativeZero;    // 'z'
+    bool alternate;         // '#'
+    bool zero;              // '0' before the width
+    char grouping;          // ',', '_' or 0
+    int width;              // -1 when absent, like precision
+    int precision;
+    char type;              // 0 when absent
+    bool printf;            // from `%`, where precision pads integers with zeros
+    SpecError error;
+} FormatSpec;
+
+typedef struct {
+    bool isAttribute;
+    long long index;        // item key when name is NULL
+    ObjString *name;
+} FieldAccess;
+
+// Literal text and spec texts are offsets into the template string, which
+// outlives the template cached on it. An escaped `{{` or `%%` ends a literal
+// piece instead of being copied out.
+typedef struct {
+    bool isLiteral;
+    int start;
+    int length;
+    int index;              // positional argument, or -1 for a named one
+    ObjString *name;
+    FieldAccess *accesses;
+    int accessCount;
+    int accessCapacity;
+    char conversion;        // 'r', 's', 'a' or 0
+    FormatSpec spec;
+    FormatTemplate *nestedSpec; // a spec with fields of its own, "{:{width}}"
+    bool widthFromArgs;     // `%*d`
+    bool precisionFromArgs; // `%.*f`
+} FormatPiece;
+
+// Templates cached on a string are linked into one list so the collector
+// can mark the field names they hold; nested spec templates are reached
+// through their pieces. Rendering can run user code that recompiles or
+// appends to the same string, so a template dropped while it is rendering
+// is only detached, and freed once the outermost render finishes.
+struct FormatTemplate {
+    TemplateSyntax syntax;
+    const char *source;
+    FormatPiece *pieces;
+    int pieceCount;
+    int pieceCapacity;
+    bool usesNames;
+    int rendering;
+    bool detached;
+    FormatTemplate *prev;
+    FormatTemplate *next;
+};
+
+static FormatTemplate *cachedTemplates = NULL;
+
+typedef enum {
+    NUMBERING_NONE,
+    NUMBERING_AUTO,
+    NUMBERING_MANUAL,
+} Numbering;
+
+// `{}` and `{0}` may not be mixed, and fields in nested specs take the next
+// automatic index after the field that holds them.
+typedef struct {
+    const char *source;
+    int nextIndex;
+    Numbering numbering;
+} BracesCompiler;
+
+typedef struct {
+    const char *fill;
+    int fillLength;
+    char align;
+} Padding;
+
+// A number split for padding and grouping: the sign, then a base prefix, then
+// the integer digits, which take separators and zero padding, then the rest.
+typedef struct {
+    char sign;
+    const char *prefix;
+    int prefixLength;
+    const char *digits;
+    int digitCount;
+    int minDigits;
+    const char *rest;
+    int restLength;
+    char separator;
+    int groupSize;
+} NumberParts;
+
+static bool isException(Value value) {
+    return isInstance(value, TYPE_CLASS(exception));
+}
+
+static int countBytes(const char *chars, int start, int end, const char *set) {
+    int count = 0;
+    for (int i = start; i < end; i++)
+        count += strchr(set, chars[i]) != NULL;
+    return count;
+}
+
+static bool allDigits(const char *chars, int length) {
+    return length > 0 && spanClass(chars, length, CLASS_DIGIT) == (size_t)length;
+}
+
+// Reads the decimal digits at *i, if any, into value. False when they do not
+// fit an int.
+static bool readNumber(const char *chars, int length, int *i, int *value) {
+    if (*i >= length || !inClass(chars[*i], CLASS_DIGIT))
+        return true;
+    long long number = 0;
+    while (*i < length && inClass(chars[*i], CLASS_DIGIT)) {
+        number = number * 10 + chars[(*i)++] - '0';
+        if (number > INT_MAX)
+            return false;
+    }
+    *value = number;
+    return true;
+}
+
+static bool isAlign(char c) {
+    return c == '<' || c == '>' || c == '^' || c == '=';
+}
+
+static void initSpec(FormatSpec *spec, const char *text, int length) {
+    memset(spec, 0, sizeof(FormatSpec));
+    spec->text = text;
+    spec->textLength = length;
+    spec->fill[0] = ' ';
+    spec->fillLength = 1;
+    spec->width = -1;
+    spec->precision = -1;
+}
+
+static void parseSpec(const char *chars, int length, FormatSpec *spec) {
+    initSpec(spec, chars, length);
+
+    int i = 0;
+    if (length > 0) {
+        int next = nextCodePoint(chars, length, 0);
+        if (next < length && next <= 4 && isAlign(chars[next])) {
+            memcpy(spec->fill, chars, next);
+            spec->fillLength = next;
+            spec->explicitFill = true;
+            spec->align = chars[next];
+            i = next + 1;
+        } else if (isAlign(chars[0])) {
+            spec->align = chars[0];
+            i = 1;
+        }
+    }
+    if (i < length && (chars[i] == '+' || chars[i] == '-' || chars[i] == ' '))
+        spec->sign = chars[i++];
+    if (i < length && chars[i] == 'z') {
+        spec->noNegativeZero = true;
+        i++;
+    }
+    if (i < length && chars[i] == '#') {
+        spec->alternate = true;
+        i++;
+    }
+    if (i < length && chars[i] == '0' && !spec->explicitFill) {
+        spec->zero = true;
+        i++;
+    }
+    if (!readNumber(chars, length, &i, &spec->width)) {
+        spec->error = SPEC_TOO_LARGE;
+        return;
+    }
+    if (i < length && (chars[i] == ',' || chars[i] == '_'))
+        spec->grouping = chars[i++];
+    if (i < length && chars[i] == '.') {
+        int start = ++i;
+        if (!readNumber(chars, length, &i, &spec->precision)) {
+            spec->error = SPEC_TOO_LARGE;
+            return;
+        }
+        if (i == start) {
+            spec->error = SPEC_MISSING_PRECISION;
+            return;
+        }
+    }
+    if (length - i > 1)
+        spec->error = SPEC_INVALID;
+    else if (length - i == 1)
+        spec->type = chars[i];
+}
+
+static FormatTemplate *newTemplate(TemplateSyntax syntax, const char *source, int capacity) {
+    FormatTemplate *template = ALLOCATE(FormatTemplate, 1);
+    template->syntax = syntax;
+    template->source = source;
+    template->pieces = ALLOCATE(FormatPiece, capacity);
+    template->pieceCount = 0;
+    template->pieceCapacity = capacity;
+    template->usesNames = false;
+    template->rendering = 0;
+    template->detached = false;
+    template->prev = NULL;
+    template->next = NULL;
+    return template;
+}
+
+static void freeTemplate(FormatTemplate *template) {
+    if (template == NULL)
+        return;
+    for (int i = 0; i < template->pieceCount; i++) {
+        FormatPiece *piece = &template->pieces[i];
+        if (piece->accesses != NULL)
+            FREE_VEC(FieldAccess, piece->accesses, piece->accessCapacity);
+        freeTemplate(piece->nestedSpec);
+    }
+    FREE_VEC(FormatPiece, template->pieces, template->pieceCapacity);
+    FREE(FormatTemplate, template);
+}
+
+void freeFormatTemplate(FormatTemplate *template) {
+    if (template == NULL)
+        return;
+    if (template->rendering > 0) {
+        template->detached = true;
+        return;
+    }
+    if (template->prev != NULL)
+        template->prev->next = template->next;
+    else
+        cachedTemplates = template->next;
+    if (template->next != NULL)
+        template->next->prev = template->prev;
+    freeTemplate(template);
+}
+
+static void markTemplate(FormatTemplate *template) {
+    for (int i = 0; i < template->pieceCount; i++) {
+        FormatPiece *piece = &template->pieces[i];
+        markObject((Obj*)piece->name);
+        for (int j = 0; j < piece->accessCount; j++)
+            markObject((Obj*)piece->accesses[j].name);
+        if (piece->nestedSpec != NULL)
+            markTemplate(piece->nestedSpec);
+    }
+}
+
+void markFormatTemplates() {
+    for (FormatTemplate *template = cachedTemplates; template != NULL; template = template->next)
+        markTemplate(template);
+}
+
+// Names parsed out of a template are ordinary strings owned by it, so the
+// keys of templates built at runtime do not pile up in the intern table.
+static ObjString *copyName(const char *chars, int length) {
+    if (length == 0)
+        return EMPTY_STRING();
+    return copyString(chars, length);
+}
+
+static FormatPiece *addPiece(FormatTemplate *template) {
+    FormatPiece *piece = &template->pieces[template->pieceCount++];
+    memset(piece, 0, sizeof(FormatPiece));
+    piece->index = -1;
+    return piece;
+}
+
+static void addLiteral(FormatTemplate *template, int start, int length) {
+    if (length == 0)
+        return;
+    FormatPiece *piece = addPiece(template);
+    piece->isLiteral = true;
+    piece->start = start;
+    piece->length = length;
+}
+
+// Frees the partly compiled template and passes the error on.
+static Value failCompile(FormatTemplate *template, Value error) {
+    freeTemplate(template);
+    return error;
+}
+
+static bool parseIndex(const char *chars, int length, long long *index) {
+    int value = 0;
+    int i = 0;
+    if (!readNumber(chars, length, &i, &value))
+        return false;
+    *index = value;
+    return true;
+}
+
+// arg_name ("." attribute | "[" key "]")*
+static Value compileFieldName(BracesCompiler *compiler, FormatPiece *piece, int start, int end) {
+    const char *source = compiler->source;
+    int i = start;
+    while (i < end && source[i] != '.' && source[i] != '[')
+        i++;
+
+    long long index;
+    if (i == start) {
+        if (compiler->numbering == NUMBERING_MANUAL)
+            return createException(VAL_VALUE_ERROR, "cannot switch from manual field specification to automatic field numbering");
+        compiler->numbering = NUMBERING_AUTO;
+        piece->index = compiler->nextIndex++;
+    } else if (allDigits(source + start, i - start)) {
+        if (compiler->numbering == NUMBERING_AUTO)
+            return createException(VAL_VALUE_ERROR, "cannot switch from automatic field numbering to manual field specification");
+        compiler->numbering = NUMBERING_MANUAL;
+        if (!parseIndex(source + start, i - start, &index))
+            return createException(VAL_VALUE_ERROR, "Too many decimal digits in format string");
+        piece->index = index;
+    } else {
+        piece->name = copyName(source + start, i - start);
+    }
+
+    if (i == end)
+        return NONE_VAL;
+
+    piece->accessCapacity = countBytes(source, i, end, ".[");
+    piece->accesses = ALLOCATE(FieldAccess, piece->accessCapacity);
+
+    while (i < end) {
+        FieldAccess *access = &piece->accesses[piece->accessCount];
+        if (source[i] == '.') {
+            int nameStart = ++i;
+            while (i < end && source[i] != '.' && source[i] != '[')
+                i++;
+            if (i == nameStart)
+                return createException(VAL_VALUE_ERROR, "Empty attribute in format string");
+            access->isAttribute = true;
+            access->name = copyName(source + nameStart, i - nameStart);
+        } else if (source[i] == '[') {
+            int keyStart = ++i;
+            while (i < end && source[i] != ']')
+                i++;
+            if (i == end)
+                return createException(VAL_VALUE_ERROR, "Missing ']' in format string");
+            if (i == keyStart)
+                return createException(VAL_VALUE_ERROR, "Empty attribute in format string");
+            access->isAttribute = false;
+            access->name = NULL;
+            if (!allDigits(source + keyStart, i - keyStart) || !parseIndex(source + keyStart, i - keyStart, &access->index))
+                access->name = copyName(source + keyStart, i - keyStart);
+            i++;
+        } else {
+            return createException(VAL_VALUE_ERROR, "Only '.' or '[' may follow ']' in format field specifier");
+        }
+        piece->accessCount++;
+    }
+    return NONE_VAL;
+}
+
+static Value compileBraces(BracesCompiler *compiler, int start, int end, int depth, FormatTemplate **result);
+
+// field_name ["!" conversion] [":" format_spec], between the braces.
+static Value compileField(BracesCompiler *compiler, FormatTemplate *template, int start, int end, int depth) {
+    const char *source = compiler->source;
+    FormatPiece *piece = addPiece(template);
+
+    int nameEnd = start;
+    bool inBracket = false;
+    for (; nameEnd < end; nameEnd++) {
+        char c = source[nameEnd];
+        if (c == '[')
+            inBracket = true;
+        else if (c == ']')
+            inBracket = false;
+        else if (!inBracket && (c == '!' || c == ':'))
+            break;
+    }
+
+    Value error = compileFieldName(compiler, piece, start, nameEnd);
+    if (!IS_NONE(error))
+        return error;
+
+    int i = nameEnd;
+    if (i < end && source[i] == '!') {
+        if (i + 1 == end)
+            return createException(VAL_VALUE_ERROR, "end of string while looking for conversion specifier");
+        piece->conversion = source[i + 1];
+        i += 2;
+        if (i < end && source[i] != ':')
+            return createException(VAL_VALUE_ERROR, "expected ':' after conversion specifier");
+        if (piece->conversion != 'r' && piece->conversion != 's' && piece->conversion != 'a')
+            return createException(VAL_VALUE_ERROR, "Unknown conversion specifier %c", piece->conversion);
+    }
+
+    int specStart = i < end ? i + 1 : end;
+    piece->start = specStart;
+    piece->length = end - specStart;
+
+    if (memchr(source + specStart, '{', end - specStart) != NULL) {
+        if (depth > 0)
+            return createException(VAL_VALUE_ERROR, "Max string recursion exceeded");
+        return compileBraces(compiler, specStart, end, depth + 1, &piece->nestedSpec);
+    }
+    parseSpec(source + specStart, end - specStart, &piece->spec);
+    return NONE_VAL;
+}
+
+// Index of the brace closing the field that starts at `start`, or end.
+static int matchBrace(const char *source, int start, int end) {
+    int depth = 1;
+    for (int i = start; i < end; i++) {
+        if (source[i] == '{')
+            depth++;
+        else if (source[i] == '}' && --depth == 0)
+            return i;
+    }
+    return end;
+}
+
+static Value compileBraces(BracesCompiler *compiler, int start, int end, int depth, FormatTemplate **result) {
+    const char *source = compiler->source;
+    int capacity = 2 * countBytes(source, start, end, "{}") + 1;
+    FormatTemplate *template = newTemplate(TEMPLATE_BRACES, source, capacity);
+
+    int literalStart = start;
+    int i = start;
+    while (i < end) {
+        char c = source[i];
+        if (c != '{' && c != '}') {
+            i++;
+            continue;
+        }
+        if (i + 1 < end && source[i + 1] == c) {
+            addLiteral(template, literalStart, i + 1 - literalStart);
+            i += 2;
+            literalStart = i;
+            continue;
+        }
+        if (c == '}')
+            return failCompile(template, createException(VAL_VALUE_ERROR, "Single '}' encountered in format string"));
+
+        addLiteral(template, literalStart, i - literalStart);
+        int fieldEnd = matchBrace(source, i + 1, end);
+        if (fieldEnd == end) {
+            if (i + 1 == end)
+                return failCompile(template, createException(VAL_VALUE_ERROR, "Single '{' encountered in format string"));
+            return failCompile(template, createException(VAL_VALUE_ERROR, "expected '}' before end of string"));
+        }
+        Value error = compileField(compiler, template, i + 1, fieldEnd, depth);
+        if (!IS_NONE(error))
+            return failCompile(template, error);
+        i = fieldEnd + 1;
+        literalStart = i;
+    }
+    addLiteral(template, literalStart, end - literalStart);
+
+    *result = template;
+    return NONE_VAL;
+}
+
+// %[(name)][flags][width][.precision][length]type
+static Value compilePercent(const char *source, int length, FormatTemplate **result) {
+    int capacity = 2 * countBytes(source, 0, length, "%") + 1;
+    FormatTemplate *template = newTemplate(TEMPLATE_PERCENT, source, capacity);
+
+    int literalStart = 0;
+    int i = 0;
+    while (i < length) {
+        const char *percent = memchr(source + i, '%', length - i);
+        if (percent == NULL)
+            break;
+        i = percent - source;
+        addLiteral(template, literalStart, i - literalStart);
+        i++;
+        if (i < length && source[i] == '%') {
+            literalStart = i++;
+            continue;
+        }
+
+        FormatPiece *piece = addPiece(template);
+        FormatSpec *spec = &piece->spec;
+        initSpec(spec, NULL, 0);
+        spec->printf = true;
+        spec->explicitFill = true;
+
+        if (i < length && source[i] == '(') {
+            int keyStart = ++i;
+            int depth = 1;
+            for (; i < length && depth > 0; i++) {
+                if (source[i] == '(')
+                    depth++;
+                else if (source[i] == ')')
+                    depth--;
+            }
+            if (depth > 0)
+                return failCompile(template, createException(VAL_VALUE_ERROR, "incomplete format key"));
+            piece->name = copyName(source + keyStart, i - 1 - keyStart);
+            template->usesNames = true;
+        }
+
+        for (; i < length; i++) {
+            char c = source[i];
+            if (c == '-')
+                spec->align = '<';
+            else if (c == '+')
+                spec->sign = '+';
+            else if (c == ' ')
+                spec->sign = spec->sign == '+' ? '+' : ' ';
+            else if (c == '#')
+                spec->alternate = true;
+            else if (c == '0')
+                spec->zero = true;
+            else
+                break;
+        }
+
+        if (i < length && source[i] == '*') {
+            piece->widthFromArgs = true;
+            i++;
+        } else if (!readNumber(source, length, &i, &spec->width)) {
+            return failCompile(template, createException(VAL_VALUE_ERROR, "width too big"));
+        }
+
+        if (i < length && source[i] == '.') {
+            i++;
+            spec->precision = 0;
+            if (i < length && source[i] == '*') {
+                piece->precisionFromArgs = true;
+                i++;
+            } else if (!readNumber(source, length, &i, &spec->precision)) {
+                return failCompile(template, createException(VAL_VALUE_ERROR, "precision too big"));
+            }
+        }
+
+        while (i < length && (source[i] == 'h' || source[i] == 'l' || source[i] == 'L'))
+            i++;
+
+        if (i == length)
+            return failCompile(template, createException(VAL_VALUE_ERROR, "incomplete format"));
+
+        char type = source[i];
+        if (type == '\0' || strchr("diouxXeEfFgGcrsa%", type) == NULL)
+            return failCompile(template, createException(VAL_VALUE_ERROR, "unsupported format character '%c' (0x%x) at index %d", type, (unsigned char)type, i));
+        if (type == '%') {
+            piece->isLiteral = true;
+            piece->start = i;
+            piece->length = 1;
+        }
+        spec->type = type;
+        literalStart = ++i;
+    }
+    addLiteral(template, literalStart, length - literalStart);
+
+    *result = template;
+    return NONE_VAL;
+}
+
+// The parsed template of string, compiled and cached on first use. A string
+// used with both syntaxes keeps the most recent one.
+static Value getTemplate(ObjString *string, TemplateSyntax syntax, FormatTemplate **result) {
+    FormatTemplate *template = string->formatTemplate;
+    if (template != NULL && template->syntax == syntax) {
+        *result = template;
+        return NONE_VAL;
+    }
+
+    Value error;
+    if (syntax == TEMPLATE_BRACES) {
+        BracesCompiler compiler = {string->chars, 0, NUMBERING_NONE};
+        error = compileBraces(&compiler, 0, string->length, 0, &template);
+    } else {
+        error = compilePercent(string->chars, string->length, &template);
+    }
+    if (!IS_NONE(error))
+        return error;
+
+    freeFormatTemplate(string->formatTemplate);
+    string->formatTemplate = template;
+    template->next = cachedTemplates;
+    if (cachedTemplates != NULL)
+        cachedTemplates->prev = template;
+    cachedTemplates = template;
+    *result = template;
+    return NONE_VAL;
+}
+
+static Padding resolvePadding(const FormatSpec *spec, char defaultAlign) {
+    Padding padding = {spec->fill, spec->fillLength, spec->align != 0 ? spec->align : defaultAlign};
+    if (spec->zero && !spec->explicitFill) {
+        padding.fill = "0";
+        padding.fillLength = 1;
+        if (spec->align == 0 && defaultAlign == '>')
+            padding.align = '=';
+    }
+    return padding;
+}
+
+static void writeFill(Writer *writer, const Padding *padding, int count) {
+    for (int i = 0; i < count; i++)
+        writeChars(writer, padding->fill, padding->fillLength);
+}
+
+// Text cut to `precision` code points and padded to `width` of them.
+static void writeText(Writer *writer, const Padding *padding, int width, const char *chars, size_t length, int precision) {
+    if (precision >= 0) {
+        size_t end = 0;
+        for (int i = 0; i < precision && end < length; i++)
+            end = nextCodePoint(chars, length, end);
+        length = end;
+    }
+
+    int count = width > 0 ? (int)countCodePoints(chars, length) : 0;
+    int pad = width > count ? width - count : 0;
+    int left = padding->align == '>' ? pad : padding->align == '^' ? pad / 2 : 0;
+
+    writeFill(writer, padding, left);
+    writeChars(writer, chars, length);
+    writeFill(writer, padding, pad - left);
+}
+
+static int groupedLength(const NumberParts *parts, int count) {
+    if (parts->separator == 0 || count == 0)
+        return count;
+    return count + (count - 1) / parts->groupSize;
+}
+
+static void writeDigits(Writer *writer, const NumberParts *parts, int count) {
+    int zeros = count - parts->digitCount;
+    if (parts->separator == 0) {
+        for (int i = 0; i < zeros; i++)
+            writeChar(writer, '0');
+        writeChars(writer, parts->digits, parts->digitCount);
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        if (i > 0 && (count - i) % parts->groupSize == 0)
+            writeChar(writer, parts->separator);
+        writeChar(writer, i < zeros ? '0' : parts->digits[i - zeros]);
+    }
+}
+
+// Zero padding after the sign ('=' with fill '0') lengthens the digits
+// themselves, so it is grouped like them: format(1234, "010,") is
+// "00,001,234". Any other fill goes around the number as a whole.
+static void writeNumber(Writer *writer, const FormatSpec *spec, const NumberParts *parts) {
+    Padding padding = resolvePadding(spec, '>');
+    int lead = (parts->sign != 0) + parts->prefixLength;
+    int count = parts->digitCount > parts->minDigits ? parts->digitCount : parts->minDigits;
+
+    if (padding.align == '=' && padding.fillLength == 1 && padding.fill[0] == '0')
+        while (lead + groupedLength(parts, count) + parts->restLength < spec->width)
+            count++;
+
+    int total = lead + groupedLength(parts, count) + parts->restLength;
+    int pad = spec->width > total ? spec->width - total : 0;
+    int left = 0;
+    if (padding.align == '>')
+        left = pad;
+    else if (padding.align == '^')
+        left = pad / 2;
+
+    writeFill(writer, &padding, left);
+    if (parts->sign != 0)
+        writeChar(writer, parts->sign);
+    if (parts->prefixLength > 0)
+        writeChars(writer, parts->prefix, parts->prefixLength);
+    if (padding.align == '=')
+        writeFill(writer, &padding, pad);
+    writeDigits(writer, parts, count);
+    if (parts->restLength > 0)
+        writeChars(writer, parts->rest, parts->restLength);
+    if (padding.align == '<' || padding.align == '^')
+        writeFill(writer, &padding, pad - left);
+}
+
+static char signChar(bool negative, const FormatSpec *spec) {
+    if (negative)
+        return '-';
+    if (spec->sign == '+' || spec->sign == ' ')
+        return spec->sign;
+    return 0;
+}
+
+static Value unknownCode(char type, const char *typeName) {
+    return createException(VAL_VALUE_ERROR, "Unknown format code '%c' for object of type '%s'", type, typeName);
+}
+
+// Fixed-point and exponent output with a precision goes through the C
+// library, whose decimal conversion is correctly rounded like Python's.
+static void writeFixedPrecision(Writer *body, char type, bool alternate, int precision, double magnitude) {
+    char format[] = {'%', '#', '.', '*', type, '\0'};
+    if (!alternate)
+        memmove(format + 1, format + 2, sizeof(format) - 2);
+    writeFormat(body, format, precision, magnitude);
+}
+
+// The empty type with a precision: like 'g', but fixed-point output keeps a
+// digit after the point, and the exponent form starts one digit earlier to
+// make room for it. format(100.0, ".3") is "1e+02", format(10.0, ".3") "10.0".
+static void writeGeneralPrecision(Writer *body, int precision, double magnitude) {
+    if (precision == 0)
+        precision = 1;
+    writeFormat(body, "%.*e", precision - 1, magnitude);
+
+    size_t e = 0;
+    while (body->chars[e] != 'e')
+        e++;
+    int exponent = 0;
+    for (size_t i = e + 2; i < body->length; i++)
+        exponent = exponent * 10 + body->chars[i] - '0';
+    if (body->chars[e + 1] == '-')
+        exponent = -exponent;
+
+    if (exponent < -4 || exponent >= precision - 1) {
+        size_t end = e;
+        if (memchr(body->chars, '.', e) != NULL) {
+            while (body->chars[end - 1] == '0')
+                end--;
+            if (body->chars[end - 1] == '.')
+                end--;
+        }
+        memmove(body->chars + end, body->chars + e, body->length - e);
+        body->length -= e - end;
+        return;
+    }
+
+    body->length = 0;
+    writeFormat(body, "%.*f", precision - 1 - exponent, magnitude);
+    while (body->chars[body->length - 1] == '0' && body->chars[body->length - 2] != '.')
+        body->length--;
+}
+
+static bool isZeroText(const char *chars, size_t length) {
+    for (size_t i = 0; i < length && chars[i] != 'e' && chars[i] != 'E'; i++)
+        if (chars[i] >= '1' && chars[i] <= '9')
+            return false;
+    return true;
+}
+
+static Value writeDouble(Writer *writer, const FormatSpec *spec, double value, const char *typeName) {
+    char type = spec->type;
+    int precision = spec->precision;
+    switch (type) {
+        case 0:
+            break;
+        case 'n':
+            type = 'g';
+            // fall through
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case '%':
+            if (precision < 0)
+                precision = 6;
+            break;
+        default:
+            return unknownCode(type, typeName);
+    }
+
+    bool negative = signbit(value) && !isnan(value);
+    double magnitude = fabs(value);
+
+    Writer body;
+    initWriter(&body);
+    if (isinf(magnitude) || isnan(magnitude)) {
+        bool upper = type == 'E' || type == 'F' || type == 'G';
+        if (isnan(magnitude))
+            writeCString(&body, upper ? "NAN" : "nan");
+        else
+            writeCString(&body, upper ? "INF" : "inf");
+        if (type == '%')
+            writeChar(&body, '%');
+    } else if (type == 0 && precision < 0) {
+        char buffer[FLOAT_BUFFER_SIZE];
+        writeChars(&body, buffer, formatFloat(buffer, magnitude));
+    } else if (type == 0) {
+        writeGeneralPrecision(&body, precision, magnitude);
+    } else if (type == '%') {
+        writeFixedPrecision(&body, 'f', spec->alternate, precision, magnitude * 100);
+        writeChar(&body, '%');
+    } else {
+        writeFixedPrecision(&body, type, spec->alternate, precision, magnitude);
+    }
+
+    if (negative && spec->noNegativeZero && isZeroText(body.chars, body.length))
+        negative = false;
+
+    int digitCount = spanClass(body.chars, body.length, CLASS_DIGIT);
+    NumberParts parts = {
+        .sign = signChar(negative, spec),
+        .digits = body.chars,
+        .digitCount = digitCount,
+        .rest = body.chars + digitCount,
+        .restLength = body.length - digitCount,
+        .separator = spec->grouping,
+        .groupSize = 3,
+    };
+    writeNumber(writer, spec, &parts);
+    freeWriter(&body);
+    return NONE_VAL;
+}
+
+static Value writeCharacter(Writer *writer, const FormatSpec *spec, long long value) {
+    if (!spec->printf) {
+        if (spec->sign != 0)
+            return createException(VAL_VALUE_ERROR, "Sign not allowed with integer format specifier 'c'");
+        if (spec->alternate)
+            return createException(VAL_VALUE_ERROR, "Alternate form (#) not allowed with integer format specifier 'c'");
+        if (spec->grouping != 0)
+            return createException(VAL_VALUE_ERROR, "Cannot specify '%c' with 'c'.", spec->grouping);
+    }
+    if (value < 0 || value > 0x10ffff)
+        return createException(VAL_VALUE_ERROR, "%%c arg not in range(0x110000)");
+
+    char buffer[4];
+    int length = encodeCodePoint(buffer, value);
+    Padding padding = resolvePadding(spec, '>');
+    writeText(writer, &padding, spec->width, buffer, length, -1);
+    return NONE_VAL;
+}
+
+static Value writeInteger(Writer *writer, const FormatSpec *spec, long long value, const char *typeName) {
+    int base = 10;
+    const char *prefix = NULL;
+    switch (spec->type) {
+        case 0: case 'd': case 'n':
+            break;
+        case 'b':
+            base = 2;
+            prefix = "0b";
+            break;
+        case 'o':
+            base = 8;
+            prefix = "0o";
+            break;
+        case 'x':
+            base = 16;
+            prefix = "0x";
+            break;
+        case 'X':
+            base = 16;
+            prefix = "0X";
+            break;
+        case 'c':
+            if (!spec->printf && spec->precision >= 0)
+                return createException(VAL_VALUE_ERROR, "Precision not allowed in integer format specifier");
+            return writeCharacter(writer, spec, value);
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case '%':
+            return writeDouble(writer, spec, (double)value, typeName);
+        default:
+            return unknownCode(spec->type, typeName);
+    }
+
+    if (!spec->printf) {
+        if (spec->precision >= 0)
+            return createException(VAL_VALUE_ERROR, "Precision not allowed in integer format specifier");
+        if ((spec->grouping == ',' && base != 10) || (spec->grouping != 0 && spec->type == 'n'))
+            return createException(VAL_VALUE_ERROR, "Cannot specify '%c' with '%c'.", spec->grouping, spec->type);
+    }
+
+    char buffer[72];
+    char *digits;
+    int count;
+    if (base == 10) {
+        count = formatInt(buffer, value);
+        digits = value < 0 ? buffer + 1 : buffer;
+        count -= value < 0;
+    } else {
+        const char *symbols = spec->type == 'X' ? "0123456789ABCDEF" : "0123456789abcdef";
+        uint64_t magnitude = value < 0 ? -(uint64_t)value : (uint64_t)value;
+        char *end = buffer + sizeof(buffer);
+        digits = end;
+        do {
+            *--digits = symbols[magnitude % base];
+            magnitude /= base;
+        } while (magnitude != 0);
+        count = end - digits;
+    }
+
+    NumberParts parts = {
+        .sign = signChar(value < 0, spec),
+        .prefix = spec->alternate ? prefix : NULL,
+        .prefixLength = spec->alternate && prefix != NULL ? 2 : 0,
+        .digits = digits,
+        .digitCount = count,
+        .minDigits = spec->printf ? spec->precision : 0,
+        .separator = spec->grouping,
+        .groupSize = base == 10 ? 3 : 4,
+    };
+    writeNumber(writer, spec, &parts);
+    return NONE_VAL;
+}
+
+static Value writeString(Writer *writer, const FormatSpec *spec, ObjString *string) {
+    if (spec->type != 0 && spec->type != 's')
+        return unknownCode(spec->type, "str");
+    if (spec->sign == ' ')
+        return createException(VAL_VALUE_ERROR, "Space not allowed in string format specifier");
+    if (spec->sign != 0)
+        return createException(VAL_VALUE_ERROR, "Sign not allowed in string format specifier");
+    if (spec->alternate)
+        return createException(VAL_VALUE_ERROR, "Alternate form (#) not allowed in string format specifier");
+    if (spec->grouping != 0)
+        return createException(VAL_VALUE_ERROR, "Cannot specify '%c' with 's'.", spec->grouping);
+
+    Padding padding = resolvePadding(spec, '<');
+    if (padding.align == '=')
+        return createException(VAL_VALUE_ERROR, "'=' alignment not allowed in string format specifier");
+    writeText(writer, &padding, spec->width, string->chars, string->length, spec->precision);
+    return NONE_VAL;
+}
+
+static Value specError(const FormatSpec *spec, Value value) {
+    switch (spec->error) {
+        case SPEC_MISSING_PRECISION:
+            return createException(VAL_VALUE_ERROR, "Format specifier missing precision");
+        case SPEC_TOO_LARGE:
+            return createException(VAL_VALUE_ERROR, "Too many decimal digits in format string");
+        default:
+            return createException(VAL_VALUE_ERROR, "Invalid format specifier '%.*s' for object of type '%s'", spec->textLength, spec->text, getValueType(value));
+    }
+}
+
+// format(value, spec) for the built-in types. An empty spec is str(value).
+static Value formatValue(Writer *writer, const FormatSpec *spec, Value value) {
+    if (spec->textLength == 0) {
+        valueWrite(value, writer);
+        return NONE_VAL;
+    }
+    if (spec->error != SPEC_OK)
+        return specError(spec, value);
+
+    switch (value.type) {
+        case VAL_STRING:
+            return writeString(writer, spec, AS_STRING(value));
+        case VAL_BOOL:
+        case VAL_INT:
+            return writeInteger(writer, spec, AS_INT(value), getValueType(value));
+        case VAL_FLOAT:
+            return writeDouble(writer, spec, AS_FLOAT(value), "float");
+        default:
+            return createException(VAL_TYPE_ERROR, "unsupported format string passed to %s.__format__", getValueType(value));
+    }
+}
+
+static Value formatField(Writer *writer, const FormatPiece *piece, const FormatSpec *spec, Value value) {
+    if (piece->conversion == 0)
+        return formatValue(writer, spec, value);
+    if (spec->textLength == 0) {
+        if (piece->conversion == 's')
+            valueWrite(value, writer);
+        else
+            valueReprWrite(value, writer);
+        return NONE_VAL;
+    }
+    ObjString *text = piece->conversion == 's' ? valueToStr(value) : valueToRepr(value);
+    return formatValue(writer, spec, STRING_VAL(text));
+}
+
+static Value lookupField(const FormatPiece *piece, FormatArgs *args, Value *result) {
+    Value value = UNDEFINED_VAL;
+    if (piece->index >= 0) {
+        if (!IS_UNDEFINED(args->mapping))
+            return createException(VAL_VALUE_ERROR, "Format string contains positional fields");
+        if (piece->index >= args->positionalCount)
+            return createException(VAL_INDEX_ERROR, "Replacement index %d out of range for positional args tuple", piece->index);
+        value = args->positional[piece->index];
+    } else if (!IS_UNDEFINED(args->mapping)) {
+        value = valueGetItem(args->mapping, STRING_VAL(piece->name));
+        if (isException(value))
+            return value;
+    } else {
+        for (int i = 0; i < args->keywordCount; i++) {
+            ObjString *name = AS_STRING(args->keywords[2 * i]);
+            if (name == piece->name || (name->length == piece->name->length && memcmp(name->chars, piece->name->chars, name->length) == 0)) {
+                value = args->keywords[2 * i + 1];
+                break;
+            }
+        }
+        if (IS_UNDEFINED(value))
+            return createException(VAL_KEY_ERROR, "'%s'", piece->name->chars);
+    }
+
+    for (int i = 0; i < piece->accessCount; i++) {
+        const FieldAccess *access = &piece->accesses[i];
+        if (access->isAttribute)
+            value = valueGetAttribute(value, access->name);
+        else if (access->name != NULL)
+            value = valueGetItem(value, STRING_VAL(access->name));
+        else
+            value = valueGetItem(value, INT_VAL(access->index));
+        if (isException(value))
+            return value;
+    }
+
+    *result = value;
+    return NONE_VAL;
+}
+
+static Value renderBraces(const FormatTemplate *template, FormatArgs *args, Writer *writer) {
+    for (int i = 0; i < template->pieceCount; i++) {
+        const FormatPiece *piece = &template->pieces[i];
+        if (piece->isLiteral) {
+            writeChars(writer, template->source + piece->start, piece->length);
+            continue;
+        }
+
+        Value value;
+        Value error = lookupField(piece, args, &value);
+        if (!IS_NONE(error))
+            return error;
+
+        if (piece->nestedSpec == NULL) {
+            error = formatField(writer, piece, &piece->spec, value);
+        } else {
+            Writer specText;
+            initWriter(&specText);
+            error = renderBraces(piece->nestedSpec, args, &specText);
+            if (IS_NONE(error)) {
+                FormatSpec spec;
+                parseSpec(specText.chars, specText.length, &spec);
+                error = formatField(writer, piece, &spec, value);
+            }
+            freeWriter(&specText);
+        }
+        if (!IS_NONE(error))
+            return error;
+    }
+    return NONE_VAL;
+}
+
+// One conversion of `%` formatting. Unlike format specs, text is
+// right-aligned by default and the '0' flag only pads numbers.
+static Value formatPercentValue(Writer *writer, FormatSpec *spec, Value value) {
+    char type = spec->type;
+    bool leftAlign = spec->align == '<';
+
+    switch (type) {
+        case 's':
+        case 'r':
+        case 'a': {
+            if (spec->width < 0 && spec->precision < 0) {
+                if (type == 's')
+                    valueWrite(value, writer);
+                else
+                    valueReprWrite(value, writer);
+                return NONE_VAL;
+            }
+            ObjString *text = type == 's' ? valueToStr(value) : valueToRepr(value);
+            Padding padding = {" ", 1, leftAlign ? '<' : '>'};
+            writeText(writer, &padding, spec->width, text->chars, text->length, spec->precision);
+            return NONE_VAL;
+        }
+        case 'c': {
+            if (IS_STRING(value) && stringCodePoints(AS_STRING(value)) == 1) {
+                Padding padding = {" ", 1, leftAlign ? '<' : '>'};
+                writeText(writer, &padding, spec->width, AS_CHARS(value), AS_STRING(value)->length, -1);
+                return NONE_VAL;
+            }
+            if (!IS_INT(value) && !IS_BOOL(value))
+                return createException(VAL_TYPE_ERROR, "%%c requires int or char");
+            return writeCharacter(writer, spec, AS_INT(value));
+        }
+    }
+
+    if (!leftAlign && spec->zero) {
+        spec->fill[0] = '0';
+        spec->align = '=';
+    }
+
+    switch (type) {
+        case 'd':
+        case 'i':
+        case 'u': {
+            long long integer;
+            if (IS_INT(value) || IS_BOOL(value)) {
+                integer = AS_INT(value);
+            } else if (IS_FLOAT(value)) {
+                double number = AS_FLOAT(value);
+                if (isnan(number))
+                    return createException(VAL_VALUE_ERROR, "cannot convert float NaN to integer");
+                if (isinf(number))
+                    return createException(VAL_VALUE_ERROR, "cannot convert float infinity to integer");
+                if (number >= 9223372036854775808.0 || number < -9223372036854775808.0)
+                    return createException(VAL_VALUE_ERROR, "int too large to convert");
+                integer = (long long)number;
+            } else {
+                return createException(VAL_TYPE_ERROR, "%%%c format: a real number is required, not %s", type, getValueType(value));
+            }
+            spec->type = 'd';
+            return writeInteger(writer, spec, integer, "int");
+        }
+        case 'o':
+        case 'x':
+        case 'X':
+            if (!IS_INT(value) && !IS_BOOL(value))
+                return createException(VAL_TYPE_ERROR, "%%%c format: an integer is required, not %s", type, getValueType(value));
+            return writeInteger(writer, spec, AS_INT(value), "int");
+        default: {
+            double number;
+            if (IS_INT(value) || IS_BOOL(value))
+                number = AS_INT(value);
+            else if (IS_FLOAT(value))
+                number = AS_FLOAT(value);
+            else
+                return createException(VAL_TYPE_ERROR, "must be real number, not %s", getValueType(value));
+            return writeDouble(writer, spec, number, "float");
+        }
+    }
+}
+
+static Value nextArgument(FormatArgs *args, int *next, Value *value) {
+    if (*next >= args->positionalCount)
+        return createException(VAL_TYPE_ERROR, "not enough arguments for format string");
+    *value = args->positional[(*next)++];
+    return NONE_VAL;
+}
+
+static Value starArgument(FormatArgs *args, int *next, int *result) {
+    Value value;
+    Value error = nextArgument(args, next, &value);
+    if (!IS_NONE(error))
+        return error;
+    if (!IS_INT(value))
+        return createException(VAL_TYPE_ERROR, "* wants int");
+    if (AS_INT(value) > INT_MAX || AS_INT(value) < -INT_MAX)
+        return createException(VAL_VALUE_ERROR, "width too big");
+    *result = AS_INT(value);
+    return NONE_VAL;
+}
+
+static Value renderPercent(const FormatTemplate *template, FormatArgs *args, Writer *writer) {
+    bool hasMapping = !IS_UNDEFINED(args->mapping);
+    if (template->usesNames && !hasMapping)
+        return createException(VAL_TYPE_ERROR, "format requires a mapping");
+
+    int next = 0;
+    for (int i = 0; i < template->pieceCount; i++) {
+        const FormatPiece *piece = &template->pieces[i];
+        if (piece->isLiteral) {
+            writeChars(writer, template->source + piece->start, piece->length);
+            continue;
+        }
+
+        FormatSpec spec = piece->spec;
+        Value error;
+        if (piece->widthFromArgs) {
+            error = starArgument(args, &next, &spec.width);
+            if (!IS_NONE(error))
+                return error;
+            if (spec.width < 0) {
+                spec.align = '<';
+                spec.width = -spec.width;
+            }
+        }
+        if (piece->precisionFromArgs) {
+            error = starArgument(args, &next, &spec.precision);
+            if (!IS_NONE(error))
+                return error;
+            if (spec.precision < 0)
+                spec.precision = 0;
+        }
+
+        Value value;
+        if (piece->name != NULL) {
+            value = valueGetItem(args->mapping, STRING_VAL(piece->name));
+            if (isException(value))
+                return value;
+        } else {
+            error = nextArgument(args, &next, &value);
+            if (!IS_NONE(error))
+                return error;
+        }
+
+        error = formatPercentValue(writer, &spec, value);
+        if (!IS_NONE(error))
+            return error;
+    }
+
+    if (!hasMapping && next < args->positionalCount)
+        return createException(VAL_TYPE_ERROR, "not all arguments converted during string formatting");
+    return NONE_VAL;
+}
+
+Value formatTemplate(ObjString *string, TemplateSyntax syntax, FormatArgs *args) {
+    FormatTemplate *template;
+    Value error = getTemplate(string, syntax, &template);
+    if (!IS_NONE(error))
+        return error;
+
+    Writer writer;
+    initWriter(&writer);
+    template->rendering++;
+    if (syntax == TEMPLATE_BRACES)
+        error = renderBraces(template, args, &writer);
+    else
+        error = renderPercent(template, args, &writer);
+    if (--template->rendering == 0 && template->detached)
+        freeFormatTemplate(template);
+    if (!IS_NONE(error)) {
+        freeWriter(&writer);
+        return error;
+    }
+    return STRING_VAL(writerToString(&writer));
+}
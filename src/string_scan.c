@@ -0,0 +1,150 @@
+#include <string.h>
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "string_scan.h"
+
+#define BLOCK_WIDTH 16
+
+typedef uint32_t BlockMask;
+
+#define FULL_MASK ((BlockMask)0xffff)
+
+#define LOWEST_BIT(mask)  __builtin_ctz(mask)
+#define HIGHEST_BIT(mask) (31 - __builtin_clz(mask))
+
+bool inClass(char c, CharClass class) {
+    switch (class) {
+        case CLASS_SPACE:
+            return c == ' ' || ('\t' <= c && c <= '\r') || ('\x1c' <= c && c <= '\x1f');
+        case CLASS_DIGIT:
+            return '0' <= c && c <= '9';
+        case CLASS_LOWER:
+            return 'a' <= c && c <= 'z';
+        case CLASS_UPPER:
+            return 'A' <= c && c <= 'Z';
+        case CLASS_ALPHA:
+            return 'a' <= (c | 0x20) && (c | 0x20) <= 'z';
+        case CLASS_ALNUM:
+            return inClass(c, CLASS_ALPHA) || inClass(c, CLASS_DIGIT);
+    }
+    return false;
+}
+
+#ifdef __SSE2__
+
+// Bytes of x within [low, high]. Both bounds are ASCII, so the signed
+// compares reject every non-ASCII byte.
+static __m128i inRange(__m128i x, char low, char high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(low - 1)),
+                         _mm_cmplt_epi8(x, _mm_set1_epi8(high + 1)));
+}
+
+static __m128i classBytes(__m128i x, CharClass class) {
+    switch (class) {
+        case CLASS_SPACE:
+            return _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')),
+                   _mm_or_si128(inRange(x, '\t', '\r'), inRange(x, '\x1c', '\x1f')));
+        case CLASS_DIGIT:
+            return inRange(x, '0', '9');
+        case CLASS_LOWER:
+            return inRange(x, 'a', 'z');
+        case CLASS_UPPER:
+            return inRange(x, 'A', 'Z');
+        case CLASS_ALPHA:
+            return inRange(_mm_or_si128(x, _mm_set1_epi8(0x20)), 'a', 'z');
+        case CLASS_ALNUM:
+            return _mm_or_si128(classBytes(x, CLASS_ALPHA), inRange(x, '0', '9'));
+    }
+    return _mm_setzero_si128();
+}
+
+// One bit per byte of chars[0, BLOCK_WIDTH) that is in the class.
+static BlockMask classMask(const char *chars, CharClass class) {
+    __m128i block = _mm_loadu_si128((const __m128i*)chars);
+    return _mm_movemask_epi8(classBytes(block, class));
+}
+
+// Flips the case of the bytes of src[0, BLOCK_WIDTH) in the letter class.
+static void mapBlock(char *dest, const char *src, CharClass class) {
+    __m128i block = _mm_loadu_si128((const __m128i*)src);
+    __m128i letters = classBytes(block, class);
+    block = _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+    _mm_storeu_si128((__m128i*)dest, block);
+}
+
+#else
+
+static BlockMask classMask(const char *chars, CharClass class) {
+    BlockMask mask = 0;
+    for (int i = 0; i < BLOCK_WIDTH; i++)
+        if (inClass(chars[i], class))
+            mask |= 1u << i;
+    return mask;
+}
+
+#endif
+
+size_t spanClass(const char *chars, size_t length, CharClass class) {
+    size_t i = 0;
+    for (; i + BLOCK_WIDTH <= length; i += BLOCK_WIDTH) {
+        BlockMask outside = ~classMask(chars + i, class) & FULL_MASK;
+        if (outside)
+            return i + LOWEST_BIT(outside);
+    }
+    while (i < length && inClass(chars[i], class))
+        i++;
+    return i;
+}
+
+size_t rspanClass(const char *chars, size_t length, CharClass class) {
+    size_t i = length;
+    for (; i >= BLOCK_WIDTH; i -= BLOCK_WIDTH) {
+        BlockMask outside = ~classMask(chars + i - BLOCK_WIDTH, class) & FULL_MASK;
+        if (outside)
+            return length - (i - BLOCK_WIDTH + HIGHEST_BIT(outside) + 1);
+    }
+    while (i > 0 && inClass(chars[i - 1], class))
+        i--;
+    return length - i;
+}
+
+size_t findClass(const char *chars, size_t length, CharClass class) {
+    size_t i = 0;
+    for (; i + BLOCK_WIDTH <= length; i += BLOCK_WIDTH) {
+        BlockMask inside = classMask(chars + i, class);
+        if (inside)
+            return i + LOWEST_BIT(inside);
+    }
+    while (i < length && !inClass(chars[i], class))
+        i++;
+    return i;
+}
+
+long long rfindClass(const char *chars, size_t length, CharClass class) {
+    size_t i = length;
+    for (; i >= BLOCK_WIDTH; i -= BLOCK_WIDTH) {
+        BlockMask inside = classMask(chars + i - BLOCK_WIDTH, class);
+        if (inside)
+            return i - BLOCK_WIDTH + HIGHEST_BIT(inside);
+    }
+    while (i > 0) {
+        if (inClass(chars[--i], class))
+            return i;
+    }
+    return -1;
+}
+
+void mapAsciiCase(char *dest, const char *src, size_t length, CaseMapping mapping) {
+    CharClass letters = mapping == CASE_UPPER ? CLASS_LOWER : mapping == CASE_LOWER ? CLASS_UPPER : CLASS_ALPHA;
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + BLOCK_WIDTH <= length; i += BLOCK_WIDTH)
+        mapBlock(dest + i, src + i, letters);
+#endif
+    for (; i < length; i++)
+        dest[i] = inClass(src[i], letters) ? src[i] ^ 0x20 : src[i];
+}
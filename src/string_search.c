@@ -0,0 +1,255 @@
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "string_search.h"
+
+#define BLOCK_WIDTH 16
+
+#define LOWEST_BIT(mask)  __builtin_ctz(mask)
+#define HIGHEST_BIT(mask) (31 - __builtin_clz(mask))
+
+// Below this length the first/last byte filter wins over Two-Way's
+// preprocessing, and its worst case stays a small constant times the haystack
+// length.
+#define TWO_WAY_THRESHOLD 8
+
+// Reverse searches run the same algorithms over both strings read backwards.
+static inline uint8_t byteAt(const char *s, size_t length, size_t i, bool reverse) {
+    return (uint8_t)(reverse ? s[length - 1 - i] : s[i]);
+}
+
+// Splits the needle into u.v where v is the larger of its maximal suffixes for
+// the two alphabet orders; returns |u| and stores the period of v.
+static size_t criticalFactorization(const char *needle, size_t m, bool reverse, size_t *period) {
+    size_t maxSuffix = SIZE_MAX, j = 0, k = 1, p = 1;
+    while (j + k < m) {
+        uint8_t a = byteAt(needle, m, j + k, reverse);
+        uint8_t b = byteAt(needle, m, maxSuffix + k, reverse);
+        if (a < b) {
+            j += k;
+            k = 1;
+            p = j - maxSuffix;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            maxSuffix = j++;
+            k = p = 1;
+        }
+    }
+    *period = p;
+
+    size_t maxSuffixRev = SIZE_MAX;
+    j = 0;
+    k = p = 1;
+    while (j + k < m) {
+        uint8_t a = byteAt(needle, m, j + k, reverse);
+        uint8_t b = byteAt(needle, m, maxSuffixRev + k, reverse);
+        if (b < a) {
+            j += k;
+            k = 1;
+            p = j - maxSuffixRev;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            maxSuffixRev = j++;
+            k = p = 1;
+        }
+    }
+
+    if (maxSuffixRev + 1 < maxSuffix + 1)
+        return maxSuffix + 1;
+    *period = p;
+    return maxSuffixRev + 1;
+}
+
+void initSearcher(Searcher *searcher, const char *needle, size_t length, bool reverse) {
+    searcher->needle = needle;
+    searcher->length = length;
+    searcher->reverse = reverse;
+    searcher->twoWay = length >= TWO_WAY_THRESHOLD;
+    searcher->periodic = false;
+    searcher->suffix = 0;
+    searcher->period = 0;
+    if (!searcher->twoWay)
+        return;
+
+    size_t period;
+    size_t suffix = criticalFactorization(needle, length, reverse, &period);
+
+    // The left part repeats with the period of the right one: after a full
+    // match the next window can reuse what is already known to match.
+    bool periodic = true;
+    for (size_t i = 0; i < suffix && periodic; i++)
+        periodic = byteAt(needle, length, i, reverse) == byteAt(needle, length, i + period, reverse);
+
+    searcher->suffix = suffix;
+    searcher->periodic = periodic;
+    searcher->period = periodic ? period : (suffix > length - suffix ? suffix : length - suffix) + 1;
+}
+
+static long long twoWay(Searcher *searcher, const char *haystack, size_t n) {
+    const char *needle = searcher->needle;
+    size_t m = searcher->length;
+    bool reverse = searcher->reverse;
+    size_t suffix = searcher->suffix;
+    size_t period = searcher->period;
+    size_t j = 0;
+
+    if (searcher->periodic) {
+        size_t memory = 0;
+        while (j <= n - m) {
+            size_t i = suffix > memory ? suffix : memory;
+            while (i < m && byteAt(needle, m, i, reverse) == byteAt(haystack, n, i + j, reverse))
+                i++;
+            if (i >= m) {
+                i = suffix - 1;
+                while (memory < i + 1 && byteAt(needle, m, i, reverse) == byteAt(haystack, n, i + j, reverse))
+                    i--;
+                if (i + 1 < memory + 1)
+                    return j;
+                j += period;
+                memory = m - period;
+            } else {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        while (j <= n - m) {
+            size_t i = suffix;
+            while (i < m && byteAt(needle, m, i, reverse) == byteAt(haystack, n, i + j, reverse))
+                i++;
+            if (i >= m) {
+                i = suffix - 1;
+                while (i != SIZE_MAX && byteAt(needle, m, i, reverse) == byteAt(haystack, n, i + j, reverse))
+                    i--;
+                if (i == SIZE_MAX)
+                    return j;
+                j += period;
+            } else {
+                j += i - suffix + 1;
+            }
+        }
+    }
+    return -1;
+}
+
+#ifdef __SSE2__
+// One bit per start position in s[0, BLOCK_WIDTH) whose first and last bytes
+// both match the needle's; only those are worth a memcmp.
+static inline uint32_t candidateMask(const char *s, size_t m, __m128i first, __m128i last) {
+    __m128i head = _mm_loadu_si128((const __m128i*)s);
+    __m128i tail = _mm_loadu_si128((const __m128i*)(s + m - 1));
+    return _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+}
+#endif
+
+static long long filterForward(const char *haystack, size_t n, const char *needle, size_t m) {
+    const char *end = haystack + n - m + 1;
+    const char *p = haystack;
+    char last = needle[m - 1];
+#ifdef __SSE2__
+    __m128i firstBytes = _mm_set1_epi8(needle[0]);
+    __m128i lastBytes = _mm_set1_epi8(last);
+    for (; end - p >= BLOCK_WIDTH; p += BLOCK_WIDTH) {
+        uint32_t mask = candidateMask(p, m, firstBytes, lastBytes);
+        while (mask != 0) {
+            int i = LOWEST_BIT(mask);
+            if (memcmp(p + i, needle, m) == 0)
+                return p + i - haystack;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    while (p < end) {
+        p = memchr(p, needle[0], end - p);
+        if (p == NULL)
+            return -1;
+        if (p[m - 1] == last && memcmp(p, needle, m) == 0)
+            return p - haystack;
+        p++;
+    }
+    return -1;
+}
+
+static long long filterBackward(const char *haystack, size_t n, const char *needle, size_t m) {
+    char first = needle[0];
+    char last = needle[m - 1];
+    size_t j = n - m + 1;
+#ifdef __SSE2__
+    __m128i firstBytes = _mm_set1_epi8(first);
+    __m128i lastBytes = _mm_set1_epi8(last);
+    for (; j >= BLOCK_WIDTH; j -= BLOCK_WIDTH) {
+        const char *p = haystack + j - BLOCK_WIDTH;
+        uint32_t mask = candidateMask(p, m, firstBytes, lastBytes);
+        while (mask != 0) {
+            int i = HIGHEST_BIT(mask);
+            if (memcmp(p + i, needle, m) == 0)
+                return p + i - haystack;
+            mask &= ~(1u << i);
+        }
+    }
+#endif
+    while (j-- > 0) {
+        if (haystack[j + m - 1] == last && haystack[j] == first && memcmp(haystack + j, needle, m) == 0)
+            return j;
+    }
+    return -1;
+}
+
+long long searchIn(Searcher *searcher, const char *haystack, size_t length) {
+    size_t m = searcher->length;
+    if (m == 0)
+        return searcher->reverse ? (long long)length : 0;
+    if (m > length)
+        return -1;
+
+    if (m == 1) {
+        if (!searcher->reverse) {
+            const char *p = memchr(haystack, searcher->needle[0], length);
+            return p == NULL ? -1 : p - haystack;
+        }
+        for (size_t j = length; j-- > 0;) {
+            if (haystack[j] == searcher->needle[0])
+                return j;
+        }
+        return -1;
+    }
+
+    if (!searcher->twoWay) {
+        if (searcher->reverse)
+            return filterBackward(haystack, length, searcher->needle, m);
+        return filterForward(haystack, length, searcher->needle, m);
+    }
+
+    long long index = twoWay(searcher, haystack, length);
+    if (index < 0 || !searcher->reverse)
+        return index;
+    return length - index - m;
+}
+
+long long findSubstring(const char *haystack, size_t length, const char *needle, size_t needleLength) {
+    Searcher searcher;
+    initSearcher(&searcher, needle, needleLength, false);
+    return searchIn(&searcher, haystack, length);
+}
+
+long long rfindSubstring(const char *haystack, size_t length, const char *needle, size_t needleLength) {
+    Searcher searcher;
+    initSearcher(&searcher, needle, needleLength, true);
+    return searchIn(&searcher, haystack, length);
+}
@@ -1,158 +1,400 @@
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "table.h"
 #include "memory.h"
 #include "value_methods.h"
 #include "value_int.h"
+#include "object_string.h"
 
-#define MAX_LOAD_FACTOR 0.66
+#define MIN_CAPACITY 8
 
-#define TOMBSTONE ((Value){.type=VAL_UNDEFINED, .as.integer=1})
-#define IS_TOMBSTONE(value) (value.type == VAL_UNDEFINED && value.as.integer == 1)
+#define INDEX_EMPTY (-1)
+#define INDEX_DUMMY (-2)
+
+#define PERTURB_SHIFT 5
+
+#define USABLE(capacity) ((capacity) * 2 / 3)
+
+typedef struct {
+    ObjString *key;
+    Value value;
+} StringEntry;
+
+typedef struct {
+    long long key;
+    Value value;
+} IntEntry;
+
+typedef struct {
+    uint64_t hash;
+    Value key;
+    Value value;
+} Entry;
+
+#define STRING_ENTRIES(table) ((StringEntry*)(table)->entries)
+#define INT_ENTRIES(table)    ((IntEntry*)(table)->entries)
+#define ENTRIES(table)        ((Entry*)(table)->entries)
 
 void tableInit(Table *table) {
+    table->kind = TABLE_EMPTY;
     table->size = 0;
+    table->used = 0;
+    table->fill = 0;
     table->capacity = 0;
+    table->indices = NULL;
     table->entries = NULL;
-    table->order = NULL;
+}
+
+static size_t indexWidth(size_t capacity) {
+    if (capacity <= (size_t)INT8_MAX + 1)
+        return sizeof(int8_t);
+    if (capacity <= (size_t)INT16_MAX + 1)
+        return sizeof(int16_t);
+    if (capacity <= (size_t)INT32_MAX + 1)
+        return sizeof(int32_t);
+    return sizeof(int64_t);
+}
+
+static size_t entrySize(TableKind kind) {
+    switch (kind) {
+        case TABLE_STRING_KEYS: return sizeof(StringEntry);
+        case TABLE_INT_KEYS:    return sizeof(IntEntry);
+        default:                return sizeof(Entry);
+    }
 }
 
 void tableFree(Table *table) {
-    reallocate(table->entries, table->capacity * sizeof(Entry), 0);
+    reallocate(table->indices, indexWidth(table->capacity) * table->capacity, 0);
+    reallocate(table->entries, entrySize(table->kind) * USABLE(table->capacity), 0);
     tableInit(table);
 }
 
-static Entry *findEntry(Entry *entries, int capacity, Value key) {
-    uint64_t hash = valueHash(key);
-    int step = 7 - (hash % 7);
-    Entry *tombstone = NULL;
+static int64_t getIndex(Table *table, size_t slot) {
+    switch (indexWidth(table->capacity)) {
+        case sizeof(int8_t):  return ((int8_t*)table->indices)[slot];
+        case sizeof(int16_t): return ((int16_t*)table->indices)[slot];
+        case sizeof(int32_t): return ((int32_t*)table->indices)[slot];
+        default:              return ((int64_t*)table->indices)[slot];
+    }
+}
 
-    for (int i = 0; i < capacity; i++) {
-        int index = (hash + i * step) % capacity;
+static void setIndex(Table *table, size_t slot, int64_t index) {
+    switch (indexWidth(table->capacity)) {
+        case sizeof(int8_t):  ((int8_t*)table->indices)[slot] = index; break;
+        case sizeof(int16_t): ((int16_t*)table->indices)[slot] = index; break;
+        case sizeof(int32_t): ((int32_t*)table->indices)[slot] = index; break;
+        default:              ((int64_t*)table->indices)[slot] = index; break;
+    }
+}
 
-        Entry *entry = &entries[index];
+uint64_t tableKeyHash(Value key) {
+    switch (key.type) {
+        case VAL_STRING: return String_Hash(key);
+        case VAL_INT:    return Int_Hash(key);
+        default:         return valueHash(key);
+    }
+}
 
-        if (IS_TOMBSTONE(entry->key)) {
-            if (tombstone == NULL)
-                tombstone = entry;
-        } else if (IS_UNDEFINED(entry->key))
-            return tombstone == NULL ? entry : tombstone;
-        else if (AS_BOOL(valueEqual(key, entry->key)))
-            return entry;
+static Value *entryValue(Table *table, size_t index) {
+    switch (table->kind) {
+        case TABLE_STRING_KEYS: return &STRING_ENTRIES(table)[index].value;
+        case TABLE_INT_KEYS:    return &INT_ENTRIES(table)[index].value;
+        default:                return &ENTRIES(table)[index].value;
     }
-    return NULL;
 }
 
-static void resizeTable(Table *table, int capacity) {
-    Entry *entries = reallocate(NULL, 0, sizeof(Entry) * capacity);
-    Entry **order = reallocate(NULL, 0, sizeof(Entry*) * capacity);
+static Value entryKey(Table *table, size_t index) {
+    switch (table->kind) {
+        case TABLE_STRING_KEYS: return STRING_VAL(STRING_ENTRIES(table)[index].key);
+        case TABLE_INT_KEYS:    return INT_VAL(INT_ENTRIES(table)[index].key);
+        default:                return ENTRIES(table)[index].key;
+    }
+}
 
-    for (int i = 0; i < capacity; i++) {
-        entries[i].key = UNDEFINED_VAL;
-        entries[i].value = UNDEFINED_VAL;
+static uint64_t entryHash(Table *table, size_t index) {
+    switch (table->kind) {
+        case TABLE_STRING_KEYS: return STRING_ENTRIES(table)[index].key->hash;
+        case TABLE_INT_KEYS:    return Int_Hash(INT_VAL(INT_ENTRIES(table)[index].key));
+        default:                return ENTRIES(table)[index].hash;
     }
+}
 
-    for (int i = 0; i < table->size; i++) {
-        Entry *entry = table->order[i]; 
+static bool isHole(Table *table, size_t index) {
+    return IS_UNDEFINED(*entryValue(table, index));
+}
+
+static bool stringsEqual(ObjString *a, ObjString *b) {
+    if (a == b)
+        return true;
+    if (a->length != b->length || (a->isInterned && b->isInterned))
+        return false;
+    return memcmp(a->chars, b->chars, a->length) == 0;
+}
+
+// Only called once the hashes matched; common key types skip dispatch.
+bool tableKeysEqual(Value a, Value b) {
+    if (a.type == b.type) {
+        switch (a.type) {
+            case VAL_NONE:
+                return true;
+            case VAL_BOOL:
+            case VAL_INT:
+                return a.as.integer == b.as.integer;
+            case VAL_STRING:
+                return stringsEqual(AS_STRING(a), AS_STRING(b));
+            default:
+                break;
+        }
+    }
+    return valueToBool(valueEqual(a, b));
+}
 
-        if (IS_UNDEFINED(entry->key))
+// Whether the key at entries[index] equals `key`. Keys whose type matches a
+// specialized layout are compared directly; anything else goes through the
+// boxed key so that e.g. True still finds 1 in an int-keyed table.
+static bool entryMatches(Table *table, size_t index, Value key, uint64_t hash) {
+    if (table->kind == TABLE_STRING_KEYS && IS_STRING(key)) {
+        ObjString *entryKey = STRING_ENTRIES(table)[index].key;
+        return entryKey == AS_STRING(key) || (entryKey->hash == hash && stringsEqual(entryKey, AS_STRING(key)));
+    }
+    if (table->kind == TABLE_INT_KEYS && IS_INT(key))
+        return INT_ENTRIES(table)[index].key == AS_INT(key);
+    if (table->kind == TABLE_GENERIC) {
+        Entry *entry = &ENTRIES(table)[index];
+        return entry->hash == hash && tableKeysEqual(key, entry->key);
+    }
+    return entryHash(table, index) == hash && tableKeysEqual(key, entryKey(table, index));
+}
+
+// Open addressing with CPython's perturbed probe: every bit of the hash
+// eventually takes part, and the sequence visits every slot of the table.
+#define NEXT_SLOT(slot, perturb, mask) \
+    (((slot) * 5 + ((perturb) >>= PERTURB_SHIFT) + 1) & (mask))
+
+// Returns the entry index of key or INDEX_EMPTY. *slot receives the index slot
+// holding the key or, when missing, the first free slot it could go into.
+static int64_t findSlot(Table *table, Value key, uint64_t hash, size_t *slot) {
+    size_t mask = table->capacity - 1;
+    uint64_t perturb = hash;
+    size_t current = hash & mask;
+    bool haveFree = false;
+
+    for (;;) {
+        int64_t index = getIndex(table, current);
+
+        if (index == INDEX_EMPTY) {
+            if (!haveFree)
+                *slot = current;
+            return INDEX_EMPTY;
+        }
+        if (index == INDEX_DUMMY) {
+            if (!haveFree) {
+                *slot = current;
+                haveFree = true;
+            }
+        } else if (entryMatches(table, index, key, hash)) {
+            *slot = current;
+            return index;
+        }
+        current = NEXT_SLOT(current, perturb, mask);
+    }
+}
+
+static void writeEntry(Table *table, size_t index, Value key, uint64_t hash, Value value) {
+    switch (table->kind) {
+        case TABLE_STRING_KEYS:
+            STRING_ENTRIES(table)[index] = (StringEntry){AS_STRING(key), value};
+            break;
+        case TABLE_INT_KEYS:
+            INT_ENTRIES(table)[index] = (IntEntry){AS_INT(key), value};
+            break;
+        default:
+            ENTRIES(table)[index] = (Entry){hash, key, value};
+            break;
+    }
+}
+
+// Rebuilds the table with the given layout and room for at least `size` live
+// entries, compacting holes out of the entries array on the way.
+static void rebuildTable(Table *table, size_t size, TableKind kind) {
+    size_t capacity = MIN_CAPACITY;
+    while (USABLE(capacity) <= size)
+        capacity *= 2;
+
+    Table rebuilt;
+    tableInit(&rebuilt);
+    rebuilt.kind = kind;
+    rebuilt.capacity = capacity;
+    rebuilt.indices = reallocate(NULL, 0, indexWidth(capacity) * capacity);
+    rebuilt.entries = reallocate(NULL, 0, entrySize(kind) * USABLE(capacity));
+
+    for (size_t slot = 0; slot < capacity; slot++)
+        setIndex(&rebuilt, slot, INDEX_EMPTY);
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < table->used; i++) {
+        if (isHole(table, i))
             continue;
-        
-        Entry *dest = findEntry(entries, capacity, entry->key);
-        dest->key = entry->key;
-        dest->value = entry->value;
-        order[i] = dest;
+
+        uint64_t hash = entryHash(table, i);
+        uint64_t perturb = hash;
+        size_t slot = hash & mask;
+        while (getIndex(&rebuilt, slot) != INDEX_EMPTY)
+            slot = NEXT_SLOT(slot, perturb, mask);
+
+        setIndex(&rebuilt, slot, rebuilt.size);
+        writeEntry(&rebuilt, rebuilt.size++, entryKey(table, i), hash, *entryValue(table, i));
     }
 
-    FREE_VEC(Entry, table->entries, table->capacity);
-    FREE_VEC(Entry*, table->order, table->capacity);
-    table->entries = entries;
-    table->order = order;
-    table->capacity = capacity;
+    rebuilt.used = rebuilt.size;
+    rebuilt.fill = rebuilt.size;
+
+    tableFree(table);
+    *table = rebuilt;
+}
+
+static TableKind kindForKey(Value key) {
+    switch (key.type) {
+        case VAL_STRING: return TABLE_STRING_KEYS;
+        case VAL_INT:    return TABLE_INT_KEYS;
+        default:         return TABLE_GENERIC;
+    }
 }
 
 Value tableGet(Table *table, Value key) {
-    Entry *entry = findEntry(table->entries, table->capacity, key);
-    if (entry == NULL || IS_TOMBSTONE(entry->key))
+    if (table->size == 0)
+        return UNDEFINED_VAL;
+
+    size_t slot;
+    int64_t index = findSlot(table, key, tableKeyHash(key), &slot);
+    if (index == INDEX_EMPTY)
         return UNDEFINED_VAL;
-    return entry->value;
+    return *entryValue(table, index);
 }
 
 bool tableSet(Table *table, Value key, Value value) {
-    if (table->size + 1 >= table->capacity * MAX_LOAD_FACTOR) {
-        resizeTable(table, GROW_CAPACITY(table->capacity));
-    }
-
-    Entry *entry = findEntry(table->entries, table->capacity, key);
+    uint64_t hash = tableKeyHash(key);
+    size_t slot;
 
-    if (entry == NULL) {
-        resizeTable(table, GROW_CAPACITY(table->capacity));
-        entry = findEntry(table->entries, table->capacity, key);
+    if (table->capacity != 0) {
+        int64_t index = findSlot(table, key, hash, &slot);
+        if (index != INDEX_EMPTY) {
+            *entryValue(table, index) = value;
+            return false;
+        }
     }
 
-    bool isNew = IS_UNDEFINED(entry->key);
+    TableKind kind = table->kind;
+    if (kind == TABLE_EMPTY)
+        kind = kindForKey(key);
+    else if (kind != TABLE_GENERIC && kind != kindForKey(key))
+        kind = TABLE_GENERIC;
 
-    if (isNew)
-        table->order[table->size++] = entry;
+    size_t usable = USABLE(table->capacity);
+    if (kind != table->kind || table->used >= usable || table->fill >= usable) {
+        rebuildTable(table, table->size * 2 + 1, kind);
+        findSlot(table, key, hash, &slot);
+    }
 
-    entry->key = key;
-    entry->value = value;
+    if (getIndex(table, slot) == INDEX_EMPTY)
+        table->fill++;
 
-    return isNew;
+    setIndex(table, slot, table->used);
+    writeEntry(table, table->used, key, hash, value);
+    table->used++;
+    table->size++;
+    return true;
 }
 
-static void removeFromOrder(Table *table, Entry *entry) {
-    int i = 0;
-    for (; table->order[i] != entry; i++);
+static void removeEntry(Table *table, size_t slot, int64_t index) {
+    setIndex(table, slot, INDEX_DUMMY);
+    *entryValue(table, index) = UNDEFINED_VAL;
+    table->size--;
 
-    for (; i < table->size - 1; i++)
-        table->order[i] = table->order[i + 1];
+    while (table->used > 0 && isHole(table, table->used - 1))
+        table->used--;
 }
 
 Value tableDelete(Table *table, Value key) {
     if (table->size == 0)
         return UNDEFINED_VAL;
 
-    Entry *entry = findEntry(table->entries, table->capacity, key);
-
-    if (IS_UNDEFINED(entry->key))
+    size_t slot;
+    int64_t index = findSlot(table, key, tableKeyHash(key), &slot);
+    if (index == INDEX_EMPTY)
         return UNDEFINED_VAL;
-    
-    removeFromOrder(table, entry);
 
-    Value result = entry->value;
-    
-    entry->key = TOMBSTONE;
-    entry->value = UNDEFINED_VAL;
-    table->size--;
+    Value result = *entryValue(table, index);
+    removeEntry(table, slot, index);
     return result;
 }
 
+// Removes the most recently inserted entry, as dict.popitem() does.
+bool tablePopLast(Table *table, Value *key, Value *value) {
+    if (table->size == 0)
+        return false;
+
+    size_t last = table->used - 1;
+    *key = entryKey(table, last);
+    *value = *entryValue(table, last);
+
+    size_t slot;
+    findSlot(table, *key, entryHash(table, last), &slot);
+    removeEntry(table, slot, last);
+    return true;
+}
+
+// Stores the first live entry at or after *index in key and value and
+// advances *index past it. Returns false once the entries are exhausted.
+bool tableNext(Table *table, size_t *index, Value *key, Value *value) {
+    while (*index < table->used) {
+        size_t current = (*index)++;
+        if (!isHole(table, current)) {
+            *key = entryKey(table, current);
+            *value = *entryValue(table, current);
+            return true;
+        }
+    }
+    return false;
+}
+
 bool compareTables(Table *a, Table *b) {
     if (a->size != b->size)
         return false;
-    
-    for (int i = 0; i < a->size; i++) {
-        Entry *entry = a->order[i];
-        Value value = tableGet(b, entry->key);
-        if (!valueToBool(valueEqual(entry->value, value)))
+
+    size_t i = 0;
+    Value key, value;
+    while (tableNext(a, &i, &key, &value)) {
+        Value other = tableGet(b, key);
+        if (IS_UNDEFINED(other) || !valueToBool(valueEqual(value, other)))
             return false;
     }
     return true;
 }
 
+void markTable(Table *table) {
+    size_t i = 0;
+    Value key, value;
+    while (tableNext(table, &i, &key, &value)) {
+        markValue(key);
+        markValue(value);
+    }
+}
+
 void tableDebug(Table *table) {
-    printf("size: %d, capacity: %d\n", table->size, table->capacity);
-
-    for (int i = 0; i < table->size; i++) {
-        Entry *entry = table->order[i];
-        printf("%2d | ", i);
-        if (IS_TOMBSTONE(entry->key))
-            printf("tombstone");
-        else
-            valueRepr(entry->key);
+    printf("kind: %d, size: %zu, used: %zu, capacity: %zu\n", table->kind, table->size, table->used, table->capacity);
+
+    for (size_t i = 0; i < table->used; i++) {
+        printf("%2zu | ", i);
+        if (isHole(table, i)) {
+            printf("hole\n");
+            continue;
+        }
+        valueRepr(entryKey(table, i));
         printf(" : ");
-        valueRepr(entry->value);
+        valueRepr(*entryValue(table, i));
         printf("\n");
     }
-}
\ No newline at end of file
+}
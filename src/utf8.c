@@ -0,0 +1,78 @@
+#include <string.h>
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "utf8.h"
+
+#define BLOCK_WIDTH 16
+
+#define HIGH_BITS 0x8080808080808080ull
+#define LOW_BITS  0x0101010101010101ull
+
+// One in the low bit of every byte of the word that continues a code point.
+static uint64_t continuationBits(uint64_t word) {
+    return (word >> 7) & ~(word >> 6) & LOW_BITS;
+}
+
+size_t countCodePoints(const char *chars, size_t length) {
+    size_t continuations = 0;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    // Continuation bytes, 0x80 to 0xbf, are exactly the signed bytes below
+    // -64; an all-ASCII block has no sign bits and is skipped outright.
+    const __m128i limit = _mm_set1_epi8(-64);
+    for (; i + BLOCK_WIDTH <= length; i += BLOCK_WIDTH) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(chars + i));
+        if (_mm_movemask_epi8(block) == 0)
+            continue;
+        continuations += __builtin_popcount(_mm_movemask_epi8(_mm_cmplt_epi8(block, limit)));
+    }
+#endif
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, chars + i, sizeof(word));
+        if ((word & HIGH_BITS) == 0)
+            continue;
+        // Sums the per-byte flags into the top byte; at most eight, so no
+        // carries cross bytes.
+        continuations += (continuationBits(word) * LOW_BITS) >> 56;
+    }
+    for (; i < length; i++)
+        continuations += IS_CONTINUATION_BYTE(chars[i]);
+
+    return length - continuations;
+}
+
+size_t nextCodePoint(const char *chars, size_t length, size_t offset) {
+    offset++;
+    while (offset < length && IS_CONTINUATION_BYTE(chars[offset]))
+        offset++;
+    return offset;
+}
+
+int encodeCodePoint(char *buffer, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        buffer[0] = codePoint;
+        return 1;
+    }
+    if (codePoint < 0x800) {
+        buffer[0] = 0xc0 | (codePoint >> 6);
+        buffer[1] = 0x80 | (codePoint & 0x3f);
+        return 2;
+    }
+    if (codePoint < 0x10000) {
+        buffer[0] = 0xe0 | (codePoint >> 12);
+        buffer[1] = 0x80 | ((codePoint >> 6) & 0x3f);
+        buffer[2] = 0x80 | (codePoint & 0x3f);
+        return 3;
+    }
+    buffer[0] = 0xf0 | (codePoint >> 18);
+    buffer[1] = 0x80 | ((codePoint >> 12) & 0x3f);
+    buffer[2] = 0x80 | ((codePoint >> 6) & 0x3f);
+    buffer[3] = 0x80 | (codePoint & 0x3f);
+    return 4;
+}
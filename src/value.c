@@ -13,21 +13,6 @@
 #include "error.h"
 #include "vm.h"
 
-int writeToBuffer(char *buffer, const size_t size, const char *format, ...) {
-    va_list args;
-    va_start(args, format);
-    int bytesWritten;
-
-    if (buffer == NULL)
-        bytesWritten = vprintf(format, args);
-    else
-        bytesWritten = vsnprintf(buffer, size, format, args);
-    
-    va_end(args);
-
-    return bytesWritten;
-}
-
 Value getStaticAttribute(Value value, ObjString *name, const struct StaticAttribute*(*in_word_set)(register const char*, register size_t)) {
     const StaticAttribute *result = in_word_set(name->chars, name->length);
     if (!result)
@@ -49,11 +34,3 @@ int calculateIndex(int index, int length) {
     
     return length + index;
 }
-
-int movePointer(char **buffer, int bytesWritten) {
-    if (*buffer != NULL) {
-        *buffer += bytesWritten;
-        return bytesWritten;
-    }
-    return 0;
-}
\ No newline at end of file
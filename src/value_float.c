@@ -6,6 +6,8 @@
 #include "value_methods.h"
 #include "methods_float.h"
 #include "object_exception.h"
+#include "object_string.h"
+#include "numeric.h"
 #include "vm.h"
 
 Value Float_Equal(Value a, Value b) {
@@ -201,7 +203,15 @@ Value Float_GetAttribute(Value a, ObjString *name) {
 }
 
 Value Float_Init(Value callee, int argc, Value *argv) {
-    return FLOAT_VAL(valueToFloat(argv[0]));
+    if (argc == 0)
+        return FLOAT_VAL(0.0);
+    if (!IS_STRING(argv[0]))
+        return FLOAT_VAL(valueToFloat(argv[0]));
+
+    double value;
+    if (parseFloat(AS_CHARS(argv[0]), AS_STRING(argv[0])->length, &value) != PARSE_OK)
+        return createException(VAL_VALUE_ERROR, "could not convert string to float: '%s'", AS_CHARS(argv[0]));
+    return FLOAT_VAL(value);
 }
 
 Value Float_Class(Value value) {
@@ -209,6 +219,11 @@ Value Float_Class(Value value) {
 }
 
 uint64_t Float_Hash(Value value) {
+    // Integral floats hash like the equal int, so 1.0 and 1 share dict keys.
+    double number = AS_FLOAT(value);
+    if (number >= -9223372036854775808.0 && number < 9223372036854775808.0 && number == (long long)number)
+        return Int_Hash(INT_VAL((long long)number));
+
     union {
         double d;
         uint64_t i;
@@ -237,6 +252,7 @@ double Float_ToFloat(Value value) {
     return AS_FLOAT(value);
 }
 
-int Float_ToStr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "%g", AS_FLOAT(value));
+void Float_ToStr(Value value, Writer *writer) {
+    char buffer[FLOAT_BUFFER_SIZE];
+    writeChars(writer, buffer, formatFloat(buffer, AS_FLOAT(value)));
 }
\ No newline at end of file
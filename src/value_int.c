@@ -7,6 +7,8 @@
 #include "methods_int.h"
 #include "methods_bool.h"
 #include "object_exception.h"
+#include "object_string.h"
+#include "numeric.h"
 #include "vm.h"
 #include "table.h"
 
@@ -196,7 +198,20 @@ Value Int_GetAttribute(Value obj, ObjString *name) {
 }
 
 Value Int_Init(Value callee, int argc, Value *argv) {
-    return INT_VAL(valueToInt(argv[0]));
+    if (argc == 0)
+        return INT_VAL(0);
+    if (!IS_STRING(argv[0]))
+        return INT_VAL(valueToInt(argv[0]));
+
+    long long value;
+    switch (parseInt(AS_CHARS(argv[0]), AS_STRING(argv[0])->length, &value)) {
+        case PARSE_OK:
+            return INT_VAL(value);
+        case PARSE_OVERFLOW:
+            return createException(VAL_VALUE_ERROR, "int() literal out of range: '%s'", AS_CHARS(argv[0]));
+        default:
+            return createException(VAL_VALUE_ERROR, "invalid literal for int() with base 10: '%s'", AS_CHARS(argv[0]));
+    }
 }
 
 Value Int_Class(Value value) {
@@ -227,8 +242,9 @@ double Int_ToFloat(Value value) {
     return AS_INT(value);
 }
 
-int Int_ToStr(Value value, char *buffer, const size_t size) {
-    writeToBuffer(buffer, size, "%lld", AS_INT(value));
+void Int_ToStr(Value value, Writer *writer) {
+    char buffer[INT_BUFFER_SIZE];
+    writeChars(writer, buffer, formatInt(buffer, AS_INT(value)));
 }
 
 Value Bool_Init(Value callee, int argc, Value *argv) {
@@ -243,6 +259,6 @@ Value Bool_GetAttribute(Value obj, ObjString *name) {
     return getStaticAttribute(obj, name, in_bool_set);
 }
 
-int Bool_ToStr(Value value, char *buffer, const size_t size) {
-    writeToBuffer(buffer, size, "%s", AS_BOOL(value) ? "True" : "False");
+void Bool_ToStr(Value value, Writer *writer) {
+    writeCString(writer, AS_BOOL(value) ? "True" : "False");
 }
@@ -12,6 +12,9 @@
 #include "object_tuple_iterator.h"
 #include "object_dict.h"
 #include "object_dict_iterator.h"
+#include "object_set.h"
+#include "object_frozenset.h"
+#include "object_set_iterator.h"
 #include "object_class.h"
 #include "object_instance.h"
 #include "object_super.h"
@@ -24,16 +27,16 @@
 
 #define GET_METHOD(value, name) MethodTable[(value).type].name
 
-static int Undefined_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "undefined");
+static void Undefined_ToStr(Value value, Writer *writer) {
+    writeCString(writer, "undefined");
 }
 
 static bool NotImplemented_ToBool(Value value) {
     return true;
 }
 
-static int NotImplemened_ToStr(Value value, char *buffer, size_t size) {
-    return writeToBuffer(buffer, size, "NotImplemented");
+static void NotImplemened_ToStr(Value value, Writer *writer) {
+    writeCString(writer, "NotImplemented");
 }
 
 static Value NotImplemened_Class(Value value) {
@@ -56,6 +59,9 @@ ValueMethods MethodTable[] = {
     [VAL_TUPLE_ITERATOR] = TUPLE_ITERATOR_METHODS,
     [VAL_DICT] = DICT_METHODS,
     [VAL_DICT_ITERATOR] = DICT_ITERATOR_METHODS,
+    [VAL_SET] = SET_METHODS,
+    [VAL_FROZENSET] = FROZENSET_METHODS,
+    [VAL_SET_ITERATOR] = SET_ITERATOR_METHODS,
     [VAL_NATIVE] = NATIVE_METHODS,
     [VAL_FUNCTION] = FUNCTION_METHODS,
     [VAL_CLOSURE] = CLOSURE_METHODS,
@@ -80,6 +86,7 @@ ValueMethods MethodTable[] = {
     [VAL_RUNTIME_ERROR] = RUNTIME_ERROR_METHODS,
     [VAL_ASSERTION_ERROR] = ASSERTION_ERROR_METHODS,
     [VAL_NOT_IMPLEMENTED_ERROR] = NOT_IMPLEMENTED_ERROR_METHODS,
+    [VAL_MEMORY_ERROR] = MEMORY_ERROR_METHODS,
     [VAL_MODULE] = MODULE_METHODS,
 };
 
@@ -120,6 +127,17 @@ Value binaryMethod(Value a, Value b, BinaryMethod left, BinaryMethod right, char
     return createException(VAL_TYPE_ERROR, "unsupported operand type(s) for %s: '%s' and '%s'", name, getValueType(a), getValueType(b));
 }
 
+// Augmented assignment: the in-place slot may mutate `a` and return it; when
+// there is none, or it declines, the plain binary operator builds a new value.
+static Value inplaceMethod(Value a, Value b, BinaryMethod inplace, BinaryMethod left, BinaryMethod right, char *name) {
+    if (inplace != NULL) {
+        Value res = inplace(a, b);
+        if (!IS_NOT_IMPLEMENTED(res))
+            return res;
+    }
+    return binaryMethod(a, b, left, right, name);
+}
+
 Value valueIs(Value a, Value b) {
     return BOOL_VAL(valueId(a) == valueId(b));
 }
@@ -232,6 +250,54 @@ Value valueRightShift(Value a, Value b) {
     return binaryMethod(a, b, GET_METHOD(a, rshift), GET_METHOD(b, rrshift), ">>");
 }
 
+Value valueInplaceAdd(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, iadd), GET_METHOD(a, add), GET_METHOD(b, radd), "+=");
+}
+
+Value valueInplaceSubtract(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, isub), GET_METHOD(a, sub), GET_METHOD(b, rsub), "-=");
+}
+
+Value valueInplaceMultiply(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, imul), GET_METHOD(a, mul), GET_METHOD(b, rmul), "*=");
+}
+
+Value valueInplaceTrueDivide(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, itruediv), GET_METHOD(a, truediv), GET_METHOD(b, rtruediv), "/=");
+}
+
+Value valueInplaceFloorDivide(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, ifloordiv), GET_METHOD(a, floordiv), GET_METHOD(b, rfloordiv), "//=");
+}
+
+Value valueInplaceModulo(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, imod), GET_METHOD(a, mod), GET_METHOD(b, rmod), "%=");
+}
+
+Value valueInplacePower(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, ipow), GET_METHOD(a, pow), GET_METHOD(b, rpow), "**=");
+}
+
+Value valueInplaceAnd(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, iand), GET_METHOD(a, and), GET_METHOD(b, rand), "&=");
+}
+
+Value valueInplaceXor(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, ixor), GET_METHOD(a, xor), GET_METHOD(b, rxor), "^=");
+}
+
+Value valueInplaceOr(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, ior), GET_METHOD(a, or), GET_METHOD(b, ror), "|=");
+}
+
+Value valueInplaceLeftShift(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, ilshift), GET_METHOD(a, lshift), GET_METHOD(b, rlshift), "<<=");
+}
+
+Value valueInplaceRightShift(Value a, Value b) {
+    return inplaceMethod(a, b, GET_METHOD(a, irshift), GET_METHOD(a, rshift), GET_METHOD(b, rrshift), ">>=");
+}
+
 Value valueContains(Value a, Value b) {
     BinaryMethod method = GET_METHOD(b, contains);
     if (method == NULL)
@@ -267,6 +333,20 @@ Value valueGetItem(Value obj, Value key) {
     return method(obj, key);
 }
 
+// obj[start:stop:step] without a slice object for types that slice natively;
+// anything else gets a real slice passed to its getitem.
+Value valueGetSlice(Value obj, Value start, Value stop, Value step) {
+    Value (*method)(Value, Value, Value, Value) = GET_METHOD(obj, getslice);
+    if (method != NULL)
+        return method(obj, start, stop, step);
+
+    Value slice = OBJ_VAL(allocateSlice(start, stop, step));
+    push(slice);
+    Value res = valueGetItem(obj, slice);
+    pop();
+    return res;
+}
+
 Value valueSetItem(Value obj, Value key, Value value) {
     Value (*method)(Value, Value, Value) = GET_METHOD(obj, setitem);
     if (method == NULL)
@@ -321,6 +401,22 @@ uint64_t valueHash(Value value) {
     return method(value);
 }
 
+// The part of the value valueHash cannot hash (a tuple hashes its items too),
+// or UNDEFINED_VAL when it is hashable.
+Value findUnhashable(Value value) {
+    if (GET_METHOD(value, hash) == NULL)
+        return value;
+    if (IS_TUPLE(value)) {
+        ObjTuple *tuple = AS_TUPLE(value);
+        for (size_t i = 0; i < tuple->size; i++) {
+            Value part = findUnhashable(tuple->values[i]);
+            if (!IS_UNDEFINED(part))
+                return part;
+        }
+    }
+    return UNDEFINED_VAL;
+}
+
 uint64_t valueId(Value value) {
     switch (value.type) {
         case VAL_NONE:
@@ -363,54 +459,48 @@ double valueToFloat(Value value) {
     return method(value);
 }
 
-int valueWrite(Value value, char *buffer, size_t size) {
-    int (*str)(Value, char*, size_t) = GET_METHOD(value, str);
+void valueWrite(Value value, Writer *writer) {
+    void (*str)(Value, Writer*) = GET_METHOD(value, str);
     if (str == NULL)
-        return Object_ToStr(value, NULL, 0);
-    return str(value, buffer, size);
+        Object_ToStr(value, writer);
+    else
+        str(value, writer);
 }
 
-int valuePrint(Value value) {
-    int (*str)(Value, char*, size_t) = GET_METHOD(value, str);
-    if (str == NULL)
-        return Object_ToStr(value, NULL, 0);
-    return str(value, NULL, 0);
+void valueReprWrite(Value value, Writer *writer) {
+    void (*repr)(Value, Writer*) = GET_METHOD(value, repr);
+    if (repr == NULL)
+        Object_ToStr(value, writer);
+    else
+        repr(value, writer);
 }
 
-int valueReprWrite(Value value, char *buffer, size_t size) {
-    int (*repr)(Value, char*, size_t) = GET_METHOD(value, repr);
-    if (repr == NULL)
-        return Object_ToStr(value, buffer, size);
-    return repr(value, buffer, size);
+void valuePrint(Value value) {
+    Writer writer;
+    initWriter(&writer);
+    valueWrite(value, &writer);
+    writerFlush(&writer, stdout);
 }
 
-int valueRepr(Value value) {
-    int (*repr)(Value, char*, size_t) = GET_METHOD(value, repr);
-    if (repr == NULL)
-        return Object_ToStr(value, NULL, 0);
-    return repr(value, NULL, 0);
+void valueRepr(Value value) {
+    Writer writer;
+    initWriter(&writer);
+    valueReprWrite(value, &writer);
+    writerFlush(&writer, stdout);
 }
 
 ObjString *valueToStr(Value value) {
-    const size_t size = 256;
-    char buffer[size];
-
-    int (*str)(Value, char*, size_t) = GET_METHOD(value, str);
-    int length = str(value, buffer, size);
-
-    ObjString *string = copyString(buffer, length);
-    return string;
+    Writer writer;
+    initWriter(&writer);
+    valueWrite(value, &writer);
+    return writerToString(&writer);
 }
 
 ObjString *valueToRepr(Value value) {
-    const size_t size = 256;
-    char buffer[size];
-
-    int (*repr)(Value, char*, size_t) = GET_METHOD(value, repr);
-    int length = repr(value, buffer, size);
-
-    ObjString *string = copyString(buffer, length);
-    return string;
+    Writer writer;
+    initWriter(&writer);
+    valueReprWrite(value, &writer);
+    return writerToString(&writer);
 }
 
 static Value getSuperClass(Value obj) {
@@ -27,6 +27,6 @@ bool None_ToBool(Value value) {
     return false;
 }
 
-int None_ToStr(Value value, char *buffer, size_t size) {
-    writeToBuffer(buffer, size, "None");
+void None_ToStr(Value value, Writer *writer) {
+    writeCString(writer, "None");
 }
\ No newline at end of file
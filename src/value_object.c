@@ -10,6 +10,6 @@ Value Object_NotEqual(Value a, Value b) {
     return BOOL_VAL(!AS_BOOL(valueIs(a, b)));
 }
 
-int Object_ToStr(Value value, char *buffer, const size_t size) {
-    writeToBuffer(buffer, size, "<%s object at %p>", getValueType(value), valueId(value));
+void Object_ToStr(Value value, Writer *writer) {
+    writeFormat(writer, "<%s object at %p>", getValueType(value), valueId(value));
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <time.h>
 #include <stdarg.h>
 #include <libgen.h>
+#include <unistd.h>
+#include <errno.h>
 
 #include "vm.h"
 #include "debug.h"
@@ -13,16 +15,21 @@
 #include "object_list.h"
 #include "object_tuple.h"
 #include "object_dict.h"
+#include "object_set.h"
 #include "object_class.h"
 #include "object_instance.h"
 #include "object_function.h"
 #include "object_exception.h"
 #include "object_slice.h"
 #include "object_module.h"
+#include "string_format.h"
 #include "memory.h"
+#include "hash.h"
 #include "compiler.h"
 #include "native.h"
 #include "error.h"
+#include "alloc_trace.h"
+#include "py_gc.h"
 
 #define READ_BYTE()     (*frame->ip++)
 #define READ_CONSTANT() (frame->closure->function->code.constants.values[READ_BYTE()]) 
@@ -42,7 +49,28 @@ void printErrorInCode() {
         printHighlightedPartInCode(frame->closure->function->module->source, line, column, length); 
 }
 
+// print() collects its output in vm.output, which reaches stdout in a single
+// write(2) per flush. Anything else that writes to stdout or stderr flushes it
+// first so the streams stay in order.
+void flushOutput() {
+    fflush(stdout);
+    const char *chars = vm.output.chars;
+    size_t left = vm.output.length;
+    while (left > 0) {
+        ssize_t written = write(STDOUT_FILENO, chars, left);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        chars += written;
+        left -= written;
+    }
+    vm.output.length = 0;
+}
+
 void reportRuntimeError(const char *format, ...) {
+    flushOutput();
     va_list args;
     va_start(args, format);
     fprintf(stderr, "\033[31mRuntime Error\033[0m: ");
@@ -98,6 +126,7 @@ static void printStack(const char *prefix) {
 static void resetStack() {
     vm.top = vm.stack;
     vm.frameSize = 0;
+    vm.nativeCall = NULL;
     vm.openUpvalues = NULL;
 }
 
@@ -145,6 +174,8 @@ void parseArgs(int argc, int kwargc, int arity, char *keywords[], ...) {
     vm.top -= argc + 2 * kwargc;
 
     for (int i = 0; i < argc; i++) {
+        if (i == arity)
+            reportRuntimeError("takes at most %d arguments (%d given)", arity, argc);
         if (*keywords[i] == '*') {
             size_t size = argc - i;
             ObjTuple *tuple = allocateTuple(size);
@@ -186,7 +217,7 @@ void parseArgs(int argc, int kwargc, int arity, char *keywords[], ...) {
 
 void loadModule() {
     ObjModule *module = AS_MODULE(peek(0));
-    tableSet(&module->globals, OBJ_VAL(copyString("__name__", 0)), OBJ_VAL(module->function->name));
+    tableSet(&module->globals, OBJ_VAL(internImmortalString("__name__", 8)), OBJ_VAL(module->function->name));
     frame = &vm.frames[vm.frameSize++];
     frame->closure = createClosure(module->function);
     frame->ip = module->function->code.code;
@@ -269,6 +300,7 @@ void call(ObjClosure *closure, int argc, int kwargc, bool isMethod) {
             if (kwargs == NULL)
                 reportRuntimeError("got an unexpected keyword argument '%s'", AS_STRING(name)->chars);
             Dict_SetItem(kwargsVal, name, value);
+            continue;
         }
         if (index > 0 && !IS_UNDEFINED(args[index]))
             reportRuntimeError("got multiple values for argument '%s'", AS_STRING(name)->chars);
@@ -301,7 +333,7 @@ void call(ObjClosure *closure, int argc, int kwargc, bool isMethod) {
 }
 
 static void defineNative(const char *name, NativeFn function) {
-    push(STRING_VAL(copyString(name, (int)strlen(name))));
+    push(STRING_VAL(internImmortalString(name, strlen(name))));
     ObjNative *native = createNative(function, name);
     push(NATIVE_VAL(native));
     tableSet(&vm.builtin, vm.stack[0], vm.stack[1]);
@@ -317,23 +349,27 @@ static void defineNatives() {
     // defineNative("max", maxNative);
     defineNative("id", Py_Id);
     defineNative("len", Py_Len);
+    defineNative("hash", Py_Hash);
+    defineNative("sum", Py_Sum);
+    defineNative("sorted", Py_Sorted);
     defineNative("repr", Py_Repr);
     defineNative("input", Py_Input);
     defineNative("hex", Py_Hex);
     defineNative("isinstance", Py_IsInstance);
     defineNative("iter", Py_Iter);
     defineNative("next", Py_Next);
+    defineNative("heap_snapshot", Py_HeapSnapshot);
 }
 
 static ObjNativeClass* defineNativeClass(const char *name, ValueType type, ValueType super) {
-    ObjString *n = copyString(name, strlen(name));
+    ObjString *n = internImmortalString(name, strlen(name));
     ObjNativeClass *class = createNativeClass(n, type, super);
     tableSet(&vm.builtin, OBJ_VAL(n), OBJ_VAL(class));
     return class;
 }
 
 static ObjNativeClass* createNativeclass(const char *name, ValueType type, ValueType super) {
-    ObjString *n = copyString(name, strlen(name));
+    ObjString *n = internImmortalString(name, strlen(name));
     ObjNativeClass *class = createNativeClass(n, type, super);
     return class;
 }
@@ -353,6 +389,9 @@ static void defineNativeTypes() {
     vm.types.tupleIterator = createNativeclass("tuple_iterator", VAL_TUPLE_ITERATOR, VAL_OBJECT);
     vm.types.dict = defineNativeClass("dict", VAL_DICT, VAL_OBJECT);
     vm.types.dictIterator = createNativeclass("dict_iterator", VAL_TUPLE_ITERATOR, VAL_OBJECT);
+    vm.types.set = defineNativeClass("set", VAL_SET, VAL_OBJECT);
+    vm.types.frozenset = defineNativeClass("frozenset", VAL_FROZENSET, VAL_OBJECT);
+    vm.types.setIterator = createNativeclass("set_iterator", VAL_SET_ITERATOR, VAL_OBJECT);
     vm.types.exception = defineNativeClass("Exception", VAL_EXCEPTION, VAL_OBJECT);
     vm.types.zeroDivisionError = defineNativeClass("ZeroDivisionError", VAL_ZERO_DIVISON_ERROR, VAL_EXCEPTION);
     vm.types.stopIteration = defineNativeClass("StopIteration", VAL_STOP_ITERATION, VAL_EXCEPTION);
@@ -365,6 +404,7 @@ static void defineNativeTypes() {
     vm.types.runtimeError = defineNativeClass("RuntimeError", VAL_RUNTIME_ERROR, VAL_EXCEPTION);
     vm.types.assertionError = defineNativeClass("AssertionError", VAL_ASSERTION_ERROR, VAL_EXCEPTION);
     vm.types.notImplementedError = defineNativeClass("NotImplementedError", VAL_NOT_IMPLEMENTED_ERROR, VAL_EXCEPTION);
+    vm.types.memoryError = defineNativeClass("MemoryError", VAL_MEMORY_ERROR, VAL_EXCEPTION);
     vm.types.super = defineNativeClass("super", VAL_SUPER, VAL_OBJECT);
     vm.types.range = defineNativeClass("range", VAL_RANGE, VAL_OBJECT);
     vm.types.rangeIterator = createNativeclass("range_iterator", VAL_RANGE_ITERATOR, VAL_OBJECT);
@@ -372,6 +412,11 @@ static void defineNativeTypes() {
     vm.types.notImplementedType = createNativeclass("NotImplementedType", VAL_NOT_IMPLEMENTED, VAL_OBJECT);
 }
 
+static void defineBuiltinModules() {
+    ObjModule *gc = createGCModule();
+    tableSet(&vm.modules, OBJ_VAL(gc->function->name), OBJ_VAL(gc));
+}
+
 static void callValue(Value callee, int argc, int kwargc) {
     Value res = valueCall(callee, argc, kwargc, vm.top);
     frame = &vm.frames[vm.frameSize - 1];
@@ -419,52 +464,27 @@ static void defineMethod(ObjString* name) {
     pop();
 }
 
+// The field values of an f-string, then its template.
 static void buildFormattedString() {
-    const size_t bufferSize = 512;
-    size_t spaceLeft = bufferSize;
-    int size = sizeof(ObjString) + bufferSize;
-
-    ObjString *string = (ObjString*)allocateObject(size, VAL_STRING);
-    string->isInterned = false;
-    string->isHashed = false;
-
-    char *buffer = string->chars;
-    int partCount = READ_BYTE();
-    int stringSize = 0;
-
-    for (int i = 0; i < partCount; i++) {
-        Value part = peek(partCount - i - 1);
-        int bytesWritten = valueWrite(part, buffer, spaceLeft);
-        buffer += bytesWritten;
-        stringSize += bytesWritten;
-        spaceLeft -= bytesWritten;
-        if (spaceLeft <= 0) {
-            printf("Formatted string is too big\n");
-            exit(1);
-        }
-    }
-
-    string->length = stringSize;
-
-    int newSize = size - (bufferSize - stringSize);
-
-    reallocate(string, size, newSize);
-
-    for (int i = 0; i < partCount; i++)
+    int fieldCount = READ_BYTE();
+    FormatArgs args = {
+        .positional = vm.top - 1 - fieldCount,
+        .positionalCount = fieldCount,
+        .mapping = UNDEFINED_VAL,
+    };
+    Value result = formatTemplate(AS_STRING(peek(0)), TEMPLATE_BRACES, &args);
+
+    for (int i = 0; i <= fieldCount; i++)
         pop();
 
-    push(STRING_VAL(string));
+    push(result);
+    raiseIfException();
 }
 
 static void buildList() {
     size_t size = READ_BYTE();
-    ObjList *list = allocateList(size);
+    ObjList *list = listFromValues(vm.top - size, size);
 
-    for (int i = 0; i < size; i++) {
-        Value value = peek(size - i - 1);
-        list->vec.values[i] = value;
-    }
-    
     for (int i = 0; i < size; i++)
         pop();
     
@@ -503,6 +523,27 @@ static void buildDict() {
     push(res);
 }
 
+static void buildSet() {
+    size_t size = READ_BYTE();
+    for (size_t i = 0; i < size; i++) {
+        Value res = expectHashable(peek(i));
+        if (isInstance(res, TYPE_CLASS(exception))) {
+            push(res);
+            raise();
+            return;
+        }
+    }
+
+    ObjSet *set = allocateSet(VAL_SET);
+    for (size_t i = 0; i < size; i++)
+        hashSetAdd(&set->set, peek(size - i - 1));
+
+    for (int i = 0; i < size; i++)
+        pop();
+
+    push(OBJ_VAL(set));
+}
+
 static void buildSlice() {
     Value step = pop();
     Value stop = pop();
@@ -510,6 +551,13 @@ static void buildSlice() {
     push(OBJ_VAL(allocateSlice(start, stop, step)));
 }
 
+static void getSlice() {
+    Value res = valueGetSlice(peek(3), peek(2), peek(1), peek(0));
+    vm.top -= 4;
+    push(res);
+    raiseIfException();
+}
+
 static bool return_() {
     Value result = pop();
     
@@ -523,24 +571,37 @@ static bool return_() {
     frame = &vm.frames[vm.frameSize - 1];
 
     push(result);
-    return !vm.frameSize;
+    return vm.frameSize == (vm.nativeCall != NULL ? vm.nativeCall->frameSize : 0);
 }
 
 void raise() {
     Value exception = pop();
 
+    if (vm.nativeCall != NULL) {
+        while (frame->exceptPointer == 0 && vm.frameSize > vm.nativeCall->frameSize)
+            return_();
+
+        if (vm.frameSize == vm.nativeCall->frameSize) {
+            vm.nativeCall->exception = exception;
+            longjmp(vm.nativeCall->jump, 1);
+        }
+    }
+
     while (frame->exceptPointer == 0 && vm.frameSize > 1) {
         return_();
     }
 
     if (frame->exceptPointer == 0) {
+        flushOutput();
         fprintf(stderr, "%s: ", getValueType(exception));
         valuePrint(exception);
         printf("\n");
         printErrorInCode();
         exit(1);
     }
-    vm.top = frame->slots + frame->closure->function->localNames->size;
+    // Back to the stack of the try statement, which keeps the iterators of
+    // enclosing for loops.
+    vm.top = frame->exceptTop[frame->exceptPointer - 1];
     push(exception);
     frame->ip = frame->exceptAddr[frame->exceptPointer - 1];
 }
@@ -564,7 +625,7 @@ static void unary(Value (*func)(Value)) {
     raiseIfException();
 }
 
-static void getLocal() {
+static void getLocal(bool share) {
     uint8_t slot = READ_BYTE();
     Value value = frame->slots[slot];
 
@@ -573,10 +634,26 @@ static void getLocal() {
         push(createException(VAL_NAME_ERROR, "name '%s' is not defined", name));
         raise();
     } else {
-        push(frame->slots[slot]);
+        push(share ? String_Share(value) : String_Claim(value));
     }
 }
 
+static void getGlobal(bool share) {
+    ObjString *name = READ_STRING();
+    Value value = tableGet(&frame->closure->function->module->globals, OBJ_VAL(name));
+    if (!IS_UNDEFINED(value)) {
+        push(share ? String_Share(value) : String_Claim(value));
+        return;
+    }
+    value = tableGet(&vm.builtin, OBJ_VAL(name));
+    if (!IS_UNDEFINED(value)) {
+        push(value);
+        return;
+    }
+    push(createException(VAL_NAME_ERROR, "name '%s' is not defined", name->chars));
+    raise();
+}
+
 static void setLocal() {
     uint8_t slot = READ_BYTE();
     frame->slots[slot] = peek(0);
@@ -623,7 +700,7 @@ static void setItem() {
 
 static void delItem() {
     Value key = pop();
-    Value object = peek(0);
+    Value object = pop();
 
     Value res = valueDelItem(object, key);
     if (isInstance(res, TYPE_CLASS(exception))) {
@@ -663,9 +740,31 @@ static void delAttribute() {
     }
 }
 
+// Called at an instruction boundary after an allocation went over the heap
+// limit: try a full collection and raise MemoryError if it did not help.
+static void enforceHeapLimit() {
+    vm.gc.heapLimitExceeded = false;
+    collectGarbage();
+    if (vm.bytesAllocated > vm.gc.heapLimit) {
+        enterHeapReserve();
+        push(createException(VAL_MEMORY_ERROR, "heap limit of %zu bytes exceeded", vm.gc.heapLimit));
+        raise();
+    }
+}
+
 static Value run() {
     frame = &vm.frames[vm.frameSize - 1];
     while (true) {
+        if (vm.gc.heapLimitExceeded)
+            enforceHeapLimit();
+
+        #ifdef DEBUG_STRESS_GC
+            if (vm.gc.enabled)
+                collectGarbage();
+        #else
+            if (vm.bytesAllocated > vm.nextGC && vm.gc.enabled)
+                collectGarbage();
+        #endif
 
         #ifdef DEBUG_TRACE_EXECUTION
             if (vm.allowStackPrinting)
@@ -684,22 +783,12 @@ static Value run() {
             case OP_POP:
                 pop();
                 break;
-            case OP_GET_GLOBAL: {
-                ObjString *name = READ_STRING();
-                Value value = tableGet(&frame->closure->function->module->globals, OBJ_VAL(name));
-                if (!IS_UNDEFINED(value)) {
-                    push(value);
-                    break;
-                }
-                value = tableGet(&vm.builtin, OBJ_VAL(name));
-                if (!IS_UNDEFINED(value)) {
-                    push(value);
-                    break;
-                }
-                push(createException(VAL_NAME_ERROR, "name '%s' is not defined", name->chars));
-                raise();
+            case OP_GET_GLOBAL:
+                getGlobal(true);
+                break;
+            case OP_GET_GLOBAL_UNSHARED:
+                getGlobal(false);
                 break;
-            }
             case OP_SET_GLOBAL: {
                 ObjString *name = READ_STRING();
                 tableSet(&frame->closure->function->module->globals, OBJ_VAL(name), peek(0));
@@ -715,7 +804,10 @@ static Value run() {
                 break;
             }
             case OP_GET_LOCAL:
-                getLocal();
+                getLocal(true);
+                break;
+            case OP_GET_LOCAL_UNSHARED:
+                getLocal(false);
                 break;
             case OP_SET_LOCAL:
                 setLocal();
@@ -725,7 +817,7 @@ static Value run() {
                 break;
             case OP_GET_UPVALUE: {
                 uint8_t slot = READ_BYTE();
-                push(*frame->closure->upvalues[slot]->location);
+                push(String_Share(*frame->closure->upvalues[slot]->location));
                 break;
             }
             case OP_SET_UPVALUE: {
@@ -811,6 +903,48 @@ static Value run() {
             case OP_RIGHT_SHIFT:
                 binary(valueRightShift);
                 break;
+            case OP_INPLACE_ADD:
+                binary(valueInplaceAdd);
+                break;
+            case OP_INPLACE_SUBTRUCT:
+                binary(valueInplaceSubtract);
+                break;
+            case OP_INPLACE_MULTIPLY:
+                binary(valueInplaceMultiply);
+                break;
+            case OP_INPLACE_POWER:
+                binary(valueInplacePower);
+                break;
+            case OP_INPLACE_TRUE_DIVIDE:
+                binary(valueInplaceTrueDivide);
+                break;
+            case OP_INPLACE_FLOOR_DIVIDE:
+                binary(valueInplaceFloorDivide);
+                break;
+            case OP_INPLACE_MOD:
+                binary(valueInplaceModulo);
+                break;
+            case OP_INPLACE_BITWISE_AND:
+                binary(valueInplaceAnd);
+                break;
+            case OP_INPLACE_BITWISE_XOR:
+                binary(valueInplaceXor);
+                break;
+            case OP_INPLACE_BITWISE_OR:
+                binary(valueInplaceOr);
+                break;
+            case OP_INPLACE_LEFT_SHIFT:
+                binary(valueInplaceLeftShift);
+                break;
+            case OP_INPLACE_RIGHT_SHIFT:
+                binary(valueInplaceRightShift);
+                break;
+            case OP_INPLACE_CONCAT:
+                if (IS_STRING(peek(1)) && IS_STRING(peek(0)))
+                    binary(String_Concat);
+                else
+                    binary(valueInplaceAdd);
+                break;
             case OP_INVERT:
                 unary(valueInvert);
                 break;
@@ -853,9 +987,15 @@ static Value run() {
             case OP_BUILD_DICT:
                 buildDict();
                 break;
+            case OP_BUILD_SET:
+                buildSet();
+                break;
             case OP_BUILD_SLICE:
                 buildSlice();
                 break;
+            case OP_GET_SLICE:
+                getSlice();
+                break;
             case OP_JUMP: {
                 uint16_t offset = READ_SHORT();
                 frame->ip += offset;
@@ -898,7 +1038,8 @@ static Value run() {
             }
             case OP_SETUP_TRY: {
                 uint16_t offset = READ_SHORT();
-                frame->exceptAddr[frame->exceptPointer++] = frame->ip + offset;
+                frame->exceptAddr[frame->exceptPointer] = frame->ip + offset;
+                frame->exceptTop[frame->exceptPointer++] = vm.top;
                 break;
             }
             case OP_END_TRY:
@@ -982,9 +1123,35 @@ static Value run() {
     }
 }
 
+static Value runNativeCall(Value callee, int argc, int frameSize) {
+    Value result = valueCall(callee, argc, 0, vm.top);
+    if (isInstance(result, TYPE_CLASS(exception)))
+        return result;
+    return vm.frameSize > frameSize ? run() : pop();
+}
+
+// Calls callee from native code and returns its result, or the exception it
+// raised. The callee's slot and its argc arguments must already be on the
+// stack; they are popped. Python functions run in a nested dispatch loop
+// that stops when their frame returns.
 Value callNovaValue(Value callee, int argc) {
-    // callValue(callee, argc);
-    // return run();
+    CallFrame *caller = frame;
+    Value *base = vm.top - argc - 1;
+    NativeCall nativeCall = {.previous = vm.nativeCall, .frameSize = vm.frameSize};
+    Value result;
+
+    vm.nativeCall = &nativeCall;
+    if (setjmp(nativeCall.jump) == 0) {
+        result = runNativeCall(callee, argc, nativeCall.frameSize);
+    } else {
+        result = nativeCall.exception;
+        closeUpvalues(base);
+    }
+    vm.nativeCall = nativeCall.previous;
+    vm.frameSize = nativeCall.frameSize;
+    vm.top = base;
+    frame = caller;
+    return result;
 }
 
 OptValue callNovaMethod(Value obj, ObjString *methodName) {
@@ -1021,42 +1188,42 @@ OptValue callNovaMethod2args(Value obj, ObjString *methodName, Value arg1, Value
 }
 
 void initMagicStrings() {
-    vm.magicStrings.init = copyString("__init__", 8);
-    vm.magicStrings.add = copyString("__add__", 7);
-    vm.magicStrings.radd = copyString("__radd__", 8);
-    vm.magicStrings.sub = copyString("__sub__", 7);
-    vm.magicStrings.rsub = copyString("__rsub__", 8);
-    vm.magicStrings.neg = copyString("__neg__", 7);
-    vm.magicStrings.mul = copyString("__mul__", 7);
-    vm.magicStrings.rmul = copyString("__rmul__", 8);
-    vm.magicStrings.div = copyString("__truediv__", 11);
-    vm.magicStrings.rdiv = copyString("__rtruediv__", 12);
+    vm.magicStrings.init = internImmortalString("__init__", 8);
+    vm.magicStrings.add = internImmortalString("__add__", 7);
+    vm.magicStrings.radd = internImmortalString("__radd__", 8);
+    vm.magicStrings.sub = internImmortalString("__sub__", 7);
+    vm.magicStrings.rsub = internImmortalString("__rsub__", 8);
+    vm.magicStrings.neg = internImmortalString("__neg__", 7);
+    vm.magicStrings.mul = internImmortalString("__mul__", 7);
+    vm.magicStrings.rmul = internImmortalString("__rmul__", 8);
+    vm.magicStrings.div = internImmortalString("__truediv__", 11);
+    vm.magicStrings.rdiv = internImmortalString("__rtruediv__", 12);
     // TODO
-    vm.magicStrings.mod = copyString("_mod_", 5);
-    vm.magicStrings.lmod = copyString("_lmod_", 6);
-    vm.magicStrings.rmod = copyString("_rmod_", 6);
-    vm.magicStrings.pow = copyString("_pow_", 5);
-    vm.magicStrings.lpow = copyString("_lpow_", 6);
-    vm.magicStrings.rpow = copyString("_rpow_", 6);
-    vm.magicStrings.eq = copyString("_eq_", 4);
-    vm.magicStrings.ne = copyString("_ne_", 4);
-    vm.magicStrings.lt = copyString("_lt_", 4);
-    vm.magicStrings.le = copyString("_le_", 4);
-    vm.magicStrings.gt = copyString("_gt_", 4);
-    vm.magicStrings.ge = copyString("_ge_", 4);
-    vm.magicStrings.call = copyString("_call_", 6);
-    vm.magicStrings.getat = copyString("_getat_", 7);
-    vm.magicStrings.setat = copyString("_setat_", 7);
-    vm.magicStrings.len = copyString("_len_", 5);
-    vm.magicStrings.bool_ = copyString("_bool_", 6);
-    vm.magicStrings.int_ = copyString("_int_", 5);
-    vm.magicStrings.float_ = copyString("_float_", 7);
-    vm.magicStrings.str = copyString("_str_", 5);
+    vm.magicStrings.mod = internImmortalString("_mod_", 5);
+    vm.magicStrings.lmod = internImmortalString("_lmod_", 6);
+    vm.magicStrings.rmod = internImmortalString("_rmod_", 6);
+    vm.magicStrings.pow = internImmortalString("_pow_", 5);
+    vm.magicStrings.lpow = internImmortalString("_lpow_", 6);
+    vm.magicStrings.rpow = internImmortalString("_rpow_", 6);
+    vm.magicStrings.eq = internImmortalString("_eq_", 4);
+    vm.magicStrings.ne = internImmortalString("_ne_", 4);
+    vm.magicStrings.lt = internImmortalString("_lt_", 4);
+    vm.magicStrings.le = internImmortalString("_le_", 4);
+    vm.magicStrings.gt = internImmortalString("_gt_", 4);
+    vm.magicStrings.ge = internImmortalString("_ge_", 4);
+    vm.magicStrings.call = internImmortalString("_call_", 6);
+    vm.magicStrings.getat = internImmortalString("_getat_", 7);
+    vm.magicStrings.setat = internImmortalString("_setat_", 7);
+    vm.magicStrings.len = internImmortalString("_len_", 5);
+    vm.magicStrings.bool_ = internImmortalString("_bool_", 6);
+    vm.magicStrings.int_ = internImmortalString("_int_", 5);
+    vm.magicStrings.float_ = internImmortalString("_float_", 7);
+    vm.magicStrings.str = internImmortalString("_str_", 5);
 }
 
 void initPath(const char *scriptPath) {
     char *buffer = malloc(256);
-    strncpy(buffer, scriptPath, 256);
+    strncpy(buffer, scriptPath != NULL ? scriptPath : ".", 256);
     char *directory = dirname(buffer);
     vm.path = directory;
     setBasePath(directory);
@@ -1064,21 +1231,39 @@ void initPath(const char *scriptPath) {
 
 void initVM(const char *scriptPath) {
     vm.allowStackPrinting = false;
+    initHashSeed();
     resetStack();
     vm.objects = NULL;
+    vm.objectCount = 0;
+    vm.claimedBuilder = NULL;
+    initArena(&vm.immortals);
     vm.bytesAllocated = 0;
-    vm.nextGC = 1024 * 1024;
+    initGarbageCollector(&vm.gc);
+    vm.nextGC = vm.gc.threshold;
     initPath(scriptPath);
+    initWriter(&vm.output);
+    vm.outputIsTTY = isatty(STDOUT_FILENO);
+    atexit(flushOutput);
     tableInit(&vm.builtin);
+    tableInit(&vm.modules);
+    initNameTable(&vm.strings);
+    initCharacterStrings();
     initMagicStrings();
     defineNatives();
     defineNativeTypes();
-    tableSet(&vm.builtin, OBJ_VAL(copyString("NotImplemented", 0)), NOT_IMPLEMENTED_VAL);
+    defineBuiltinModules();
+    tableSet(&vm.builtin, OBJ_VAL(internImmortalString("NotImplemented", 14)), NOT_IMPLEMENTED_VAL);
     vm.allowStackPrinting = true;
 }
 
 void freeVM() {
+    flushOutput();
+    freeWriter(&vm.output);
+    if (traceAllocEnabled)
+        printAllocReport();
+    freeNameTable(&vm.strings);
     freeObjects();
+    freeArena(&vm.immortals);
     return;
 }
 
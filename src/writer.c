@@ -0,0 +1,87 @@
+#include <stdarg.h>
+#include <string.h>
+
+#include "writer.h"
+#include "object_string.h"
+#include "memory.h"
+#include "vm.h"
+
+void initWriter(Writer *writer) {
+    writer->chars = writer->inlineChars;
+    writer->length = 0;
+    writer->capacity = WRITER_INLINE_SIZE;
+}
+
+void freeWriter(Writer *writer) {
+    if (writer->chars != writer->inlineChars)
+        FREE_VEC(char, writer->chars, writer->capacity);
+    initWriter(writer);
+}
+
+static void reserve(Writer *writer, size_t extra) {
+    size_t needed = writer->length + extra;
+    if (needed <= writer->capacity)
+        return;
+
+    size_t capacity = writer->capacity * 2;
+    while (capacity < needed)
+        capacity *= 2;
+
+    if (writer->chars == writer->inlineChars) {
+        char *chars = ALLOCATE(char, capacity);
+        memcpy(chars, writer->inlineChars, writer->length);
+        writer->chars = chars;
+    } else {
+        writer->chars = GROW_VEC(char, writer->chars, writer->capacity, capacity);
+    }
+    writer->capacity = capacity;
+}
+
+void writeChars(Writer *writer, const char *chars, size_t length) {
+    reserve(writer, length);
+    memcpy(writer->chars + writer->length, chars, length);
+    writer->length += length;
+}
+
+void writeChar(Writer *writer, char c) {
+    reserve(writer, 1);
+    writer->chars[writer->length++] = c;
+}
+
+void writeCString(Writer *writer, const char *chars) {
+    writeChars(writer, chars, strlen(chars));
+}
+
+void writeVFormat(Writer *writer, const char *format, va_list args) {
+    va_list retry;
+    va_copy(retry, args);
+    size_t spaceLeft = writer->capacity - writer->length;
+    int length = vsnprintf(writer->chars + writer->length, spaceLeft, format, args);
+
+    if (length >= 0 && (size_t)length >= spaceLeft) {
+        reserve(writer, length + 1);
+        vsnprintf(writer->chars + writer->length, length + 1, format, retry);
+    }
+    va_end(retry);
+
+    if (length > 0)
+        writer->length += length;
+}
+
+void writeFormat(Writer *writer, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeVFormat(writer, format, args);
+    va_end(args);
+}
+
+ObjString *writerToString(Writer *writer) {
+    ObjString *string = writer->length == 0 ? EMPTY_STRING() : copyString(writer->chars, writer->length);
+    freeWriter(writer);
+    return string;
+}
+
+void writerFlush(Writer *writer, FILE *stream) {
+    fwrite(writer->chars, 1, writer->length, stream);
+    freeWriter(writer);
+}
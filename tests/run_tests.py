@@ -10,12 +10,31 @@ RESET = '\033[0m'
 TEST_DIR = 'tests'
 INTERPRETER = 'nova'
 
+# Leading '# flags: ...' lines add interpreter options and '# stderr: ...'
+# lines name text the run must write to stderr.
+def read_header(script_path: str):
+    flags = []
+    expected = []
+    with open(script_path) as f:
+        for line in f:
+            if line.startswith('# flags:'):
+                flags += line[len('# flags:'):].split()
+            elif line.startswith('# stderr:'):
+                expected.append(line[len('# stderr:'):].strip().encode())
+            else:
+                break
+    return flags, expected
+
 def run_test(name: str) -> int:
     script_path = os.path.join(TEST_DIR, name)
+    flags, expected = read_header(script_path)
 
     start_time = time.time()
 
-    result = subprocess.run([INTERPRETER, script_path], capture_output=True)
+    result = subprocess.run([INTERPRETER, *flags, script_path], capture_output=True)
+    returncode = result.returncode
+    if returncode == 0 and any(text not in result.stderr for text in expected):
+        returncode = 1
 
     missing = 0
     for line in result.stdout.splitlines():
@@ -26,7 +45,7 @@ def run_test(name: str) -> int:
 
     duration = end_time - start_time
 
-    return result.returncode, duration, missing 
+    return returncode, duration, missing 
 
 def main():
     print("\nStatus File Name                      Time    Details")
@@ -0,0 +1,39 @@
+# flags: --trace-alloc
+# stderr: --- allocation report ---
+# stderr: live bytes
+
+missing = 0
+
+def live(snapshot, name):
+    if name in snapshot:
+        return snapshot[name][0]
+    return 0
+
+before = heap_snapshot()
+
+assert type(before) == dict
+for name in before:
+    assert type(name) == str
+    assert not name.startswith("<")
+    entry = before[name]
+    assert type(entry) == tuple
+    assert len(entry) == 2
+    assert entry[0] > 0
+    assert entry[1] > 0
+
+# Keys are the names type() reports.
+assert live(before, "str") > 0
+assert live(before, "builtin_function_or_method") > 0
+
+lists = []
+for i in range(10):
+    lists.append([i])
+
+walker = iter(lists)
+after = heap_snapshot()
+
+assert live(after, "list") >= live(before, "list") + 11
+assert after["list"][1] > 0
+assert live(after, "list_iterator") > 0
+
+print(f'missing: {missing}')
@@ -42,4 +42,81 @@ a <<= 2
 assert a == 32
 
 a >>= 3
-assert a == 4
\ No newline at end of file
+assert a == 4
+a = [1, 2]
+b = a
+a += [3]
+assert a == [1, 2, 3]
+assert b is a
+
+a += (4, 5)
+assert b == [1, 2, 3, 4, 5]
+
+a += range(6, 8)
+assert b == [1, 2, 3, 4, 5, 6, 7]
+
+a = [1, 2]
+a += a
+assert a == [1, 2, 1, 2]
+
+a = [1.5]
+b = a
+a += ['x']
+assert b == [1.5, 'x']
+
+a = [1, 2]
+b = a
+a *= 3
+assert b == [1, 2, 1, 2, 1, 2]
+a *= 0
+assert b == []
+
+a = [1]
+b = a + [2]
+assert a == [1]
+
+m = [[1]]
+inner = m[0]
+m[0] += [2]
+assert inner == [1, 2]
+
+a = {'x': 1}
+b = a
+a |= {'y': 2}
+assert b == {'x': 1, 'y': 2}
+assert (a | {'z': 3}) == {'x': 1, 'y': 2, 'z': 3}
+assert b == {'x': 1, 'y': 2}
+
+a = {1, 2, 3}
+b = a
+a |= {4}
+a -= {1}
+a &= {2, 3, 4, 9}
+a ^= {2, 7}
+assert b == {3, 4, 7}
+
+a = frozenset([1])
+b = a
+a |= {2}
+assert a == frozenset([1, 2])
+assert b == frozenset([1])
+
+a = 's'
+b = a
+a += 't'
+assert a == 'st'
+assert b == 's'
+
+try:
+    a = [1]
+    a += 1
+    assert False
+except TypeError:
+    pass
+
+try:
+    a = 1
+    a += 'x'
+    assert False
+except TypeError:
+    pass
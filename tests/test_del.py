@@ -77,6 +77,19 @@ try:
 except AttributeError:
     pass
 
+# Test: Repeatedly delete and re-add attributes
+obj = Test()
+for i in range(1000):
+    obj.y = i
+    del obj.y
+    obj.z = i
+assert obj.x == 10 and obj.z == 999
+try:
+    obj.y
+    assert False, "Attribute y should be deleted"
+except AttributeError:
+    pass
+
 # Test: Delete an item from a list inside a dictionary
 complex_structure = {"numbers": [10, 20, 30], "letters": ["a", "b", "c"]}
 del complex_structure["numbers"][1]
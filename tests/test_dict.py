@@ -108,10 +108,34 @@ assert d1 != {"a": 1}, "Dictionaries with different items should not be equal"
 nested = {"outer": {"inner": 1}}
 assert nested["outer"]["inner"] == 1, f"Expected 1, but got {nested['outer']['inner']}"
 
+# Test insertion order survives deletions and compaction
+d = {}
+for i in range(1000):
+    d[i] = i
+    if i >= 100:
+        del d[i - 100]
+assert len(d) == 100
+assert list(d.keys())[0] == 900 and list(d.keys())[-1] == 999
+d[5] = 5
+assert list(d.keys())[-1] == 5
+assert d.popitem() == (5, 5)
+assert d.popitem() == (999, 999)
+assert len(d) == 99
+
+# Test int-keyed and str-keyed dicts falling back to mixed keys
+d = {1: 'a', 2: 'b'}
+assert d[True] == 'a'
+d[True] = 'c'
+assert d == {1: 'c', 2: 'b'}
+d['x'] = 1
+assert d['x'] == 1 and d[2] == 'b' and list(d.keys()) == [1, 2, 'x']
+d = {'a': 1}
+d[None] = 2
+assert d[None] == 2 and d['a'] == 1
+
 # Test dictionary with mixed data types
-missing += 1
-# mixed = {1: "integer key", (2, 3): "tuple key"}
-# assert mixed[1] == "integer key", f"Expected 'integer key', but got {mixed[1]}"
-# assert mixed[(2, 3)] == "tuple key", f"Expected 'tuple key', but got {mixed[(2, 3)]}"
+mixed = {1: "integer key", (2, 3): "tuple key"}
+assert mixed[1] == "integer key", f"Expected 'integer key', but got {mixed[1]}"
+assert mixed[(2, 3)] == "tuple key", f"Expected 'tuple key', but got {mixed[(2, 3)]}"
 
 print(f'missing: {missing}')
\ No newline at end of file
@@ -80,4 +80,67 @@ assert 3.14159.is_integer() == False
 
 assert (0.5 + 0.5).is_integer() == True
 
-assert (0.5 - 0.5).is_integer() == True
\ No newline at end of file
+assert (0.5 - 0.5).is_integer() == True
+assert repr(1.0) == "1.0"
+
+assert repr(0.1 + 0.2) == "0.30000000000000004"
+
+assert repr(1 / 3) == "0.3333333333333333"
+
+assert repr(1e16) == "1e+16"
+
+assert repr(1e15) == "1000000000000000.0"
+
+assert repr(0.0001) == "0.0001"
+
+assert repr(0.00001) == "1e-05"
+
+assert repr(1.5e-300) == "1.5e-300"
+
+assert repr(5e-324) == "5e-324"
+
+assert repr(-0.0) == "-0.0"
+
+assert repr(2.5 * 2) == "5.0"
+
+assert str(123456789012.5) == "123456789012.5"
+
+assert repr(float("inf")) == "inf"
+
+assert repr(float("-Infinity")) == "-inf"
+
+assert repr(float("nan")) == "nan"
+
+assert float("1_0.5_5") == 10.55
+
+assert float(".5") == 0.5
+
+assert float("1.") == 1.0
+
+assert float("1e3") == 1000.0
+
+assert float("2.2250738585072011e-308") == 2.225073858507201e-308
+
+assert float("123456789012345678901234567890") == 1.2345678901234568e+29
+
+assert 1.5e3 == 1500.0
+
+assert 2E-3 == 0.002
+
+assert float() == 0.0
+
+assert 1.0 in {1}
+
+assert hash(3.0) == hash(3)
+
+def invalid(s):
+    try:
+        float(s)
+    except ValueError as e:
+        return str(e)
+    return "ok"
+
+assert invalid("1.5xyz") == "could not convert string to float: '1.5xyz'"
+
+for s in ["", ".", "e5", "1e", "1._5", "1_.5", "--1", "infinit", "1..2"]:
+    assert invalid(s) != "ok"
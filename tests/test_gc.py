@@ -0,0 +1,77 @@
+import gc
+
+missing = 0
+
+assert gc.isenabled()
+
+gc.disable()
+
+assert not gc.isenabled()
+
+gc.enable()
+
+assert gc.isenabled()
+
+def garbage(n):
+    for i in range(n):
+        x = [i, str(i), (i, i)]
+
+garbage(100)
+
+freed = gc.collect()
+
+assert freed >= 0
+
+stats = gc.get_stats()
+
+assert stats['collections'] >= 1
+
+assert stats['collected'] >= freed
+
+assert stats['max_pause'] <= stats['total_pause']
+
+threshold = gc.get_threshold()
+
+gc.set_threshold(4096, 1.5)
+
+assert gc.get_threshold() == (4096, 1.5)
+
+gc.set_threshold(threshold[0], threshold[1])
+
+assert gc.get_debug() == 0
+
+assert gc.DEBUG_STATS == 1
+
+l = [str(0), str(1), str(2)]
+
+gc.collect()
+
+assert l == ['0', '1', '2']
+
+assert gc.get_stats()['heap_limit'] == 0
+
+try:
+    raise MemoryError("out of memory")
+except Exception as e:
+    assert str(e) == "out of memory"
+
+# Literals, single characters and builtins live in the immortal arena;
+# strings built at runtime are collected like any other object.
+assert not gc.is_tracked("literal")
+assert not gc.is_tracked("x"[0])
+assert not gc.is_tracked("")
+assert not gc.is_tracked(len)
+assert not gc.is_tracked(5)
+built = "lit" + str(10)
+assert gc.is_tracked(built)
+assert gc.is_tracked("{}-{}".format(1, 2))
+assert gc.is_tracked([])
+
+# Snapshots need the allocation trace; test_alloc_trace.py runs with it.
+try:
+    heap_snapshot()
+    assert False
+except RuntimeError as e:
+    assert str(e) == "heap_snapshot() requires --trace-alloc"
+
+print(f'missing: {missing}')
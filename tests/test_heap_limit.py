@@ -0,0 +1,37 @@
+# flags: --max-heap=4M
+import gc
+
+missing = 0
+
+assert gc.get_stats()['heap_limit'] == 4 * 1024 * 1024
+
+# Sizes known up front are checked before allocating.
+try:
+    s = "x" * 10000000
+    assert False
+except MemoryError as e:
+    assert str(e) == "heap limit of 4194304 bytes exceeded"
+
+# Growing the live heap past the cap raises once a collection cannot help.
+# The handler runs with the heap still full, so it lets go of the list before
+# allocating anything.
+kept = []
+count = 0
+try:
+    while True:
+        kept.append([len(kept), str(len(kept))])
+except MemoryError as e:
+    count = len(kept)
+    kept = None
+    assert str(e) == "heap limit of 4194304 bytes exceeded"
+assert count > 1000
+
+# Everything works again once the garbage is released.
+gc.collect()
+rows = []
+for i in range(1000):
+    rows.append(str(i) * 2)
+assert rows[999] == "999999"
+assert len(rows) == 1000
+
+print(f'missing: {missing}')
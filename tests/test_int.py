@@ -75,3 +75,33 @@ assert type(5) is int
 assert str(55) == "55"
 
 assert repr(-42) == "-42"
+
+assert int("1_000_000") == 1000000
+
+assert int(" \t+42\n") == 42
+
+assert int("9223372036854775807") == 9223372036854775807
+
+assert int("-9223372036854775808") == -9223372036854775807 - 1
+
+assert int() == 0
+
+assert str(-9223372036854775807 - 1) == "-9223372036854775808"
+
+assert str(1234567890123) == "1234567890123"
+
+assert 1_000 == 1000
+
+def invalid(s):
+    try:
+        int(s)
+    except ValueError as e:
+        return str(e)
+    return "ok"
+
+assert invalid("12abc") == "invalid literal for int() with base 10: '12abc'"
+
+for s in ["", " ", "1.5", "1__0", "_1", "1_", "- 5", "+", "0x10"]:
+    assert invalid(s) != "ok"
+
+assert invalid("9223372036854775808") != "ok"
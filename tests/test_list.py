@@ -198,6 +198,22 @@ assert lst1 + lst2 == [1, 2, 3, 4]
 # Test repetition (*)
 assert lst1 * 3 == [1, 2, 1, 2, 1, 2]
 
+# Repetition past the item limit raises before allocating.
+try:
+    [1, 2] * 2147483648
+    assert False
+except MemoryError:
+    pass
+
+repeated = [1, 2]
+try:
+    repeated *= 2147483648
+    assert False
+except MemoryError:
+    pass
+assert repeated == [1, 2]
+assert [] * 1099511627776 == []
+
 # Test equality (==)
 assert [1, 2, 3] == [1, 2, 3]
 assert [1, 2, 3] != [4, 5, 6]
@@ -328,4 +344,48 @@ assert str(lst) == "[1, 3.14, 'hello world']"
 lst = []
 assert repr(lst) == '[]' 
 
+# Test homogeneous int and float lists and switching to mixed items
+ints = [1, 2, 3]
+ints.append(4)
+assert ints == [1, 2, 3, 4]
+assert 3 in ints and 3.0 in ints and True in ints and 5 not in ints
+assert sum(ints) == 10
+assert sum(ints, 0.5) == 10.5
+ints.append("x")
+assert ints == [1, 2, 3, 4, "x"]
+assert "x" in ints
+ints[0] = 1.5
+assert ints[0] == 1.5
+
+floats = [0.5] * 4
+assert floats == [0.5, 0.5, 0.5, 0.5]
+assert sum(floats) == 2.0
+assert 0.5 in floats and 1 not in floats
+floats[1] = 2
+assert floats == [0.5, 2, 0.5, 0.5]
+assert type(floats[1]) is int
+
+lst = list(range(5))
+assert lst == [0, 1, 2, 3, 4]
+assert lst[1:4] == [1, 2, 3]
+assert lst[::-1] == [4, 3, 2, 1, 0]
+lst.insert(0, -1)
+lst.pop()
+lst.remove(2)
+assert lst == [-1, 0, 1, 3]
+lst.reverse()
+assert lst == [3, 1, 0, -1]
+assert lst + [2.5] == [3, 1, 0, -1, 2.5]
+assert [] + lst == lst
+assert [1, 2] < [1, 3] and [1.5] > [1.25] and [1, 2] <= [1, 2]
+lst.clear()
+lst.append("only")
+assert lst == ["only"]
+
+total = 0
+for x in [1, 2, 3]:
+    total += x
+assert total == 6
+assert sum([[1], [2]], []) == [1, 2]
+
 print(f'missing: {missing}')
\ No newline at end of file
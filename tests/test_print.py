@@ -0,0 +1,58 @@
+class Capture:
+    def __init__(self):
+        self.parts = []
+        self.flushes = []
+
+    def write(self, s):
+        self.parts.append(s)
+
+    def flush(self):
+        self.flushes.append(len(self.parts))
+
+    def text(self):
+        return "".join(self.parts)
+
+out = Capture()
+print("a", "b", 1, file=out)
+assert out.text() == "a b 1\n"
+
+out = Capture()
+print("a", "b", sep="-", end="!", file=out)
+assert out.text() == "a-b!"
+
+out = Capture()
+print(file=out)
+assert out.text() == "\n"
+
+out = Capture()
+print([1, "x"], (2,), {3: None}, sep=None, end=None, file=out)
+assert out.text() == "[1, 'x'] (2,) {3: None}\n"
+
+out = Capture()
+print("x", file=out)
+assert out.flushes == []
+print("y", file=out, flush=True)
+assert out.flushes == [len(out.parts)]
+assert out.text() == "x\ny\n"
+
+out = Capture()
+print("x" * 1000, "y" * 1000, file=out)
+assert len(out.text()) == 2002
+
+try:
+    print("a", sep=1)
+except TypeError as e:
+    assert str(e) == "sep must be None or a string, not int"
+else:
+    assert False
+
+try:
+    print("a", end=[])
+except TypeError as e:
+    assert str(e) == "end must be None or a string, not list"
+else:
+    assert False
+
+print("stdout", flush=True)
+print("stdout", "buffered", sep=", ", end="\n")
+print()
@@ -0,0 +1,48 @@
+assert str([1, 2, 3]) == "[1, 2, 3]"
+assert str([]) == "[]"
+assert str((1,)) == "(1,)"
+assert str(()) == "()"
+assert str((1, "a")) == "(1, 'a')"
+assert str({1: "a", "b": [2]}) == "{1: 'a', 'b': [2]}"
+assert str({}) == "{}"
+assert str(set()) == "set()"
+assert str({3}) == "{3}"
+assert str(frozenset()) == "frozenset()"
+assert str(range(3)) == "range(0, 3)"
+assert str(range(1, 9, 2)) == "range(1, 9, 2)"
+assert str(slice(1, 5, None)) == "slice(1, 5, None)"
+assert repr("abc") == "'abc'"
+assert repr(["x", ("y",)]) == "['x', ('y',)]"
+
+# Output longer than any fixed buffer is produced whole.
+big = list(range(10000))
+expected = 2
+for i in big:
+    expected += len(str(i)) + 2
+text = str(big)
+assert len(text) == expected - 2
+assert text[:10] == "[0, 1, 2, "
+assert text[-6:] == " 9999]"
+
+d = {}
+for i in range(1000):
+    d[i] = str(i)
+text = str(d)
+assert text[:17] == "{0: '0', 1: '1', "
+assert text[-11:] == "999: '999'}"
+assert text.count(": ") == 1000
+
+nested = []
+for i in range(2000):
+    nested.append((i, [i]))
+assert str(nested)[-15:] == "(1999, [1999])]"
+
+long = "x" * 600
+f = f"<{long}>{big[9999]}"
+assert len(f) == 606
+assert f[-5:] == ">9999"
+
+try:
+    raise ValueError("y" * 2000)
+except ValueError as e:
+    assert len(str(e)) == 2000
@@ -0,0 +1,174 @@
+missing = 0
+
+# Set literals and constructors
+s = {1, 2, 3}
+assert type(s) is set
+assert len(s) == 3
+assert type({}) is dict
+assert {1, 1, 2} == {1, 2}
+assert set() == set([])
+assert set([3, 1, 3]) == {1, 3}
+assert set((1, 2)) == {1, 2}
+assert set(range(4)) == {0, 1, 2, 3}
+assert set("aab") == {"a", "b"}
+assert not set()
+assert s
+
+# Membership
+assert 2 in s
+assert 5 not in s
+assert "a" in {"a", "b"}
+assert 1.0 in {1}
+
+# Operators
+a = {1, 2, 3, 4}
+b = {3, 4, 5}
+assert a | b == {1, 2, 3, 4, 5}
+assert a & b == {3, 4}
+assert a - b == {1, 2}
+assert a ^ b == {1, 2, 5}
+assert {1, 2} <= a
+assert {1, 2} < a
+assert not a < a
+assert a >= {1}
+assert a > {1}
+assert a != b
+
+# Mutation
+s = set()
+for i in range(100):
+    s.add(i % 10)
+assert len(s) == 10
+s.discard(3)
+s.discard(42)
+assert 3 not in s
+s.remove(4)
+assert 4 not in s
+try:
+    s.remove(4)
+    assert False, "remove of a missing element should raise"
+except KeyError:
+    pass
+s.update([20, 21])
+assert 21 in s
+x = s.pop()
+assert x not in s
+assert len(s) == 9
+
+# Popping everything visits each element once, with adds in between
+p = set()
+for i in range(3000):
+    p.add(i)
+popped = set()
+while len(p) > 0:
+    popped.add(p.pop())
+    if len(popped) == 1000:
+        p.add(5000)
+assert len(popped) == 3001
+assert 5000 in popped and 2999 in popped
+try:
+    p.pop()
+    assert False, "pop from an empty set should raise"
+except KeyError:
+    pass
+s.clear()
+assert len(s) == 0
+
+# Unhashable elements raise TypeError and leave the set untouched
+def unhashable(case):
+    u = {1}
+    try:
+        if case == 0:
+            u = {1, [2]}
+        elif case == 1:
+            u.add([])
+        elif case == 2:
+            [] in u
+        elif case == 3:
+            u.remove({})
+        elif case == 4:
+            u.discard([1])
+        elif case == 5:
+            set([1, [2]])
+        elif case == 6:
+            frozenset(iter([[3]]))
+        else:
+            u.add((1, [2]))
+        assert False, "unhashable element should raise"
+    except TypeError as e:
+        assert u == {1}
+        return str(e)
+
+for case in range(8):
+    kind = "list"
+    if case == 3:
+        kind = "dict"
+    assert unhashable(case) == "unhashable type: '" + kind + "'"
+assert (1, 2) in {(1, 2)}
+s.add("again")
+assert s == {"again"}
+
+# Deletes followed by inserts reuse tombstones
+s = set()
+for i in range(1000):
+    s.add(i)
+    s.remove(i)
+assert len(s) == 0
+for i in range(50):
+    s.add(i)
+assert len(s) == 50
+
+# Methods
+assert {1, 2}.union([3]) == {1, 2, 3}
+assert {1, 2}.intersection((2, 3)) == {2}
+assert {1, 2}.difference([2]) == {1}
+assert {1, 2}.union([3], (4,)) == {1, 2, 3, 4}
+assert {1, 2, 3}.intersection([1, 2], (2, 3)) == {2}
+assert {1, 2, 3, 4}.difference([1], {4}, (9,)) == {2, 3}
+u = {1, 2}
+assert u.union() == u and u.union() is not u
+u.update([3], (4,), {5})
+assert u == {1, 2, 3, 4, 5}
+u.update()
+assert u == {1, 2, 3, 4, 5}
+assert {1, 2}.isdisjoint([3, 4])
+assert not {1, 2}.isdisjoint([2])
+assert {1}.issubset([1, 2])
+assert {1, 2}.issuperset({2})
+c = a.copy()
+c.add(99)
+assert 99 not in a
+
+# Iteration
+total = 0
+for v in {10, 20, 30}:
+    total += v
+assert total == 60
+
+# Representation
+assert str(set()) == "set()"
+assert str({1}) == "{1}"
+assert str(frozenset()) == "frozenset()"
+assert str(frozenset([1])) == "frozenset({1})"
+
+# frozenset
+f = frozenset([1, 2, 3])
+assert type(f) is frozenset
+assert f == {1, 2, 3}
+assert {1, 2, 3} == f
+assert frozenset(f) is f
+assert type(f | {4}) is frozenset
+assert type({4} | f) is set
+assert f.union([4]) == {1, 2, 3, 4}
+assert f.union([4], [5]) == {1, 2, 3, 4, 5}
+assert type(f.intersection({1}, [1, 2])) is frozenset
+
+# frozensets are hashable, and equal sets hash equal regardless of order
+assert hash(frozenset([1, 2, 3])) == hash(frozenset([3, 2, 1]))
+assert hash(f) == hash(f)
+d = {frozenset([1, 2]): "pair"}
+assert d[frozenset([2, 1])] == "pair"
+nested = {frozenset([1]), frozenset([1]), frozenset([2])}
+assert len(nested) == 2
+
+print(f'missing: {missing}')
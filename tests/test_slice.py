@@ -160,4 +160,31 @@ assert string[100:200] == "", f"Expected '', but got '{string[100:200]}'"
 # Test slicing with negative indices
 assert lst[-5:-1] == [5, 6, 7, 8], f"Expected [5, 6, 7, 8], but got {lst[-5:-1]}"
 assert tpl[-5:-1] == (5, 6, 7, 8), f"Expected (5, 6, 7, 8), but got {tpl[-5:-1]}"
-assert string[-5:-1] == "fghi", f"Expected 'fghi', but got '{string[-5:-1]}'"
\ No newline at end of file
+assert string[-5:-1] == "fghi", f"Expected 'fghi', but got '{string[-5:-1]}'"
+# Test negative step with explicit bounds
+assert lst[8:2:-2] == [8, 6, 4], f"Expected [8, 6, 4], but got {lst[8:2:-2]}"
+assert tpl[-1:-4:-1] == (9, 8, 7), f"Expected (9, 8, 7), but got {tpl[-1:-4:-1]}"
+assert string[-1::-3] == "jgda", f"Expected 'jgda', but got '{string[-1::-3]}'"
+assert lst[2:8:-1] == [], f"Expected [], but got {lst[2:8:-1]}"
+assert slice(None, None, -1).indices(5) == (4, -1, -1), f"Expected (4, -1, -1), but got {slice(None, None, -1).indices(5)}"
+
+# Test full slices of immutable sequences are not copied
+assert tpl[:] is tpl, "Expected tpl[:] to be tpl"
+assert string[:] is string, "Expected string[:] to be string"
+assert lst[:] is not lst, "Expected lst[:] to be a copy"
+
+# Test slicing keeps unboxed lists intact
+floats = [0.5, 1.5, 2.5, 3.5]
+assert floats[1:3] == [1.5, 2.5], f"Expected [1.5, 2.5], but got {floats[1:3]}"
+assert floats[::-2] == [3.5, 1.5], f"Expected [3.5, 1.5], but got {floats[::-2]}"
+
+# Test slices of slices
+assert lst[1:9][2:5] == [3, 4, 5], f"Expected [3, 4, 5], but got {lst[1:9][2:5]}"
+assert string[2:][:3] == "cde", f"Expected 'cde', but got '{string[2:][:3]}'"
+
+# Test zero step
+try:
+    lst[::0]
+    assert False, "Expected ValueError"
+except ValueError:
+    pass
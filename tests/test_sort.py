@@ -0,0 +1,116 @@
+missing = 0
+
+# Test list.sort on homogeneous lists
+lst = [5, 3, 1, 4, 2]
+assert lst.sort() is None
+assert lst == [1, 2, 3, 4, 5]
+
+lst = [2.5, -1.0, 0.25]
+lst.sort()
+assert lst == [-1.0, 0.25, 2.5]
+
+lst = ["pear", "apple", "fig", "Apple"]
+lst.sort()
+assert lst == ["Apple", "apple", "fig", "pear"]
+
+lst = []
+lst.sort()
+assert lst == []
+
+# Test mixed lists fall back to generic comparisons
+lst = [3, 1.5, 2]
+lst.sort()
+assert lst == [1.5, 2, 3]
+
+lst = [(2, "b"), (1, "z"), (2, "a")]
+lst.sort()
+assert lst == [(1, "z"), (2, "a"), (2, "b")]
+
+# Test sorted() leaves its argument alone
+data = [3, 1, 2]
+assert sorted(data) == [1, 2, 3]
+assert data == [3, 1, 2]
+assert sorted((3, 1, 2)) == [1, 2, 3]
+assert sorted("cab") == ["a", "b", "c"]
+assert sorted({3, 1, 2}) == [1, 2, 3]
+assert sorted(range(5), reverse=True) == [4, 3, 2, 1, 0]
+assert sorted([], reverse=True) == []
+assert sorted([7], reverse=True) == [7]
+empty = []
+empty.sort(reverse=True)
+assert empty == []
+single = ["x"]
+single.sort(key=len, reverse=True)
+assert single == ["x"]
+
+# Test key= and reverse=, including stability
+words = ["bb", "a", "ccc", "dd", "e"]
+assert sorted(words, key=len) == ["a", "e", "bb", "dd", "ccc"]
+assert sorted(words, key=lambda w: len(w), reverse=True) == ["ccc", "bb", "dd", "a", "e"]
+words.sort(key=lambda w: -len(w))
+assert words == ["ccc", "bb", "dd", "a", "e"]
+
+offset = 10
+assert sorted([1, 2, 3], key=lambda x: offset - x) == [3, 2, 1]
+
+# Test errors from comparisons and key functions propagate
+try:
+    sorted([1, "a", 2])
+    assert False, "Expected a TypeError"
+except TypeError:
+    pass
+
+def bad(x):
+    raise ValueError("boom")
+
+try:
+    sorted([1, 2], key=bad)
+    assert False, "Expected a ValueError"
+except ValueError:
+    pass
+
+def careful(x):
+    try:
+        return 1 // x
+    except ZeroDivisionError:
+        return -1
+
+assert sorted([0, 1, 2], key=careful) == [0, 2, 1]
+
+# Test larger inputs with runs, duplicates and stability
+seed = 12345
+def rand():
+    global seed
+    seed = (seed * 1103515245 + 12345) % 2147483648
+    return seed
+
+for trial in range(10):
+    n = rand() % 1500
+    data = []
+    for i in range(n):
+        data.append(rand() % 40)
+    if trial % 2 == 0:
+        data = sorted(data[:n // 2]) + data[n // 2:]
+
+    pairs = []
+    for i in range(n):
+        pairs.append((data[i], i))
+
+    result = sorted(pairs, key=lambda p: p[0])
+    for i in range(n - 1):
+        assert result[i][0] <= result[i + 1][0]
+        if result[i][0] == result[i + 1][0]:
+            assert result[i][1] < result[i + 1][1]
+
+    result = sorted(pairs, key=lambda p: p[0], reverse=True)
+    for i in range(n - 1):
+        assert result[i][0] >= result[i + 1][0]
+        if result[i][0] == result[i + 1][0]:
+            assert result[i][1] < result[i + 1][1]
+
+big = list(range(10000))
+big.reverse()
+big.sort()
+assert big == list(range(10000))
+
+print(f'missing: {missing}')
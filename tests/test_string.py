@@ -47,92 +47,64 @@ missing += 1
 
 assert "hello".capitalize() == "Hello"
 
-missing += 1
-# assert "HELLO".casefold() == "hello"
+assert "HELLO".casefold() == "hello"
 
-missing += 1
-# assert "hello".swapcase() == "HELLO"
+assert "hello".swapcase() == "HELLO"
 
-missing += 1
-# assert "  hello  ".strip() == "hello"
+assert "  hello  ".strip() == "hello"
 
-missing += 1
-# assert "xxhelloxx".strip("x") == "hello"
+assert "xxhelloxx".strip("x") == "hello"
 
-missing += 1
-# assert "hello".startswith("he")
+assert "hello".startswith("he")
 
-missing += 1
-# assert "hello".endswith("lo")
+assert "hello".endswith("lo")
 
-missing += 1
-# assert "hello".find("l") == 2
+assert "hello".find("l") == 2
 
-missing += 1
-# assert "hello".rfind("l") == 3
+assert "hello".rfind("l") == 3
 
-missing += 1
-# assert "hello".index("l") == 2
+assert "hello".index("l") == 2
 
-missing += 1
-# assert "hello".rindex("l") == 3
+assert "hello".rindex("l") == 3
 
-missing += 1
-# assert "hello".count("l") == 2
+assert "hello".count("l") == 2
 
-missing += 1
-# assert "hello world".split() == ["hello", "world"]
+assert "hello world".split() == ["hello", "world"]
 
-missing += 1
-# assert "hello,world".split(",") == ["hello", "world"]
+assert "hello,world".split(",") == ["hello", "world"]
 
-missing += 1
-# assert "  ".join(["hello", "world"]) == "hello  world"
+assert "  ".join(["hello", "world"]) == "hello  world"
 
-missing += 1
-# assert "hello world".replace("world", "Python") == "hello Python"
+assert "hello world".replace("world", "Python") == "hello Python"
 
-missing += 1
-# assert "hello".zfill(8) == "000hello"
+assert "hello".zfill(8) == "000hello"
 
-missing += 1
-# assert "12345".isdecimal()
+assert "12345".isdecimal()
 
-missing += 1
-# assert "12345".isdigit()
+assert "12345".isdigit()
 
-missing += 1
-# assert "12345".isnumeric()
+assert "12345".isnumeric()
 
-missing += 1
-# assert "abc".isalpha()
+assert "abc".isalpha()
 
-missing += 1
-# assert "abc123".isalnum()
+assert "abc123".isalnum()
 
-missing += 1
-# assert "hello world".isspace() == False
+assert "hello world".isspace() == False
 
-missing += 1
-# assert "    ".isspace()
+assert "    ".isspace()
 
 missing += 1
 # assert "Hello".istitle()
 
-missing += 1
-# assert "HELLO".isupper()
+assert "HELLO".isupper()
 
-missing += 1
-# assert "hello".islower()
+assert "hello".islower()
 
-missing += 1
-# assert "hello".center(10) == "  hello   "
+assert "hello".center(10) == "  hello   "
 
-missing += 1
-# assert "hello".ljust(10) == "hello     "
+assert "hello".ljust(10) == "hello     "
 
-missing += 1
-# assert "hello".rjust(10) == "     hello"
+assert "hello".rjust(10) == "     hello"
 
 assert f"{2 + 2 * 2}" == "6"
 
@@ -149,8 +121,27 @@ assert r"hello\nworld" == "hello\\nworld"
 
 s = "hello"
 
+t = "hello"
+
+assert s is t
+
 # assert s.upper() == "HELLO"
 
 # assert s == "hello"
 
+a = "key"
+b = "ke" + "y"
+assert hash(a) == hash(b)
+assert {a: 1}[b] == 1
+
+long = "abcdefgh" * 20
+assert hash(long) == hash("abcdefgh" * 20)
+assert hash(long) != hash(long[:-1] + "i")
+
+keys = {}
+for i in range(500):
+    keys[str(i) * 5] = i
+assert keys["499" * 5] == 499
+assert len(keys) == 500
+
 print(f'missing: {missing}')
\ No newline at end of file
@@ -0,0 +1,129 @@
+s = ""
+for i in range(1000):
+    s += "ab"
+assert len(s) == 2000
+assert s[:4] == "abab"
+assert s[-1] == "b"
+
+def build(n):
+    r = "x"
+    for i in range(n):
+        r += str(i % 10)
+    return r
+
+r = build(25)
+assert r == "x0123456789012345678901234"
+assert len(r) == 26
+
+# Aliases keep their value.
+s = "abc"
+s += "d"
+t = s
+s += "e"
+assert t == "abcd"
+assert s == "abcde"
+
+def alias():
+    a = "x"
+    a += "y"
+    b = a
+    a += "z"
+    return b + "|" + a
+
+assert alias() == "xy|xyz"
+
+def capture():
+    a = "p"
+    a += "q"
+    def inner():
+        return a
+    saved = inner()
+    a += "r"
+    return saved + "|" + a
+
+assert capture() == "pq|pqr"
+
+# A nested `+=` on the variable while the right side runs must not append
+# to the string the outer `+=` already read.
+s = ""
+s += "a"
+
+def reenter():
+    global s
+    s += "y"
+    return "z"
+
+s += reenter()
+assert s == "az"
+
+def reenter_local():
+    a = "p"
+    a += "q"
+    def inner():
+        nonlocal a
+        a += "!"
+        return "r"
+    a += inner()
+    return a
+
+assert reenter_local() == "pqr"
+
+items = []
+s = "k"
+for i in range(5):
+    s += "-"
+    items.append(s)
+assert items == ["k-", "k--", "k---", "k----", "k-----"]
+
+s = "ab"
+s += "c"
+s += s
+assert s == "abcabc"
+
+# Hashes follow the contents.
+s = "ke"
+s += "y"
+d = {s: 1}
+s += "s"
+assert d["key"] == 1
+assert "keys" not in d
+d[s] = 2
+assert d["keys"] == 2
+assert hash(s) == hash("keys")
+
+n = 1
+n += 2
+assert n == 3
+l = [1]
+l += [2]
+assert l == [1, 2]
+
+assert ", ".join(["a", "b", "c"]) == "a, b, c"
+assert "".join(("x", "y")) == "xy"
+assert "-".join("abc") == "a-b-c"
+assert "-".join(range(0)) == ""
+assert "-".join([]) == ""
+assert "-".join(["only"]) == "only"
+assert "ab".join(["", ""]) == "ab"
+assert "".join({"q": 1}) == "q"
+
+try:
+    ", ".join(["a", 1])
+except TypeError as e:
+    assert str(e) == "sequence item 1: expected str instance, int found"
+else:
+    assert False
+
+try:
+    ", ".join([1, 2])
+except TypeError as e:
+    assert str(e) == "sequence item 0: expected str instance, int found"
+else:
+    assert False
+
+try:
+    ", ".join(5)
+except TypeError:
+    pass
+else:
+    assert False
@@ -0,0 +1,170 @@
+import gc
+
+
+def check_error(fn, kind, message):
+    try:
+        fn()
+    except kind as e:
+        assert str(e) == message
+    else:
+        assert False
+
+
+def test_format():
+    assert "{} {} {}".format(1, "a", 2.5) == "1 a 2.5"
+    assert "{0}{1}{0}".format("a", "b") == "aba"
+    assert "{name} is {age:>4}".format(name="bob", age=7) == "bob is    7"
+    assert "{a[0]} {b[k]}".format(a=[9], b={"k": "v"}) == "9 v"
+    assert "{:{}}|".format("x", 5) == "x    |"
+    assert "{{}} {{{}}}".format(1) == "{} {1}"
+    assert "{!r} {!s:>4} {!a}".format("q", 1, "x") == "'q'    1 'x'"
+    assert "{}".format(None) == "None"
+    assert "{:>5}|{}".format(True, True) == "    1|True"
+    assert "{:é^7}".format("ab") == "ééabééé"
+    assert "{:*^9}|{:<5}|{:.2}".format("hi", "é", "abc") == "***hi****|é    |ab"
+    assert "{0[k]}".format({"k": 3}) == "3"
+    assert "{0[1]}".format([4, 5]) == "5"
+
+
+def test_format_numbers():
+    assert "{:b} {:o} {:#x} {:X} {:c}".format(10, 8, 255, 255, 65) == "1010 10 0xff FF A"
+    assert "{:+d} {: d} {:08.3f}".format(5, 5, -3.14159) == "+5  5 -003.142"
+    assert "{:e} {:g} {:%}".format(12345.678, 0.00001234, 0.25) == "1.234568e+04 1.234e-05 25.000000%"
+    assert "{:,.2f} {:_} {:,}".format(1234567.891, 1000000, 1234567) == "1,234,567.89 1_000_000 1,234,567"
+    assert "{:010,}|{:08,}|{:#07_x}".format(1234, 1234, 255) == "00,001,234|0,001,234|0x0_00ff"
+    assert "{:<05}|{:=+6}|{:^6}".format(5, 3, 12) == "50000|+    3|  12  "
+    assert "{:.3}|{:.3}|{:010}".format(100.0, 1.0, 1e999) == "1e+02|1.0|0000000inf"
+    assert "{:.2%}|{:n}|{:G}".format(0.12345, 1234, 1e-10) == "12.35%|1234|1E-10"
+    assert "{:.0f}|{:#.0f}|{:-^20,.2f}".format(2.5, 2.0, -1234.5) == "2|2.|------1,234.50------"
+    assert "{}|{:}|{:f}".format(0.1, 2.5, 1) == "0.1|2.5|1.000000"
+
+
+def test_format_map():
+    assert "{a}-{b:03d}".format_map({"a": "x", "b": 7}) == "x-007"
+    check_error(missing_key, KeyError, "'c'")
+
+
+def missing_key():
+    "{c}".format_map({"a": 1})
+
+
+def test_format_cached():
+    template = "row {:>3}: {:6.2f}"
+    lines = []
+    for i in range(3):
+        lines.append(template.format(i, i * 1.5))
+    assert lines == ["row   0:   0.00", "row   1:   1.50", "row   2:   3.00"]
+    assert template % () == template
+    assert "{} {}".format("a", "b") == "a b"
+    assert "{} {}".format(1, 2) == "1 2"
+
+
+def distinct_templates(n):
+    for i in range(n):
+        key = "k" + str(i)
+        template = "%(" + key + ")s {" + key + "} {0." + key + "}"
+        assert template % {key: i} == str(i) + " {" + key + "} {0." + key + "}"
+
+
+def heap_bytes():
+    gc.collect()
+    return gc.get_stats()["heap_bytes"]
+
+
+# Names parsed out of runtime templates die with them.
+def test_template_names_collected():
+    distinct_templates(10)
+    before = heap_bytes()
+    distinct_templates(20000)
+    assert heap_bytes() - before < 200000
+
+
+def test_percent():
+    assert "%s=%d (%5.2f) %x %r %%" % ("k", 42, 2.5, 255, "q") == "k=42 ( 2.50) ff 'q' %"
+    assert "%(a)s-%(b)03d" % {"a": "A", "b": 7} == "A-007"
+    assert "%.3s|%5r|%-6d|%+.2e|%#o|%#X|%05.1f|% d" % ("abcdef", "x", 42, 12345.678, 8, 255, -2.25, 7) == "abc|  'x'|42    |+1.23e+04|0o10|0XFF|-02.2| 7"
+    assert "%*d|%-*.*f" % (5, 42, 8, 2, 3.14159) == "   42|3.14    "
+    assert "%s" % {"a": 1} == "{'a': 1}"
+    assert "hi" % {"a": 1} == "hi"
+    assert "%i %u" % (3.9, -2.1) == "3 -2"
+    assert "%.3d|%05s|%-05d" % (5, "a", 3) == "005|    a|3    "
+    assert "%c%c|%5.1s|" % (97, "b", "xyz") == "ab|    x|"
+    assert "%e %g %.0e" % (0.0, 1e20, 5.5) == "0.000000e+00 1e+20 6e+00"
+    assert "%s" % "solo" == "solo"
+    assert "%s" % (("t", 1),) == "('t', 1)"
+
+
+def test_fstring():
+    x = 5
+    s = "name"
+    assert f"{{x}} {x}" == "{x} 5"
+    assert f"plain {{}} only" == "plain {} only"
+    assert f"" == ""
+    assert f"{ {'k': x}['k'] }" == "5"
+    assert f"a\tb{x:>4}" == "a\tb   5"
+    assert f"{x:03d}|{x:}|{-x:+}|{x * 2:b}" == "005|5|-5|1010"
+    assert f"{'a' + 'b'!r} {x == 5} {x != 4} {x >= 5}" == "'ab' True True True"
+    assert f"{s:10}|{s!r:>8}" == "name      |  'name'"
+    assert f"{3.14159:.3f} {1234567:,} {255:#x}" == "3.142 1,234,567 0xff"
+    assert f"{[1, 2][1]}|{(1, 2)!s:>8}" == "2|  (1, 2)"
+    rows = []
+    for i in range(3):
+        rows.append(f"row {i:02d}: {i * 1.5:6.2f}")
+    assert rows == ["row 00:   0.00", "row 01:   1.50", "row 02:   3.00"]
+
+
+def format_error(template, args):
+    def run():
+        if len(args) == 0:
+            template.format()
+        elif len(args) == 1:
+            template.format(args[0])
+        else:
+            template.format(args[0], args[1])
+    return run
+
+
+def percent_error(template, args):
+    def run():
+        template % args
+    return run
+
+
+def test_errors():
+    check_error(format_error("{", ()), ValueError, "Single '{' encountered in format string")
+    check_error(format_error("}", ()), ValueError, "Single '}' encountered in format string")
+    check_error(format_error("{}{0}", (1, 2)), ValueError, "cannot switch from automatic field numbering to manual field specification")
+    check_error(format_error("{!x}", (1,)), ValueError, "Unknown conversion specifier x")
+    check_error(format_error("{} {}", (1,)), IndexError, "Replacement index 1 out of range for positional args tuple")
+    check_error(format_error("{a}", ()), KeyError, "'a'")
+    check_error(format_error("{:,x}", (1,)), ValueError, "Cannot specify ',' with 'x'.")
+    check_error(format_error("{:.}", (1.0,)), ValueError, "Format specifier missing precision")
+    check_error(format_error("{:+}", ("s",)), ValueError, "Sign not allowed in string format specifier")
+    check_error(format_error("{: }", ("hi",)), ValueError, "Space not allowed in string format specifier")
+    check_error(format_error("{:-}", ("hi",)), ValueError, "Sign not allowed in string format specifier")
+    check_error(format_error("{:=5}", ("s",)), ValueError, "'=' alignment not allowed in string format specifier")
+    check_error(format_error("{:#}", ("s",)), ValueError, "Alternate form (#) not allowed in string format specifier")
+    check_error(format_error("{:.2d}", (1,)), ValueError, "Precision not allowed in integer format specifier")
+    check_error(format_error("{:d}", ("s",)), ValueError, "Unknown format code 'd' for object of type 'str'")
+    check_error(format_error("{:s}", (1,)), ValueError, "Unknown format code 's' for object of type 'int'")
+    check_error(format_error("{0.}", (1,)), ValueError, "Empty attribute in format string")
+    check_error(format_error("{0[1]}", ([1],)), IndexError, "list index out of range")
+    check_error(percent_error("%d", "s"), TypeError, "%d format: a real number is required, not str")
+    check_error(percent_error("%x", 1.5), TypeError, "%x format: an integer is required, not float")
+    check_error(percent_error("%f", "s"), TypeError, "must be real number, not str")
+    check_error(percent_error("%c", "ab"), TypeError, "%c requires int or char")
+    check_error(percent_error("%z", 1), ValueError, "unsupported format character 'z' (0x7a) at index 1")
+    check_error(percent_error("%", 1), ValueError, "incomplete format")
+    check_error(percent_error("%d %d", (1,)), TypeError, "not enough arguments for format string")
+    check_error(percent_error("%d", (1, 2)), TypeError, "not all arguments converted during string formatting")
+    check_error(percent_error("%(a)s", 1), TypeError, "format requires a mapping")
+
+
+test_format()
+test_format_numbers()
+test_format_map()
+test_format_cached()
+test_template_names_collected()
+test_percent()
+test_fstring()
+test_errors()
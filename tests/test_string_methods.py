@@ -0,0 +1,121 @@
+assert "  hello  ".strip() == "hello"
+assert "  hello  ".lstrip() == "hello  "
+assert "  hello  ".rstrip() == "  hello"
+assert "\t\n a b \r\v\f".strip() == "a b"
+assert "   ".strip() == ""
+assert "".strip() == ""
+assert "x".strip() == "x"
+assert ("  " + "y" * 40 + "  ").strip() == "y" * 40
+assert (" " * 37 + "z").lstrip() == "z"
+assert ("z" + " " * 37).rstrip() == "z"
+assert "xxhixx".strip("x") == "hi"
+assert "abcba".strip("ab") == "c"
+assert "abc".strip("") == "abc"
+assert "abc".strip(None) == "abc"
+assert "€€x€".strip("€") == "x"
+assert "héllo".lstrip("hé") == "llo"
+assert "a€b€".rstrip("€b") == "a"
+
+line = "  1,2,,3 \n"
+assert line.strip().split(",") == ["1", "2", "", "3"]
+
+assert "ab\ncd\r\nef\rgh\vij\fkl".splitlines() == ["ab", "cd", "ef", "gh", "ij", "kl"]
+assert "ab\ncd\r\n".splitlines(True) == ["ab\n", "cd\r\n"]
+assert "ab\n\ncd".splitlines() == ["ab", "", "cd"]
+assert "".splitlines() == []
+assert "\n".splitlines() == [""]
+assert "no breaks".splitlines() == ["no breaks"]
+
+assert "123".isdigit() and "123".isdecimal() and "123".isnumeric()
+assert not "12a".isdigit()
+assert not "".isdigit()
+assert ("9" * 50).isdigit()
+assert not ("9" * 50 + "x").isdigit()
+assert " \t\n".isspace()
+assert not "".isspace()
+assert not " a ".isspace()
+assert "abc".isalpha() and not "ab1".isalpha()
+assert "ab1".isalnum() and not "ab_1".isalnum()
+assert "abc1".islower() and not "aBc".islower() and not "123".islower()
+assert "ABC1".isupper() and not "AbC".isupper() and not "".isupper()
+assert "abc".isascii() and "".isascii() and not "é".isascii()
+assert "_ident1".isidentifier() and not "1abc".isidentifier() and not "a b".isidentifier()
+assert "ab c".isprintable() and not "a\tb".isprintable()
+
+assert "Hello World".swapcase() == "hELLO wORLD"
+assert "MiXeD".casefold() == "mixed"
+assert "hELLO wORLD".capitalize() == "Hello world"
+assert ("ab" * 20).upper() == "AB" * 20
+assert ("AB" * 20 + "€").lower() == "ab" * 20 + "€"
+
+assert "hello".startswith("he")
+assert not "hello".startswith("lo")
+assert "hello".endswith("lo")
+assert "hello".startswith(("x", "h"))
+assert not "hello".endswith(("x", "y"))
+assert "hello".startswith("ll", 2)
+assert "hello".endswith("ll", 0, 4)
+assert "hello".startswith("", 5)
+assert not "hello".startswith("", 6)
+assert "héllo".startswith("llo", 2)
+assert "héllo".endswith("é", 0, 2)
+
+assert "a,b,c".partition(",") == ("a", ",", "b,c")
+assert "a,b,c".rpartition(",") == ("a,b", ",", "c")
+assert "abc".partition(",") == ("abc", "", "")
+assert "abc".rpartition(",") == ("", "", "abc")
+assert "k = v".partition(" = ") == ("k", " = ", "v")
+
+assert "ab".ljust(5) == "ab   "
+assert "ab".rjust(5, "*") == "***ab"
+assert "ab".center(5) == "  ab "
+assert "abc".center(6) == " abc  "
+assert "ab".center(6, "€") == "€€ab€€"
+assert "abc".ljust(2) == "abc"
+assert "é".rjust(3) == "  é"
+assert "42".zfill(5) == "00042"
+assert "-42".zfill(5) == "-0042"
+assert "+x".zfill(4) == "+00x"
+assert "abc".zfill(2) == "abc"
+
+try:
+    "a".strip(5)
+except TypeError as e:
+    assert str(e) == "strip arg must be None or str"
+else:
+    assert False
+
+try:
+    "a".startswith(5)
+except TypeError as e:
+    assert str(e) == "startswith first arg must be str or a tuple of str, not int"
+else:
+    assert False
+
+try:
+    "a".endswith(("b", 5))
+except TypeError as e:
+    assert str(e) == "tuple for endswith must only contain str, not int"
+else:
+    assert False
+
+try:
+    "a".partition("")
+except ValueError as e:
+    assert str(e) == "empty separator"
+else:
+    assert False
+
+try:
+    "a".center(5, "ab")
+except TypeError as e:
+    assert str(e) == "The fill character must be exactly one character long"
+else:
+    assert False
+
+try:
+    "a".zfill(1.5)
+except TypeError as e:
+    assert str(e) == "'float' object cannot be interpreted as an integer"
+else:
+    assert False
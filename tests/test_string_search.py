@@ -0,0 +1,75 @@
+s = "the quick brown fox jumps over the lazy dog"
+
+assert "fox" in s
+assert "cat" not in s
+assert "" in s
+assert "dog" in "dog"
+assert "dogs" not in "dog"
+
+assert s.find("the") == 0
+assert s.find("the", 1) == 31
+assert s.find("the", 1, 33) == -1
+assert s.find("") == 0
+assert s.find("", 100) == -1
+assert s.find("g", -1) == len(s) - 1
+assert s.rfind("the") == 31
+assert s.rfind("the", 0, 30) == 0
+assert s.rfind("") == len(s)
+assert s.index("quick") == 4
+assert s.rindex("o") == 41
+
+try:
+    s.index("cat")
+    assert False
+except ValueError:
+    pass
+
+try:
+    s.find(1)
+    assert False
+except TypeError:
+    pass
+
+# Long needles go through Two-Way; periodic ones exercise its memory.
+hay = "ab" * 200 + "abc" + "ab" * 200
+assert hay.find("ab" * 20 + "c") == 362
+assert hay.rfind("ab" * 20) == len(hay) - 40
+assert ("ab" * 20 + "ca") in hay
+assert ("ba" * 30 + "d") not in hay
+assert ("aaaaaaaaab" * 3) in ("a" * 50 + "aaaaaaaaab" * 3)
+assert ("a" * 50 + "b").find("a" * 20 + "b") == 30
+assert ("a" * 50 + "b").rfind("a" * 20) == 30
+
+assert s.count("o") == 4
+assert s.count("the") == 2
+assert "aaaa".count("aa") == 2
+assert "abc".count("") == 4
+assert "abc".count("", 4) == 0
+assert s.count("o", 15, 30) == 2
+
+assert "aaaa".replace("aa", "b") == "bb"
+assert "abc".replace("", "-") == "-a-b-c-"
+assert "abc".replace("", "-", 2) == "-a-bc"
+assert "é".replace("", "-") == "-é-"
+assert "aé日".replace("", "|", 3) == "|a|é|日"
+assert len("日本".replace("", "/")) == 5
+assert "a.b.c".replace(".", "::", 1) == "a::b.c"
+assert "abc".replace("x", "y") == "abc"
+assert s.replace("the ", "") == "quick brown fox jumps over lazy dog"
+
+assert "a,b,,c".split(",") == ["a", "b", "", "c"]
+assert "a,b,,c".split(",", 1) == ["a", "b,,c"]
+assert "a<>b<>c".split("<>") == ["a", "b", "c"]
+assert "".split(",") == [""]
+assert "  a  b\tc\n".split() == ["a", "b", "c"]
+assert "  a  b  c  ".split(None, 1) == ["a", "b  c  "]
+assert "".split() == []
+assert "a,b,c".rsplit(",", 1) == ["a,b", "c"]
+assert "  a  b  c  ".rsplit(None, 1) == ["  a  b", "c"]
+assert "a,b,c".rsplit(",") == ["a", "b", "c"]
+
+try:
+    "a".split("")
+    assert False
+except ValueError:
+    pass
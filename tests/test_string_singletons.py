@@ -0,0 +1,35 @@
+s = "hello world"
+assert s[0] is "hxyz"[0]
+assert s[-1] is "d"
+assert s[1:1] is ""
+assert s[5:2] is ""
+assert s[::-100] is "d"
+assert s[4:5] is "o"
+
+chars = []
+for c in "abca":
+    chars.append(c)
+assert chars[0] is chars[3]
+assert chars[0] is "a"
+
+assert "".join([]) is ""
+assert "-".join(["x"]) is "x"
+assert ("ab" * 0) is ""
+assert ("a" * 1) is "a"
+assert "q".upper() is "Q"
+assert "Q".lower() is "q"
+assert "q".capitalize() is "Q"
+assert "".upper() is ""
+assert str("") is ""
+assert str(7) is "7"
+assert repr(7) is "7"
+
+# Multi-byte characters are still separate objects but compare equal.
+assert "€x"[0] == "€"
+assert "é" + "" == "é"
+
+total = 0
+for c in "abc" * 1000:
+    if c is "b":
+        total += 1
+assert total == 1000
@@ -199,5 +199,14 @@ try:
 finally:
     final_cleanup = True
 assert final_cleanup
+
+# Test: exception caught inside a for loop keeps the loop going
+parsed = []
+for text in ["1", "x", "2", "y", "3"]:
+    try:
+        parsed.append(int(text))
+    except ValueError:
+        parsed.append(-1)
+assert parsed == [1, -1, 2, -1, 3]
  
 print(f'missing: {missing}')
\ No newline at end of file
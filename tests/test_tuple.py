@@ -253,4 +253,20 @@ try:
 except ValueError:
     pass  # Expected behavior
 
+# Test hashing
+assert hash((1, 2)) == hash((1, 2))
+assert hash((1, 2)) != hash((2, 1))
+assert hash(()) == hash(())
+assert hash((1, (2, "a"))) == hash((1, (2, "a")))
+grid = {}
+for x in range(10):
+    for y in range(10):
+        grid[(x, y)] = x * y
+assert len(grid) == 100
+assert grid[(3, 4)] == 12
+key = (9, 9)
+for i in range(5):
+    assert grid[key] == 81
+assert (1, 2) in {(1, 2), (3, 4)}
+
 print(f'missing: {missing}')
\ No newline at end of file
@@ -0,0 +1,78 @@
+s = "héllo wörld"
+assert len(s) == 11
+assert s[1] == "é"
+assert s[-4] == "ö"
+assert s[0] == "h"
+assert s[1:4] == "éll"
+assert s[::-1] == "dlröw olléh"
+assert s[::2] == "hlowrd"
+assert s[7:] == "örld"
+assert s[:-5] == "héllo "
+
+cjk = "中文字符"
+assert len(cjk) == 4
+assert cjk[2] == "字"
+assert cjk[-1] == "符"
+assert cjk[1:3] == "文字"
+
+emoji = "a😀b𝄞c"
+assert len(emoji) == 5
+assert emoji[1] == "😀"
+assert emoji[3] == "𝄞"
+assert emoji[::2] == "abc"
+
+chars = []
+for c in "añb中😀":
+    chars.append(c)
+assert chars == ["a", "ñ", "b", "中", "😀"]
+assert list("ñañ") == ["ñ", "a", "ñ"]
+
+assert "wörld".find("r") == 2
+assert s.find("ö") == 7
+assert s.rfind("l") == 9
+assert s.index("w") == 6
+assert s.rindex("é") == 1
+assert s.find("l", 4) == 9
+assert s.find("l", 2, 3) == 2
+assert s.find("", 11) == 11
+assert s.find("", 12) == -1
+assert s.count("l") == 3
+assert s.count("") == 12
+assert s.count("", 8) == 4
+assert "ö" in s
+assert "o" in s
+assert "ø" not in s
+
+try:
+    s[11]
+except IndexError:
+    pass
+else:
+    assert False
+
+# Long strings index through the sparse offset table.
+long = "ab€" * 1000
+assert len(long) == 3000
+assert long[2999] == "€"
+assert long[1500] == "a"
+assert long[1501] == "b"
+assert long[-1000:-997] == "€ab"
+assert long.find("€", 2000) == 2000
+assert long.rfind("a", 0, 1500) == 1497
+
+# Appending keeps counts right.
+t = "ß"
+for i in range(100):
+    t += "x"
+t += "ü"
+assert len(t) == 102
+assert t[-1] == "ü"
+assert t[0] == "ß"
+assert len("ascii" + "ünï") == 8
+
+assert "a,é,中".split(",") == ["a", "é", "中"]
+assert "-".join(["é", "ß"]) == "é-ß"
+assert "é" * 3 == "ééé"
+assert len("é" * 3) == 3
+assert "é" < "ö"
+assert "z" < "é"